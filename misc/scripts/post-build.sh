@@ -22,6 +22,23 @@ if [ -d data ]; then
     cp -R data/. ${OUT_ROMFS}/
 fi
 
+# Precompile translation bundles (strings_<lang>.d3tr); the TOML stays as a runtime fallback.
+# Needs a TOML reader: tomllib (Python 3.11+) or the tomli package.
+if ! command -v python3 > /dev/null 2>&1; then
+    echo "post-build: python3 not found; skipping translation bundles (TOML fallback will be used)"
+elif ! python3 -c "import tomllib" > /dev/null 2>&1 && ! python3 -c "import tomli" > /dev/null 2>&1; then
+    echo "post-build: python3 has neither tomllib (3.11+) nor tomli; skipping translation bundles (TOML fallback will be used)"
+else
+    python3 tools/build_translation_bundles.py --src data --dst ${OUT_ROMFS}
+fi
+
+# Crash-time symbol index: game offsets plus our own ELF symbols (romfs:/d3gui/symbols.d3sy).
+if command -v python3 > /dev/null 2>&1; then
+    python3 tools/build_symbol_index.py --elf "$NAME.elf" --out ${OUT_ROMFS}/symbols.d3sy
+else
+    echo "post-build: python3 not found; skipping symbol index (crash dumps keep raw offsets)"
+fi
+
 # Copy ELF to user path if defined.
 if [ ! -z $ELF_EXTRACT ]; then
     cp "$NAME.elf" "$ELF_EXTRACT"
@@ -29,7 +29,13 @@ namespace exl::hook::impl {
         static ALWAYS_INLINE decltype(auto) Orig(Args &&... args) {
             _HOOK_STATIC_CALLBACK_ASSERT();
 
-            return OrigRef()(std::forward<Args>(args)...);
+            /* Hooks that declare a TraceScope (see HOOK_TRACE) time the original. */
+            if constexpr (requires { typename Derived::TraceScope; }) {
+                const typename Derived::TraceScope scope(args...);
+                return OrigRef()(std::forward<Args>(args)...);
+            } else {
+                return OrigRef()(std::forward<Args>(args)...);
+            }
         }
 
         static ALWAYS_INLINE void InstallAtOffset(ptrdiff_t address) {
@@ -0,0 +1,413 @@
+#include "program/async_writer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+#include "lib/nx/result.h"
+#include "nn/fs.hpp"  // IWYU pragma: keep
+#include "nn/os.hpp"  // IWYU pragma: keep
+#include "program/d3/setting.hpp"
+
+namespace d3::async_writer {
+    namespace {
+        constexpr size_t kStackSize    = 0x4000;
+        constexpr s64    kPollMs       = 100;
+        constexpr size_t kRecordHeader = sizeof(u32);
+
+        // Producer-side state is guarded by g_mutex. `file`, `file_open` and
+        // `offset` belong to the writer thread; they are only reset under the
+        // lock when the slot is released.
+        struct Slot {
+            std::array<char, kMaxPathLength> path {};
+            bool                             in_use     = false;
+            bool                             transient  = false;  // Replace(): release once written
+            bool                             truncate   = false;  // recreate the file before the next write
+            bool                             busy       = false;  // writer thread is writing it outside the lock
+            u32                              head       = 0;  // free-running byte counters into `ring`
+            u32                              tail       = 0;
+            u64                              first_tick = 0;  // tick of the oldest unwritten record
+
+            nn::fs::FileHandle file {};
+            bool               file_open = false;
+            s64                offset    = 0;
+
+            std::array<u8, kFileBufferBytes> ring {};
+
+            auto Used() const -> size_t { return tail - head; }
+        };
+
+        nn::os::Mutex                    g_mutex {};
+        nn::os::EventType                g_wake {};
+        std::atomic<bool>                g_running {false};
+        std::atomic<bool>                g_flush_all {false};
+        bool                             g_started = false;
+        nn::os::ThreadType               g_thread {};
+        Stats                            g_stats {};
+        u32                              g_reported_drops = 0;
+        std::array<Slot, kMaxFiles>      g_slots {};
+        std::array<u8, kFileBufferBytes> g_staging {};  // writer thread only
+
+        alignas(0x1000) std::array<u8, kStackSize> g_stack {};
+
+        static auto NowTick() -> u64 {
+            return static_cast<u64>(nn::os::GetSystemTick().GetInt64Value());
+        }
+
+        static auto MsToTicks(s64 ms) -> u64 {
+            return static_cast<u64>(nn::os::GetSystemTickFrequency()) * static_cast<u64>(ms) / 1000;
+        }
+
+        static void RingWrite(Slot &slot, const void *src, size_t size) {
+            const size_t pos   = slot.tail % kFileBufferBytes;
+            const size_t first = std::min(size, kFileBufferBytes - pos);
+            std::memcpy(slot.ring.data() + pos, src, first);
+            std::memcpy(slot.ring.data(), static_cast<const u8 *>(src) + first, size - first);
+            slot.tail += static_cast<u32>(size);
+        }
+
+        static void RingRead(const Slot &slot, u32 at, void *dst, size_t size) {
+            const size_t pos   = at % kFileBufferBytes;
+            const size_t first = std::min(size, kFileBufferBytes - pos);
+            std::memcpy(dst, slot.ring.data() + pos, first);
+            std::memcpy(static_cast<u8 *>(dst) + first, slot.ring.data(), size - first);
+        }
+
+        static auto PeekRecordSize(const Slot &slot) -> u32 {
+            u32 size = 0;
+            RingRead(slot, slot.head, &size, sizeof(size));
+            return size;
+        }
+
+        static auto FindSlotLocked(const char *path, bool create) -> Slot * {
+            Slot *free_slot = nullptr;
+            for (auto &slot : g_slots) {
+                if (!slot.in_use) {
+                    if (free_slot == nullptr && !slot.file_open) {
+                        free_slot = &slot;
+                    }
+                    continue;
+                }
+                if (std::strncmp(slot.path.data(), path, slot.path.size()) == 0) {
+                    return &slot;
+                }
+            }
+            if (!create || free_slot == nullptr) {
+                return nullptr;
+            }
+            // Field-wise reset: the ring is large and only ever read through head/tail.
+            free_slot->path.fill('\0');
+            std::strncpy(free_slot->path.data(), path, free_slot->path.size() - 1);
+            free_slot->in_use     = true;
+            free_slot->transient  = false;
+            free_slot->truncate   = false;
+            free_slot->head       = 0;
+            free_slot->tail       = 0;
+            free_slot->first_tick = 0;
+            free_slot->offset     = 0;
+            return free_slot;
+        }
+
+        // Makes room for `need` bytes by dropping the oldest queued records.
+        static void DropOldestLocked(Slot &slot, size_t need) {
+            while (slot.Used() > 0 && kFileBufferBytes - slot.Used() < need) {
+                const u32 size = PeekRecordSize(slot);
+                slot.head += static_cast<u32>(kRecordHeader + size);
+                g_stats.dropped_bytes += size;
+                ++g_stats.dropped_records;
+            }
+        }
+
+        static auto PushLocked(Slot &slot, std::initializer_list<std::string_view> parts, size_t total) -> bool {
+            DropOldestLocked(slot, kRecordHeader + total);
+            if (slot.Used() == 0) {
+                slot.first_tick = NowTick();
+            }
+            const u32 size = static_cast<u32>(total);
+            RingWrite(slot, &size, sizeof(size));
+            for (const auto part : parts) {
+                RingWrite(slot, part.data(), part.size());
+            }
+            g_stats.bytes_queued += total;
+            return slot.Used() >= kFlushBytes || slot.transient;
+        }
+
+        static auto Queue(const char *path, std::initializer_list<std::string_view> parts, bool replace) -> bool {
+            if (path == nullptr || !g_running.load(std::memory_order_acquire)) {
+                return false;
+            }
+            size_t total = 0;
+            for (const auto part : parts) {
+                total += part.size();
+            }
+
+            bool wake = false;
+            {
+                std::scoped_lock lock(g_mutex);
+                if (total > kMaxRecordBytes || std::strlen(path) >= kMaxPathLength) {
+                    ++g_stats.rejected;
+                    return false;
+                }
+                Slot *slot = FindSlotLocked(path, true);
+                if (slot == nullptr) {
+                    ++g_stats.rejected;
+                    return false;
+                }
+                if (replace) {
+                    slot->head      = slot->tail;
+                    slot->truncate  = true;
+                    slot->transient = true;
+                }
+                wake = PushLocked(*slot, parts, total);
+            }
+            if (wake) {
+                nn::os::SignalEvent(&g_wake);
+            }
+            return true;
+        }
+
+        static void CreateParentDir(const char *path) {
+            const char *slash = std::strrchr(path, '/');
+            if (slash == nullptr) {
+                return;
+            }
+            std::array<char, kMaxPathLength> dir {};
+            const size_t                     len = std::min(static_cast<size_t>(slash - path), dir.size() - 1);
+            std::memcpy(dir.data(), path, len);
+            (void)nn::fs::CreateDirectory(dir.data());
+        }
+
+        static auto OpenForWrite(Slot &slot, const char *path, bool truncate) -> bool {
+            if (slot.file_open && !truncate) {
+                return true;
+            }
+            if (slot.file_open) {
+                nn::fs::CloseFile(slot.file);
+                slot.file_open = false;
+            }
+            if (truncate) {
+                (void)nn::fs::DeleteFile(path);
+            }
+            if (R_FAILED(nn::fs::CreateFile(path, 0))) {
+                CreateParentDir(path);
+                (void)nn::fs::CreateFile(path, 0);  // fails harmlessly when the file exists
+            }
+            if (R_FAILED(nn::fs::OpenFile(&slot.file, path, nn::fs::OpenMode_Write | nn::fs::OpenMode_Append))) {
+                return false;
+            }
+            long size = 0;
+            if (truncate || R_FAILED(nn::fs::GetFileSize(&size, slot.file))) {
+                size = 0;
+            }
+            slot.file_open = true;
+            slot.offset    = size;
+            return true;
+        }
+
+        // Moves whole records out of the ring into g_staging. Called with the
+        // lock held; returns the staged byte count.
+        static auto StageLocked(Slot &slot) -> size_t {
+            size_t staged = 0;
+            while (slot.Used() > 0) {
+                const u32 size = PeekRecordSize(slot);
+                if (staged + size > g_staging.size()) {
+                    break;
+                }
+                RingRead(slot, slot.head + static_cast<u32>(kRecordHeader), g_staging.data() + staged, size);
+                slot.head += static_cast<u32>(kRecordHeader + size);
+                staged += size;
+            }
+            slot.first_tick = NowTick();
+            return staged;
+        }
+
+        static auto IsDueLocked(const Slot &slot, u64 now, bool flush_all) -> bool {
+            if (slot.Used() == 0) {
+                return slot.transient && !slot.truncate;
+            }
+            return flush_all || slot.transient || slot.Used() >= kFlushBytes || now - slot.first_tick >= MsToTicks(kFlushIntervalMs);
+        }
+
+        static auto WriteStaged(Slot &slot, const char *path, bool truncate, size_t staged) -> bool {
+            bool ok = true;
+            if (staged != 0 || truncate) {
+                ok = OpenForWrite(slot, path, truncate);
+            }
+            if (ok && staged != 0) {
+                const auto opt = nn::fs::WriteOption::CreateOption(nn::fs::WriteOptionFlag_Flush);
+                ok             = R_SUCCEEDED(nn::fs::WriteFile(slot.file, slot.offset, g_staging.data(), staged, opt));
+                if (ok) {
+                    slot.offset += static_cast<s64>(staged);
+                }
+            }
+            return ok;
+        }
+
+        static void FinishLocked(Slot &slot, bool ok, size_t staged) {
+            if (ok) {
+                g_stats.bytes_written += staged;
+            } else {
+                ++g_stats.write_errors;
+                g_stats.dropped_bytes += staged;
+            }
+            // Dumps release their slot once fully written (unless replaced again
+            // while we were writing).
+            if (slot.transient && slot.Used() == 0 && !slot.truncate) {
+                if (slot.file_open) {
+                    nn::fs::CloseFile(slot.file);
+                }
+                slot.file_open = false;
+                slot.in_use    = false;
+            }
+        }
+
+        static void ServiceSlot(Slot &slot) {
+            std::array<char, kMaxPathLength> path {};
+            bool                             truncate = false;
+            size_t                           staged   = 0;
+            {
+                std::scoped_lock lock(g_mutex);
+                path          = slot.path;
+                truncate      = slot.truncate;
+                slot.truncate = false;
+                slot.busy     = true;
+                staged        = StageLocked(slot);
+            }
+
+            const bool ok = WriteStaged(slot, path.data(), truncate, staged);
+
+            std::scoped_lock lock(g_mutex);
+            slot.busy = false;
+            FinishLocked(slot, ok, staged);
+        }
+
+        static auto AnyBusyLocked() -> bool {
+            return std::any_of(g_slots.begin(), g_slots.end(), [](const Slot &slot) { return slot.busy; });
+        }
+
+        static void WriterMain(void *) {
+            for (;;) {
+                (void)nn::os::TimedWaitEvent(&g_wake, nn::TimeSpan::FromMilliSeconds(kPollMs));
+                const bool flush_all = g_flush_all.exchange(false, std::memory_order_acq_rel);
+                const u64  now       = NowTick();
+
+                for (auto &slot : g_slots) {
+                    bool due = false;
+                    {
+                        std::scoped_lock lock(g_mutex);
+                        due = slot.in_use && IsDueLocked(slot, now, flush_all);
+                    }
+                    if (due) {
+                        ServiceSlot(slot);
+                    }
+                }
+
+                u32 dropped = 0;
+                u64 bytes   = 0;
+                {
+                    std::scoped_lock lock(g_mutex);
+                    dropped = g_stats.dropped_records;
+                    bytes   = g_stats.dropped_bytes;
+                }
+                if (dropped != g_reported_drops) {
+                    g_reported_drops = dropped;
+                    PRINT("[async_writer] backlog full: %u records (%llu bytes) dropped so far", dropped, static_cast<unsigned long long>(bytes))
+                }
+            }
+        }
+    }  // namespace
+
+    void Start() {
+        if (g_started) {
+            return;
+        }
+        g_started = true;
+        nn::os::InitializeEvent(&g_wake, false, nn::os::EventClearMode_AutoClear);
+
+        const Result rc = nn::os::CreateThread(&g_thread, WriterMain, nullptr, g_stack.data(), g_stack.size(), nn::os::LowestThreadPriority);
+        if (R_FAILED(rc)) {
+            PRINT("[async_writer] writer thread not started (rc=0x%x); SD writes stay synchronous", rc)
+            return;
+        }
+        nn::os::SetThreadNamePointer(&g_thread, "d3hack.sd_writer");
+        nn::os::StartThread(&g_thread);
+        g_running.store(true, std::memory_order_release);
+    }
+
+    auto Running() -> bool {
+        return g_running.load(std::memory_order_acquire);
+    }
+
+    auto Append(const char *path, std::initializer_list<std::string_view> parts) -> bool {
+        return Queue(path, parts, false);
+    }
+
+    auto Append(const char *path, const void *data, size_t size) -> bool {
+        return Queue(path, {std::string_view(static_cast<const char *>(data), size)}, false);
+    }
+
+    auto Replace(const char *path, const void *data, size_t size) -> bool {
+        return Queue(path, {std::string_view(static_cast<const char *>(data), size)}, true);
+    }
+
+    void RequestFlush() {
+        if (!Running()) {
+            return;
+        }
+        g_flush_all.store(true, std::memory_order_release);
+        nn::os::SignalEvent(&g_wake);
+    }
+
+    auto DrainForCrash(s64 budget_ms) -> size_t {
+        if (!Running() || g_mutex.IsLockedByCurrentThread()) {
+            return 0;  // never started, or we faulted while queueing
+        }
+        // The writer thread only touches g_staging and file handles while a
+        // slot is busy; holding the lock with nothing busy keeps it out.
+        const u64 deadline = NowTick() + MsToTicks(budget_ms);
+        for (;;) {
+            if (g_mutex.try_lock()) {
+                if (!AnyBusyLocked()) {
+                    break;
+                }
+                g_mutex.unlock();
+            }
+            if (NowTick() >= deadline) {
+                return 0;
+            }
+            nn::os::SleepThread(nn::TimeSpan::FromMilliSeconds(1));
+        }
+
+        std::scoped_lock lock(std::adopt_lock, g_mutex);
+        // Later lines take the callers' synchronous paths.
+        g_running.store(false, std::memory_order_release);
+
+        size_t written = 0;
+        for (auto &slot : g_slots) {
+            while (slot.in_use && (slot.Used() > 0 || slot.truncate) && NowTick() < deadline) {
+                const bool   truncate = slot.truncate;
+                const size_t staged   = StageLocked(slot);
+                slot.truncate         = false;
+                const bool ok         = WriteStaged(slot, slot.path.data(), truncate, staged);
+                FinishLocked(slot, ok, staged);
+                if (!ok) {
+                    break;
+                }
+                written += staged;
+            }
+        }
+        return written;
+    }
+
+    auto GetStats() -> Stats {
+        std::scoped_lock lock(g_mutex);
+        Stats            out = g_stats;
+        for (const auto &slot : g_slots) {
+            out.open_files += slot.file_open ? 1u : 0u;
+        }
+        return out;
+    }
+
+}  // namespace d3::async_writer
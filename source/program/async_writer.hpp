@@ -0,0 +1,67 @@
+#pragma once
+
+#include <initializer_list>
+#include <string_view>
+
+#include "types.h"
+
+namespace d3::async_writer {
+
+    // Background SD writer. Callers copy bytes into a fixed per-file buffer and
+    // return immediately; a lowest-priority thread batches them to SD once a
+    // buffer passes kFlushBytes or has held data for kFlushIntervalMs.
+    //
+    // Memory is bounded: when a file's buffer is full the oldest queued records
+    // are dropped (and counted) to make room for the new one. Records larger
+    // than kMaxRecordBytes (just under 16 KiB) are rejected, so bigger dumps
+    // and caches always take the caller's synchronous fallback.
+    //
+    // A queued file may reach SD up to kFlushIntervalMs later. Files the mod
+    // reads back (pubfile caches) are written synchronously instead.
+    constexpr size_t kMaxFiles        = 8;
+    constexpr size_t kFileBufferBytes = 16 * 1024;
+    constexpr size_t kFlushBytes      = 4 * 1024;
+    constexpr s64    kFlushIntervalMs = 500;
+    constexpr size_t kMaxPathLength   = 160;
+    constexpr size_t kMaxRecordBytes  = kFileBufferBytes - sizeof(u32);
+
+    // Our PRINT lines land here (instead of the game's Debug.txt) while the
+    // writer is running.
+    constexpr const char *kGameLogPath = "sd:/config/d3hack-nx/d3hack.txt";
+
+    struct Stats {
+        u64 bytes_queued    = 0;
+        u64 bytes_written   = 0;
+        u64 dropped_bytes   = 0;
+        u32 dropped_records = 0;
+        u32 rejected        = 0;  // too large, no free file slot, or writer not running
+        u32 write_errors    = 0;
+        u32 open_files      = 0;
+    };
+
+    // Starts the writer thread. SD must be mounted. Safe to call more than once.
+    void Start();
+    auto Running() -> bool;
+
+    // Queues `parts` as one record appended to `path` (created if missing).
+    auto Append(const char *path, std::initializer_list<std::string_view> parts) -> bool;
+    auto Append(const char *path, const void *data, size_t size) -> bool;
+
+    // Queues a whole-file write: `path` is truncated and replaced by `data`.
+    // Anything still queued for `path` is superseded. The file slot is released
+    // once the data reached SD.
+    auto Replace(const char *path, const void *data, size_t size) -> bool;
+
+    // Wakes the writer so every buffer is written out on its next pass.
+    void RequestFlush();
+
+    // Crash path: writes every queued record from the calling thread, without
+    // the writer thread. Waits at most `budget_ms` for the lock and for an
+    // in-flight write, stops when the budget runs out, and leaves the writer
+    // stopped so later lines go through the callers' synchronous fallbacks.
+    // Returns the bytes written.
+    auto DrainForCrash(s64 budget_ms) -> size_t;
+
+    auto GetStats() -> Stats;
+
+}  // namespace d3::async_writer
@@ -0,0 +1,511 @@
+#include "program/binlog.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#include "lib/nx/result.h"
+#include "nn/fs.hpp"  // IWYU pragma: keep
+#include "nn/os.hpp"  // IWYU pragma: keep
+#include "program/fs_util.hpp"
+#include "types.h"
+
+namespace d3::binlog {
+    namespace {
+        constexpr char   kMagic[4] {'D', '3', 'B', 'L'};
+        constexpr u32    kVersion         = 1;
+        constexpr size_t kBufferBytes     = 16 * 1024;
+        constexpr size_t kMaxArgs         = 16;
+        constexpr size_t kMaxFormats      = 512;  // power of two
+        constexpr size_t kMaxStringBytes  = 1024;
+        constexpr size_t kMaxPayloadBytes = 2048;
+        constexpr u16    kNullString      = 0xFFFF;
+        constexpr s64    kFlushIntervalMs = 1000;
+        constexpr size_t kStackSize       = 0x2000;
+
+        enum RecordType : u8 {
+            RecordType_FormatDef = 1,
+            RecordType_Message   = 2,
+            RecordType_TickBase  = 3,
+        };
+
+        enum class ArgKind : u8 {
+            I32,
+            I64,
+            F64,
+            Str,
+            Ptr,
+        };
+
+        struct RecordHeader {
+            u8  type;
+            u8  arg_count;
+            u16 format_id;
+            u16 payload_bytes;
+            u16 reserved;
+            u32 tick_delta;
+        };
+        static_assert(sizeof(RecordHeader) == 12);
+
+        // Parsed once per distinct format pointer; `supported == false` formats
+        // always fall back to text.
+        struct FormatEntry {
+            const char                    *fmt            = nullptr;
+            u16                            id             = 0;
+            u8                             arg_count      = 0;
+            bool                           supported      = false;
+            bool                           defined        = false;  // definition record is on SD
+            u32                            def_generation = 0;      // buffer holding an unwritten definition
+            std::array<ArgKind, kMaxArgs> kinds {};
+        };
+
+        // PRINT callers fill the active buffer; a full (or, every
+        // kFlushIntervalMs, a non-empty) buffer is handed to the writer thread
+        // and the other one becomes active. While a handed-off buffer is still
+        // being written, a full active buffer makes WriteV fall back to text.
+        struct Buffer {
+            std::array<u8, kBufferBytes> data {};
+            size_t                       used       = 0;
+            u32                          generation = 0;
+        };
+
+        nn::os::Mutex                        g_mutex {};
+        std::atomic<bool>                    g_enabled {false};
+        bool                                 g_file_open = false;
+        nn::fs::FileHandle                   g_file {};
+        s64                                  g_file_offset  = 0;  // advanced once a buffer has landed
+        u64                                  g_last_tick    = 0;
+        u16                                  g_next_id      = 0;
+        size_t                               g_active       = 0;
+        u32                                  g_generation   = 1;
+        bool                                 g_in_flight    = false;  // g_buffers[g_active ^ 1] belongs to the writer
+        bool                                 g_thread_ready = false;
+        nn::os::EventType                    g_wake {};
+        nn::os::ThreadType                   g_thread {};
+        std::array<Buffer, 2>                g_buffers {};
+        std::array<FormatEntry, kMaxFormats> g_formats {};
+
+        alignas(0x1000) std::array<u8, kStackSize> g_stack {};
+
+        static auto NowTick() -> u64 {
+            return static_cast<u64>(nn::os::GetSystemTick().GetInt64Value());
+        }
+
+        static auto Active() -> Buffer & {
+            return g_buffers[g_active];
+        }
+
+        // Walks printf conversions and records how each consumes the va_list.
+        static auto ParseFormat(const char *fmt, FormatEntry &out) -> bool {
+            out.arg_count = 0;
+            auto push     = [&out](ArgKind kind) -> bool {
+                if (out.arg_count >= kMaxArgs) {
+                    return false;
+                }
+                out.kinds[out.arg_count++] = kind;
+                return true;
+            };
+
+            for (const char *p = fmt; *p != '\0'; ++p) {
+                if (*p != '%') {
+                    continue;
+                }
+                ++p;
+                if (*p == '%') {
+                    continue;
+                }
+                while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0' || *p == '\'') {
+                    ++p;
+                }
+                if (*p == '*') {
+                    if (!push(ArgKind::I32)) {
+                        return false;
+                    }
+                    ++p;
+                }
+                while (*p >= '0' && *p <= '9') {
+                    ++p;
+                }
+                if (*p == '.') {
+                    ++p;
+                    if (*p == '*') {
+                        if (!push(ArgKind::I32)) {
+                            return false;
+                        }
+                        ++p;
+                    }
+                    while (*p >= '0' && *p <= '9') {
+                        ++p;
+                    }
+                }
+
+                bool wide = false;
+                switch (*p) {
+                case 'h':
+                    p += (p[1] == 'h') ? 2 : 1;
+                    break;
+                case 'l':
+                    p += (p[1] == 'l') ? 2 : 1;
+                    wide = true;
+                    break;
+                case 'z':
+                case 'j':
+                case 't':
+                    ++p;
+                    wide = true;
+                    break;
+                case 'L':
+                    return false;  // long double
+                default:
+                    break;
+                }
+
+                bool ok = false;
+                switch (*p) {
+                case 'd':
+                case 'i':
+                case 'u':
+                case 'x':
+                case 'X':
+                case 'o':
+                case 'c':
+                    ok = push(wide ? ArgKind::I64 : ArgKind::I32);
+                    break;
+                case 'f':
+                case 'F':
+                case 'e':
+                case 'E':
+                case 'g':
+                case 'G':
+                case 'a':
+                case 'A':
+                    ok = push(ArgKind::F64);
+                    break;
+                case 's':
+                    ok = !wide && push(ArgKind::Str);
+                    break;
+                case 'p':
+                    ok = push(ArgKind::Ptr);
+                    break;
+                default:
+                    return false;  // %n, wide strings, truncated specifier
+                }
+                if (!ok) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static auto LookupFormat(const char *fmt) -> FormatEntry * {
+            const auto key  = reinterpret_cast<uintptr_t>(fmt);
+            size_t     slot = static_cast<size_t>((key >> 2) * 0x9E3779B97F4A7C15ull) & (kMaxFormats - 1);
+            for (size_t probe = 0; probe < kMaxFormats; ++probe) {
+                FormatEntry &entry = g_formats[(slot + probe) & (kMaxFormats - 1)];
+                if (entry.fmt == fmt) {
+                    return &entry;
+                }
+                if (entry.fmt == nullptr) {
+                    entry.fmt       = fmt;
+                    entry.id        = g_next_id++;
+                    entry.supported = ParseFormat(fmt, entry);
+                    entry.arg_count = entry.supported ? entry.arg_count : 0;
+                    return &entry;
+                }
+            }
+            return nullptr;  // table full: text fallback
+        }
+
+        // Hands the active buffer to the writer thread. Fails while the
+        // previous hand-off is still being written.
+        static auto SwapLocked() -> bool {
+            if (g_in_flight || !g_thread_ready) {
+                return false;
+            }
+            g_in_flight         = true;
+            g_active            = g_active ^ 1;
+            Active().used       = 0;
+            Active().generation = ++g_generation;
+            return true;
+        }
+
+        // True when an earlier definition record for `entry` is queued in a
+        // buffer that has not reached SD yet.
+        static auto DefinitionQueuedLocked(const FormatEntry &entry) -> bool {
+            return entry.def_generation == Active().generation || (g_in_flight && entry.def_generation == g_buffers[g_active ^ 1].generation);
+        }
+
+        static auto WriteOut(const Buffer &buffer, s64 offset) -> bool {
+            const auto opt = nn::fs::WriteOption::CreateOption(nn::fs::WriteOptionFlag_Flush);
+            return R_SUCCEEDED(nn::fs::WriteFile(g_file, offset, buffer.data.data(), buffer.used, opt));
+        }
+
+        // A buffer's definitions count as written only once the buffer is on
+        // SD; after a failed write they are emitted again on next use.
+        static void CompleteLocked(Buffer &buffer, bool ok) {
+            if (ok) {
+                g_file_offset += static_cast<s64>(buffer.used);
+                for (auto &entry : g_formats) {
+                    if (entry.fmt != nullptr && !entry.defined && entry.def_generation == buffer.generation) {
+                        entry.defined = true;
+                    }
+                }
+            }
+            buffer.used = 0;
+        }
+
+        static void WriterMain(void *) {
+            for (;;) {
+                // Woken for a full buffer, or on the timer to push out a partial one.
+                (void)nn::os::TimedWaitEvent(&g_wake, nn::TimeSpan::FromMilliSeconds(kFlushIntervalMs));
+
+                Buffer *buffer = nullptr;
+                s64     offset = 0;
+                {
+                    std::scoped_lock lock(g_mutex);
+                    if (!g_in_flight && (Active().used == 0 || !SwapLocked())) {
+                        continue;
+                    }
+                    buffer = &g_buffers[g_active ^ 1];
+                    offset = g_file_offset;
+                }
+
+                const bool ok = WriteOut(*buffer, offset);
+
+                std::scoped_lock lock(g_mutex);
+                CompleteLocked(*buffer, ok);
+                g_in_flight = false;
+            }
+        }
+
+        // Starts a record in the buffer with room for `max_payload` bytes and
+        // returns the payload pointer; EndRecord() patches in the final size.
+        // A tick-base record is inserted whenever the u32 delta would overflow.
+        static auto BeginRecord(RecordType type, u8 arg_count, u16 id, size_t max_payload, u64 tick) -> u8 * {
+            const size_t worst = sizeof(RecordHeader) * 2 + sizeof(u64) + max_payload;
+            if (worst > kBufferBytes) {
+                return nullptr;
+            }
+            if (Active().used + worst > kBufferBytes) {
+                if (!SwapLocked()) {
+                    return nullptr;
+                }
+                nn::os::SignalEvent(&g_wake);
+            }
+
+            Buffer &buffer = Active();
+            u64     delta  = tick - g_last_tick;
+            if (g_last_tick == 0 || delta > 0xFFFFFFFFull) {
+                const RecordHeader base {.type = RecordType_TickBase, .arg_count = 0, .format_id = 0, .payload_bytes = sizeof(u64), .reserved = 0, .tick_delta = 0};
+                std::memcpy(buffer.data.data() + buffer.used, &base, sizeof(base));
+                std::memcpy(buffer.data.data() + buffer.used + sizeof(base), &tick, sizeof(tick));
+                buffer.used += sizeof(base) + sizeof(tick);
+                delta = 0;
+            }
+            g_last_tick = tick;
+
+            const RecordHeader header {
+                .type          = type,
+                .arg_count     = arg_count,
+                .format_id     = id,
+                .payload_bytes = 0,
+                .reserved      = 0,
+                .tick_delta    = static_cast<u32>(delta),
+            };
+            std::memcpy(buffer.data.data() + buffer.used, &header, sizeof(header));
+            return buffer.data.data() + buffer.used + sizeof(header);
+        }
+
+        static void EndRecord(size_t payload_bytes) {
+            Buffer   &buffer = Active();
+            const u16 size   = static_cast<u16>(payload_bytes);
+            std::memcpy(buffer.data.data() + buffer.used + offsetof(RecordHeader, payload_bytes), &size, sizeof(size));
+            buffer.used += sizeof(RecordHeader) + payload_bytes;
+        }
+
+        static auto StartThreadLocked() -> bool {
+            if (g_thread_ready) {
+                return true;
+            }
+            nn::os::InitializeEvent(&g_wake, false, nn::os::EventClearMode_AutoClear);
+            if (R_FAILED(nn::os::CreateThread(&g_thread, WriterMain, nullptr, g_stack.data(), g_stack.size(), nn::os::LowestThreadPriority))) {
+                nn::os::FinalizeEvent(&g_wake);
+                return false;
+            }
+            nn::os::SetThreadNamePointer(&g_thread, "d3hack.binlog");
+            nn::os::StartThread(&g_thread);
+            g_thread_ready = true;
+            return true;
+        }
+
+        static auto OpenLocked() -> bool {
+            if (g_file_open) {
+                return true;
+            }
+            std::string error;
+            if (!d3::fs_util::EnsureConfigRootDirs(error)) {
+                return false;
+            }
+            (void)nn::fs::DeleteFile(kLogPath);
+            if (R_FAILED(nn::fs::CreateFile(kLogPath, 0))) {
+                return false;
+            }
+            if (R_FAILED(nn::fs::OpenFile(&g_file, kLogPath, nn::fs::OpenMode_Write | nn::fs::OpenMode_Append))) {
+                return false;
+            }
+            g_file_open   = true;
+            g_file_offset = 0;
+
+            std::array<u8, 16> header {};
+            const u64          freq = static_cast<u64>(nn::os::GetSystemTickFrequency());
+            std::memcpy(header.data(), kMagic, sizeof(kMagic));
+            std::memcpy(header.data() + 4, &kVersion, sizeof(kVersion));
+            std::memcpy(header.data() + 8, &freq, sizeof(freq));
+            std::memcpy(Active().data.data(), header.data(), header.size());
+            Active().used       = header.size();
+            Active().generation = g_generation;
+            return true;
+        }
+    }  // namespace
+
+    void SetEnabled(bool enabled) {
+        std::scoped_lock lock(g_mutex);
+        // Every SD write happens on the writer thread, so without it the
+        // stream stays off and PRINT keeps logging text.
+        if (enabled && (!OpenLocked() || !StartThreadLocked())) {
+            enabled = false;
+        }
+        if (!enabled && g_thread_ready) {
+            nn::os::SignalEvent(&g_wake);
+        }
+        g_enabled.store(enabled, std::memory_order_release);
+    }
+
+    auto Enabled() -> bool {
+        return g_enabled.load(std::memory_order_relaxed);
+    }
+
+    auto WriteV(const char *fmt, std::va_list vl) -> bool {
+        if (fmt == nullptr || !Enabled()) {
+            return false;
+        }
+
+        std::scoped_lock lock(g_mutex);
+        FormatEntry     *entry = LookupFormat(fmt);
+        if (entry == nullptr || !entry->supported) {
+            return false;
+        }
+
+        const u64 tick = NowTick();
+        if (!entry->defined && !DefinitionQueuedLocked(*entry)) {
+            // Definition: argument kinds then the format text, so the decoder never
+            // has to re-derive how the arguments were encoded.
+            const size_t text_len = std::min(strnlen(fmt, kMaxPayloadBytes - kMaxArgs), kMaxPayloadBytes - kMaxArgs);
+            u8          *dst      = BeginRecord(RecordType_FormatDef, entry->arg_count, entry->id, entry->arg_count + text_len, tick);
+            if (dst == nullptr) {
+                return false;
+            }
+            for (u8 i = 0; i < entry->arg_count; ++i) {
+                dst[i] = static_cast<u8>(entry->kinds[i]);
+            }
+            std::memcpy(dst + entry->arg_count, fmt, text_len);
+            EndRecord(entry->arg_count + text_len);
+            entry->def_generation = Active().generation;
+        }
+
+        u8 *dst = BeginRecord(RecordType_Message, entry->arg_count, entry->id, kMaxPayloadBytes, tick);
+        if (dst == nullptr) {
+            return false;
+        }
+        // Numeric arguments take at most 8 bytes each; strings get whatever is left.
+        constexpr size_t kNumericReserve = kMaxArgs * sizeof(u64);
+        size_t           used            = 0;
+        std::va_list     args;
+        va_copy(args, vl);
+        for (u8 i = 0; i < entry->arg_count; ++i) {
+            switch (entry->kinds[i]) {
+            case ArgKind::I32: {
+                const s32 v = va_arg(args, s32);
+                std::memcpy(dst + used, &v, sizeof(v));
+                used += sizeof(v);
+                break;
+            }
+            case ArgKind::I64: {
+                const s64 v = va_arg(args, s64);
+                std::memcpy(dst + used, &v, sizeof(v));
+                used += sizeof(v);
+                break;
+            }
+            case ArgKind::F64: {
+                const double v = va_arg(args, double);
+                std::memcpy(dst + used, &v, sizeof(v));
+                used += sizeof(v);
+                break;
+            }
+            case ArgKind::Ptr: {
+                const u64 v = reinterpret_cast<uintptr_t>(va_arg(args, void *));
+                std::memcpy(dst + used, &v, sizeof(v));
+                used += sizeof(v);
+                break;
+            }
+            case ArgKind::Str: {
+                const char  *s      = va_arg(args, const char *);
+                const size_t budget = std::min(kMaxStringBytes, kMaxPayloadBytes - kNumericReserve - std::min(used, kMaxPayloadBytes - kNumericReserve));
+                const u16    len    = (s == nullptr) ? kNullString : static_cast<u16>(strnlen(s, budget));
+                std::memcpy(dst + used, &len, sizeof(len));
+                used += sizeof(len);
+                if (s != nullptr) {
+                    std::memcpy(dst + used, s, len);
+                    used += len;
+                }
+                break;
+            }
+            }
+        }
+        va_end(args);
+        EndRecord(used);
+        return true;
+    }
+
+    void Flush() {
+        if (g_thread_ready) {
+            nn::os::SignalEvent(&g_wake);
+        }
+    }
+
+    auto DrainForCrash(s64 budget_ms) -> bool {
+        if (!g_file_open || g_mutex.IsLockedByCurrentThread()) {
+            return false;  // never opened, or we faulted inside WriteV
+        }
+        // Wait (bounded) for the lock and for any hand-off to finish, so this
+        // thread is the only one touching the file.
+        const u64 deadline = NowTick() + static_cast<u64>(nn::os::GetSystemTickFrequency()) * static_cast<u64>(budget_ms) / 1000;
+        for (;;) {
+            if (g_mutex.try_lock()) {
+                if (!g_in_flight) {
+                    break;
+                }
+                g_mutex.unlock();
+            }
+            if (NowTick() >= deadline) {
+                return false;
+            }
+            nn::os::SleepThread(nn::TimeSpan::FromMilliSeconds(1));
+        }
+
+        std::scoped_lock lock(std::adopt_lock, g_mutex);
+        Buffer          &buffer = Active();
+        if (buffer.used == 0) {
+            return true;
+        }
+        const bool ok = WriteOut(buffer, g_file_offset);
+        CompleteLocked(buffer, ok);
+        return ok;
+    }
+
+}  // namespace d3::binlog
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdarg>
+
+#include "types.h"
+
+namespace d3::binlog {
+
+    // Binary log stream: instead of formatting, PRINT call sites append a record
+    // holding a format id plus the raw argument bytes. Each format string is
+    // written once (as a definition record) the first time it is seen, so the
+    // file is self-describing; tools/binlog_decode.py turns it back into text.
+    //
+    // File layout (little-endian):
+    //   header  "D3BL" u32 version, u64 tick frequency
+    //   records 12-byte header: u8 type, u8 arg count, u16 format id,
+    //           u16 payload bytes, u16 reserved, u32 tick delta since the
+    //           previous record; then the payload
+    //     type 1 = format definition (payload: arg count x u8 argument kind
+    //              [0 i32, 1 i64, 2 f64, 3 string, 4 ptr], then format text)
+    //     type 2 = message           (payload: encoded arguments)
+    //     type 3 = tick base         (payload: u64 absolute tick)
+    //   arguments: i32 / i64 / f64 / ptr as raw 4/8 bytes; strings as u16 length
+    //   (0xFFFF = null) followed by the bytes.
+    constexpr const char *kLogPath = "sd:/config/d3hack-nx/d3hack_log.bin";
+
+    // Opens (truncates) the log file on first enable. SD must be mounted.
+    void SetEnabled(bool enabled);
+    auto Enabled() -> bool;
+
+    // Returns false when the stream is off or the format uses a conversion the
+    // encoder does not handle (%n, %Lf, more than 16 arguments...); the caller
+    // then falls back to text logging for that line.
+    auto WriteV(const char *fmt, std::va_list vl) -> bool;
+
+    // Asks the writer thread to push buffered records to SD now instead of at
+    // its next 1 s tick. Never blocks on SD.
+    void Flush();
+
+    // Crash path: writes the active buffer from the calling thread, waiting at
+    // most `budget_ms` for the lock and for an in-flight write. Returns false
+    // if the calling thread holds the log lock (faulted mid-PRINT) or the
+    // budget ran out.
+    auto DrainForCrash(s64 budget_ms) -> bool;
+
+}  // namespace d3::binlog
@@ -4,28 +4,96 @@
 #include "program/hook_registry.hpp"
 #include "program/d3/setting.hpp"
 #include "program/build_stamp.hpp"
+#include "program/frame_timing.hpp"
+#include "program/fs_util.hpp"
+#include "program/romfs_assets.hpp"
+#include "nn/os.hpp"  // IWYU pragma: keep
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <string>
 
 namespace d3::boot_report {
     namespace {
-        constexpr size_t     kMaxEntries   = 64;
-        constexpr const char kConfigPath[] = "sd:/config/d3hack-nx/config.toml";
+        constexpr size_t     kMaxEntries    = 64;
+        constexpr const char kConfigPath[]  = "sd:/config/d3hack-nx/config.toml";
+        constexpr const char kHistoryPath[] = "sd:/config/d3hack-nx/boot_history.bin";
+        constexpr char       kHistoryMagic[4] {'D', '3', 'B', 'H'};
+        constexpr u32        kHistoryVersion = 1;
 
-        const char *g_hooks[kMaxEntries]   = {};
-        const char *g_patches[kMaxEntries] = {};
-        size_t      g_hook_count           = 0;
-        size_t      g_patch_count          = 0;
-        bool        g_printed              = false;
+        struct HistoryHeader {
+            char magic[4];
+            u32  version;
+            u32  record_size;
+            u32  count;
+        };
+        static_assert(sizeof(HistoryHeader) == 16);
 
-        static void Record(const char *name, const char **arr, size_t &count) {
+        Timing g_hooks[kMaxEntries]   = {};
+        Timing g_patches[kMaxEntries] = {};
+        Timing g_stages[kMaxStages]   = {};
+        size_t g_hook_count           = 0;
+        size_t g_patch_count          = 0;
+        size_t g_stage_count          = 0;
+        u64    g_stage_start_tick     = 0;  // 0 = no stage running
+        bool   g_printed              = false;
+
+        HistoryRecord g_history[kHistoryDepth] = {};
+        size_t        g_history_count          = 0;
+        bool          g_history_saved          = false;
+
+        static void Record(const char *name, u64 start_tick, Timing *arr, size_t &count) {
             if (name == nullptr || name[0] == '\0') {
                 return;
             }
             if (count >= kMaxEntries) {
                 return;
             }
-            arr[count++] = name;
+            const u32 us = (start_tick != 0) ? frame_timing::TicksToUs(Tick() - start_tick) : 0;
+            arr[count++] = Timing {.name = name, .us = us};
+        }
+
+        static auto SumUs(const Timing *arr, size_t count) -> u32 {
+            u64 total = 0;
+            for (size_t i = 0; i < count; ++i) {
+                total += arr[i].us;
+            }
+            return static_cast<u32>(std::min<u64>(total, 0xFFFFFFFFull));
+        }
+
+        static auto BuildHash() -> u32 {
+            u32 hash = 2166136261u;
+            for (const char *p = d3::build_stamp::kBuildId; *p != '\0'; ++p) {
+                hash ^= static_cast<unsigned char>(*p);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        static void LoadHistory() {
+            g_history_count = 0;
+            std::string blob;
+            if (!d3::romfs::ReadFileToString(kHistoryPath, blob, sizeof(HistoryHeader) + sizeof(g_history))) {
+                return;
+            }
+            HistoryHeader header {};
+            if (blob.size() < sizeof(header)) {
+                return;
+            }
+            std::memcpy(&header, blob.data(), sizeof(header));
+            const bool header_ok =
+                std::memcmp(header.magic, kHistoryMagic, sizeof(header.magic)) == 0 &&
+                header.version == kHistoryVersion &&
+                header.record_size == sizeof(HistoryRecord) &&
+                header.count <= kHistoryDepth &&
+                blob.size() == sizeof(header) + header.count * sizeof(HistoryRecord);
+            if (!header_ok) {
+                PRINT("[boot] ignoring invalid %s", kHistoryPath)
+                return;
+            }
+            std::memcpy(g_history, blob.data() + sizeof(header), header.count * sizeof(HistoryRecord));
+            g_history_count = header.count;
         }
 
         static void PrintConfigSummary() {
@@ -57,21 +125,26 @@ namespace d3::boot_report {
             )
 
             PRINT(
-                "overlays: buildlocker=%u ddm_labels=%u fps_label=%u var_res_label=%u",
+                "overlays: buildlocker=%u ddm_labels=%u fps_label=%u var_res_label=%u frame_hud=%u",
                 static_cast<u32>(global_config.overlays.buildlocker_watermark),
                 static_cast<u32>(global_config.overlays.ddm_labels),
                 static_cast<u32>(global_config.overlays.fps_label),
-                static_cast<u32>(global_config.overlays.var_res_label)
+                static_cast<u32>(global_config.overlays.var_res_label),
+                static_cast<u32>(global_config.overlays.frame_timing_hud)
             )
             PRINT(
-                "debug: crashes=%u pubfile_dump=%u error_traces=%u debug_flags=%u exception_handler=%u oe_notify=%u oe_notify_log=%u",
+                "debug: crashes=%u pubfile_dump=%u error_traces=%u debug_flags=%u exception_handler=%u oe_notify=%u oe_notify_log=%u binary_log=%u async_writer=%u profiler=%u trace_hooks=%s",
                 static_cast<u32>(global_config.debug.enable_crashes),
                 static_cast<u32>(global_config.debug.enable_pubfile_dump),
                 static_cast<u32>(global_config.debug.enable_error_traces),
                 static_cast<u32>(global_config.debug.enable_debug_flags),
                 static_cast<u32>(global_config.debug.enable_exception_handler),
                 static_cast<u32>(global_config.debug.enable_oe_notification_hook),
-                static_cast<u32>(global_config.debug.log_oe_notification_messages)
+                static_cast<u32>(global_config.debug.log_oe_notification_messages),
+                static_cast<u32>(global_config.debug.binary_log),
+                static_cast<u32>(global_config.debug.async_writer),
+                static_cast<u32>(global_config.debug.sampling_profiler),
+                global_config.debug.trace_hooks.empty() ? "-" : global_config.debug.trace_hooks.c_str()
             )
             PRINT("seasons: active=%u season=%u allow_online=%u spoof_ptr=%u", static_cast<u32>(global_config.seasons.active), global_config.seasons.current_season, static_cast<u32>(global_config.seasons.allow_online), static_cast<u32>(global_config.seasons.spoof_ptr))
             PRINT("events: active=%u map_mode=%u", static_cast<u32>(global_config.events.active), static_cast<u32>(global_config.events.SeasonMapMode))
@@ -106,23 +179,85 @@ namespace d3::boot_report {
             }
         }
 
-        static void PrintList(const char *label, const char **arr, size_t count) {
-            PRINT("%s (%u):", label, static_cast<u32>(count))
+        static void PrintList(const char *label, const Timing *arr, size_t count) {
+            PRINT("%s (%u, %u us):", label, static_cast<u32>(count), SumUs(arr, count))
             for (size_t i = 0; i < count; ++i) {
-                const char *name = arr[i];
+                const char *name = arr[i].name;
                 if (name != nullptr && name[0] != '\0') {
-                    PRINT("  - %s", name)
+                    PRINT("  - %s (%u us)", name, arr[i].us)
                 }
             }
         }
     }  // namespace
 
-    void RecordHook(const char *name) {
-        Record(name, g_hooks, g_hook_count);
+    auto Tick() -> u64 {
+        return static_cast<u64>(nn::os::GetSystemTick().GetInt64Value());
+    }
+
+    void RecordHook(const char *name, u64 start_tick) {
+        Record(name, start_tick, g_hooks, g_hook_count);
+    }
+
+    void RecordPatch(const char *name, u64 start_tick) {
+        Record(name, start_tick, g_patches, g_patch_count);
     }
 
-    void RecordPatch(const char *name) {
-        Record(name, g_patches, g_patch_count);
+    void EndStage() {
+        if (g_stage_start_tick == 0 || g_stage_count == 0) {
+            return;
+        }
+        g_stages[g_stage_count - 1].us = frame_timing::TicksToUs(Tick() - g_stage_start_tick);
+        g_stage_start_tick             = 0;
+    }
+
+    void BeginStage(const char *name) {
+        EndStage();
+        if (g_stage_count >= kMaxStages) {
+            return;
+        }
+        g_stages[g_stage_count++] = Timing {.name = name, .us = 0};
+        g_stage_start_tick        = Tick();
+    }
+
+    void SaveHistory() {
+        if (g_history_saved) {
+            return;
+        }
+        g_history_saved = true;
+        EndStage();
+        LoadHistory();
+
+        HistoryRecord record {};
+        record.build_hash  = BuildHash();
+        record.stage_count = static_cast<u32>(g_stage_count);
+        record.hooks_us    = SumUs(g_hooks, g_hook_count);
+        record.patches_us  = SumUs(g_patches, g_patch_count);
+        for (size_t i = 0; i < g_stage_count; ++i) {
+            std::strncpy(record.stages[i].name, g_stages[i].name, kStageNameSize - 1);
+            record.stages[i].us = g_stages[i].us;
+        }
+
+        if (g_history_count == kHistoryDepth) {
+            std::memmove(&g_history[0], &g_history[1], (kHistoryDepth - 1) * sizeof(HistoryRecord));
+            --g_history_count;
+        }
+        g_history[g_history_count++] = record;
+
+        HistoryHeader header {};
+        std::memcpy(header.magic, kHistoryMagic, sizeof(header.magic));
+        header.version     = kHistoryVersion;
+        header.record_size = sizeof(HistoryRecord);
+        header.count       = static_cast<u32>(g_history_count);
+
+        std::string blob;
+        blob.reserve(sizeof(header) + g_history_count * sizeof(HistoryRecord));
+        blob.append(reinterpret_cast<const char *>(&header), sizeof(header));
+        blob.append(reinterpret_cast<const char *>(g_history), g_history_count * sizeof(HistoryRecord));
+
+        std::string error;
+        if (!d3::fs_util::WriteAllAtomic(kHistoryPath, blob, "boot history", error)) {
+            PRINT("[boot] history save failed: %s", error.c_str())
+        }
     }
 
     void PrintOnce() {
@@ -134,8 +269,25 @@ namespace d3::boot_report {
         PRINT_LINE("\n--- boot report ---");
         PrintConfigSummary();
         PrintHookPlan();
+        PrintList("boot stages", g_stages, g_stage_count);
         PrintList("hooks installed", g_hooks, g_hook_count);
         PrintList("patches applied", g_patches, g_patch_count);
     }
 
+    auto Stages() -> std::span<const Timing> {
+        return {g_stages, g_stage_count};
+    }
+
+    auto Hooks() -> std::span<const Timing> {
+        return {g_hooks, g_hook_count};
+    }
+
+    auto Patches() -> std::span<const Timing> {
+        return {g_patches, g_patch_count};
+    }
+
+    auto History() -> std::span<const HistoryRecord> {
+        return {g_history, g_history_count};
+    }
+
 }  // namespace d3::boot_report
@@ -1,11 +1,63 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include "types.h"
+
 namespace d3::boot_report {
 
-    void RecordHook(const char *name);
-    void RecordPatch(const char *name);
+    constexpr size_t kMaxStages     = 16;
+    constexpr size_t kHistoryDepth  = 16;  // boots kept in the SD history
+    constexpr size_t kStageNameSize = 20;
+
+    struct Timing {
+        const char *name = nullptr;
+        u32         us   = 0;
+    };
+
+    // One boot as persisted in sd:/config/d3hack-nx/boot_history.bin. Stage names
+    // are stored inline so older records stay readable after stages change.
+    struct HistoryStage {
+        char name[kStageNameSize];
+        u32  us;
+    };
+
+    struct HistoryRecord {
+        u32                                   build_hash;
+        u32                                   stage_count;
+        u32                                   hooks_us;
+        u32                                   patches_us;
+        std::array<HistoryStage, kMaxStages> stages;
+    };
+    static_assert(sizeof(HistoryRecord) == 16 + kMaxStages * sizeof(HistoryStage));
+
+    // System tick; pass it back to RecordHook/RecordPatch to time the work in between.
+    auto Tick() -> u64;
+
+    // `start_tick` == 0 records the name without a duration.
+    void RecordHook(const char *name, u64 start_tick = 0);
+    void RecordPatch(const char *name, u64 start_tick = 0);
+
+    // Closes the running stage (if any) and starts timing `name` (static string).
+    void BeginStage(const char *name);
+    // Closes the running stage without starting another, so time spent in the
+    // game between our stages is not attributed to us.
+    void EndStage();
+
+    // Appends this boot's timings to the SD history (last kHistoryDepth boots).
+    // Call once, after the last stage, with the SD mounted.
+    void SaveHistory();
 
     // Prints a one-time boot report (best-effort).
     void PrintOnce();
 
+    // Read-only views for the overlay; stable once the game loop has started.
+    auto Stages() -> std::span<const Timing>;
+    auto Hooks() -> std::span<const Timing>;
+    auto Patches() -> std::span<const Timing>;
+    // Oldest first; the current boot is the last record once SaveHistory() ran.
+    auto History() -> std::span<const HistoryRecord>;
+
 }  // namespace d3::boot_report
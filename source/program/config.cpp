@@ -6,6 +6,7 @@
 #include "program/system_allocator.hpp"
 #include "program/fs_util.hpp"
 #include "program/config_schema.hpp"
+#include "program/config_snapshot.hpp"
 
 #include <array>
 #include <ostream>
@@ -589,6 +590,7 @@ void LoadPatchConfig() {
             d3::g_rt_scale             = global_config.resolution_hack.HandheldScaleFraction();
             d3::g_rt_scale_initialized = true;
         }
+        d3::config_snapshot::Publish(global_config);
         return;
     }
     if (!error.empty())
@@ -600,6 +602,7 @@ void LoadPatchConfig() {
         d3::g_rt_scale             = global_config.resolution_hack.HandheldScaleFraction();
         d3::g_rt_scale_initialized = true;
     }
+    d3::config_snapshot::Publish(global_config);
 }
 
 auto NormalizePatchConfig(const PatchConfig &config) -> PatchConfig {
@@ -47,6 +47,14 @@ struct PatchConfig {
         bool  exp_scheduler         = true;
         float output_handheld_scale = 80.0f;  // percent (0 = auto/stock)
 
+        // Adaptive dynamic resolution: drive the variable-res percent (within
+        // min/max_res_scale) from measured present-to-present frame times.
+        static constexpr float kAdaptiveTargetMsMin        = 8.0f;
+        static constexpr float kAdaptiveTargetMsMax        = 50.0f;
+        bool                   adaptive_res                = false;
+        float                  adaptive_target_ms_docked   = 33.3f;
+        float                  adaptive_target_ms_handheld = 33.3f;
+
         struct ExtraConfig {
             static constexpr s32 kUnset          = -1;
             static constexpr s32 kMaxDimension   = 16384;
@@ -181,6 +189,7 @@ struct PatchConfig {
         bool ddm_labels            = true;
         bool fps_label             = false;
         bool var_res_label         = true;
+        bool frame_timing_hud      = false;
     } overlays;
 
     struct {
@@ -197,15 +206,19 @@ struct PatchConfig {
     } loot_modifiers;
 
     struct {
-        bool active                       = true;
-        bool enable_crashes               = false;
-        bool enable_pubfile_dump          = false;
-        bool enable_error_traces          = true;
-        bool enable_debug_flags           = false;
-        bool tagnx                        = false;
-        bool enable_exception_handler     = false;
-        bool enable_oe_notification_hook  = false;
-        bool log_oe_notification_messages = false;
+        bool        active                       = true;
+        bool        enable_crashes               = false;
+        bool        enable_pubfile_dump          = false;
+        bool        enable_error_traces          = true;
+        bool        enable_debug_flags           = false;
+        bool        tagnx                        = false;
+        bool        enable_exception_handler     = false;
+        bool        enable_oe_notification_hook  = false;
+        bool        log_oe_notification_messages = false;
+        bool        binary_log                   = false;  // PRINT -> sd:/config/d3hack-nx/d3hack_log.bin (tools/binlog_decode.py)
+        bool        async_writer                 = true;   // PRINT lines and dumps go to SD from a background thread
+        bool        sampling_profiler            = false;  // sample the game thread's stack (Tools > Dump profile, tools/profile_fold.py)
+        std::string trace_hooks {};                        // comma list of HOOK_TRACE sites or hook groups, "*" = all (tools/trace_to_chrome.py)
     } debug;
 
     struct {
@@ -98,6 +98,7 @@ namespace d3::config_schema {
         static constexpr std::array<std::string_view, 2> kKeysDdmLabels            = {"DDMLabels", "DebugLabels"};
         static constexpr std::array<std::string_view, 2> kKeysFpsLabel             = {"FPSLabel", "DrawFPSLabel"};
         static constexpr std::array<std::string_view, 3> kKeysVarResLabel          = {"VariableResLabel", "VarResLabel", "DrawVariableResolutionLabel"};
+        static constexpr std::array<std::string_view, 2> kKeysFrameTimingHud       = {"FrameTimingHUD", "FrameTimeHUD"};
         static constexpr std::array<std::string_view, 3> kKeysTagNx                = {"SpoofNetworkFunctions", "SpoofNetwork", "TagNX"};
         static constexpr std::array<std::string_view, 3> kKeysLanguage             = {"Language", "Lang", "Locale"};
         static constexpr std::array<std::string_view, 1> kKeysAcknowledgeJester    = {"Acknowledge_god_jester"};
@@ -107,6 +108,10 @@ namespace d3::config_schema {
         static constexpr std::array<std::string_view, 2> kKeysExceptionHandler     = {"EnableExceptionHandler", "ExceptionHandler"};
         static constexpr std::array<std::string_view, 2> kKeysOeNotificationHook   = {"EnableOeNotificationHook", "OeNotificationHook"};
         static constexpr std::array<std::string_view, 2> kKeysLogOeNotifications   = {"LogOeNotificationMessages", "LogNotificationMessages"};
+        static constexpr std::array<std::string_view, 2> kKeysBinaryLog            = {"BinaryLog", "BinaryLogging"};
+        static constexpr std::array<std::string_view, 2> kKeysAsyncWriter          = {"AsyncWriter", "AsyncSdWriter"};
+        static constexpr std::array<std::string_view, 2> kKeysSamplingProfiler     = {"SamplingProfiler", "Profiler"};
+        static constexpr std::array<std::string_view, 2> kKeysTraceHooks           = {"TraceHooks", "HookTrace"};
 
         static constexpr std::array<std::string_view, 3> kKeysGuiEnabled   = {"Enabled", "SectionEnabled", "Active"};
         static constexpr std::array<std::string_view, 3> kKeysGuiVisible   = {"Visible", "Show", "WindowVisible"};
@@ -146,6 +151,9 @@ namespace d3::config_schema {
             "HandheldScale",
             "HandheldOutputScale",
         };
+        static constexpr std::array<std::string_view, 2> kKeysReshackAdaptiveRes        = {"AdaptiveRes", "AdaptiveResolution"};
+        static constexpr std::array<std::string_view, 2> kKeysReshackAdaptiveDockedMs   = {"AdaptiveTargetMsDocked", "AdaptiveDockedMs"};
+        static constexpr std::array<std::string_view, 2> kKeysReshackAdaptiveHandheldMs = {"AdaptiveTargetMsHandheld", "AdaptiveHandheldMs"};
         static constexpr std::array<std::string_view, 4> kKeysReshackClampTextureResolution = {
             "ClampTextureResolution",
             "ClampTextureHeight",
@@ -164,6 +172,8 @@ namespace d3::config_schema {
         static void SetOverlaysFps(PatchConfig &cfg, bool v) { cfg.overlays.fps_label = v; }
         static auto GetOverlaysVarRes(const PatchConfig &cfg) -> bool { return cfg.overlays.var_res_label; }
         static void SetOverlaysVarRes(PatchConfig &cfg, bool v) { cfg.overlays.var_res_label = v; }
+        static auto GetOverlaysFrameHud(const PatchConfig &cfg) -> bool { return cfg.overlays.frame_timing_hud; }
+        static void SetOverlaysFrameHud(PatchConfig &cfg, bool v) { cfg.overlays.frame_timing_hud = v; }
 
         static auto GetGuiEnabled(const PatchConfig &cfg) -> bool { return cfg.gui.enabled; }
         static void SetGuiEnabled(PatchConfig &cfg, bool v) { cfg.gui.enabled = v; }
@@ -192,6 +202,14 @@ namespace d3::config_schema {
         static void SetDebugOeNotificationHook(PatchConfig &cfg, bool v) { cfg.debug.enable_oe_notification_hook = v; }
         static auto GetDebugLogOeNotifications(const PatchConfig &cfg) -> bool { return cfg.debug.log_oe_notification_messages; }
         static void SetDebugLogOeNotifications(PatchConfig &cfg, bool v) { cfg.debug.log_oe_notification_messages = v; }
+        static auto GetDebugBinaryLog(const PatchConfig &cfg) -> bool { return cfg.debug.binary_log; }
+        static void SetDebugBinaryLog(PatchConfig &cfg, bool v) { cfg.debug.binary_log = v; }
+        static auto GetDebugAsyncWriter(const PatchConfig &cfg) -> bool { return cfg.debug.async_writer; }
+        static void SetDebugAsyncWriter(PatchConfig &cfg, bool v) { cfg.debug.async_writer = v; }
+        static auto GetDebugSamplingProfiler(const PatchConfig &cfg) -> bool { return cfg.debug.sampling_profiler; }
+        static void SetDebugSamplingProfiler(PatchConfig &cfg, bool v) { cfg.debug.sampling_profiler = v; }
+        static auto GetDebugTraceHooks(const PatchConfig &cfg) -> const std::string * { return &cfg.debug.trace_hooks; }
+        static void SetDebugTraceHooks(PatchConfig &cfg, std::string_view v) { cfg.debug.trace_hooks = std::string(v); }
 
         static auto GetReshackActive(const PatchConfig &cfg) -> bool { return cfg.resolution_hack.active; }
         static void SetReshackActive(PatchConfig &cfg, bool v) { cfg.resolution_hack.active = v; }
@@ -225,6 +243,18 @@ namespace d3::config_schema {
                 cfg.resolution_hack.min_res_scale = cfg.resolution_hack.max_res_scale;
             }
         }
+        static auto GetReshackAdaptiveRes(const PatchConfig &cfg) -> bool { return cfg.resolution_hack.adaptive_res; }
+        static void SetReshackAdaptiveRes(PatchConfig &cfg, bool v) { cfg.resolution_hack.adaptive_res = v; }
+        static auto GetReshackAdaptiveDockedMs(const PatchConfig &cfg) -> float { return cfg.resolution_hack.adaptive_target_ms_docked; }
+        static void SetReshackAdaptiveDockedMs(PatchConfig &cfg, float v) {
+            using R                                       = PatchConfig::ResolutionHackConfig;
+            cfg.resolution_hack.adaptive_target_ms_docked = std::clamp(v, R::kAdaptiveTargetMsMin, R::kAdaptiveTargetMsMax);
+        }
+        static auto GetReshackAdaptiveHandheldMs(const PatchConfig &cfg) -> float { return cfg.resolution_hack.adaptive_target_ms_handheld; }
+        static void SetReshackAdaptiveHandheldMs(PatchConfig &cfg, float v) {
+            using R                                         = PatchConfig::ResolutionHackConfig;
+            cfg.resolution_hack.adaptive_target_ms_handheld = std::clamp(v, R::kAdaptiveTargetMsMin, R::kAdaptiveTargetMsMax);
+        }
         static auto GetReshackClampTextureResolution(const PatchConfig &cfg) -> u32 { return cfg.resolution_hack.clamp_texture_resolution; }
         static void SetReshackClampTextureResolution(PatchConfig &cfg, u32 v) {
             if (v == 0u) {
@@ -238,13 +268,14 @@ namespace d3::config_schema {
             );
         }
 
-        static constexpr std::array<Entry, 26> k_entries = {{
+        static constexpr std::array<Entry, 30> k_entries = {{
             // overlays
             {.section = "overlays", .key = "SectionEnabled", .keys = kKeysSectionEnabled, .kind = ValueKind::Bool, .restart = RestartPolicy::RuntimeSafe, .tr_label = "gui.overlays_enabled", .label_fallback = "Enabled##overlays", .get_bool = &GetOverlaysActive, .set_bool = &SetOverlaysActive},
             {.section = "overlays", .key = "BuildLockerWatermark", .keys = kKeysBuildLockerWatermark, .kind = ValueKind::Bool, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.overlays_buildlocker", .label_fallback = "Build locker watermark", .get_bool = &GetOverlaysBuildLocker, .set_bool = &SetOverlaysBuildLocker},
             {.section = "overlays", .key = "DDMLabels", .keys = kKeysDdmLabels, .kind = ValueKind::Bool, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.overlays_ddm", .label_fallback = "DDM labels", .get_bool = &GetOverlaysDdm, .set_bool = &SetOverlaysDdm},
             {.section = "overlays", .key = "FPSLabel", .keys = kKeysFpsLabel, .kind = ValueKind::Bool, .restart = RestartPolicy::RuntimeSafe, .tr_label = "gui.overlays_fps", .label_fallback = "FPS label", .get_bool = &GetOverlaysFps, .set_bool = &SetOverlaysFps},
             {.section = "overlays", .key = "VariableResLabel", .keys = kKeysVarResLabel, .kind = ValueKind::Bool, .restart = RestartPolicy::RuntimeSafe, .tr_label = "gui.overlays_var_res", .label_fallback = "Variable resolution label", .get_bool = &GetOverlaysVarRes, .set_bool = &SetOverlaysVarRes},
+            {.section = "overlays", .key = "FrameTimingHUD", .keys = kKeysFrameTimingHud, .kind = ValueKind::Bool, .restart = RestartPolicy::RuntimeSafe, .tr_label = "gui.overlays_frame_hud", .label_fallback = "Frame timing HUD", .get_bool = &GetOverlaysFrameHud, .set_bool = &SetOverlaysFrameHud},
 
             // gui
             {.section = "gui", .key = "Enabled", .keys = kKeysGuiEnabled, .kind = ValueKind::Bool, .restart = RestartPolicy::RuntimeSafe, .tr_label = "gui.enabled_persist", .label_fallback = "Enabled (persist)", .get_bool = &GetGuiEnabled, .set_bool = &SetGuiEnabled},
@@ -262,6 +293,10 @@ namespace d3::config_schema {
             {.section = "debug", .key = "EnableExceptionHandler", .keys = kKeysExceptionHandler, .kind = ValueKind::Bool, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.debug_exception_handler", .label_fallback = "Enable exception handler", .get_bool = &GetDebugExceptionHandler, .set_bool = &SetDebugExceptionHandler},
             {.section = "debug", .key = "EnableOeNotificationHook", .keys = kKeysOeNotificationHook, .kind = ValueKind::Bool, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.debug_oe_notifications", .label_fallback = "Hook OE notifications", .get_bool = &GetDebugOeNotificationHook, .set_bool = &SetDebugOeNotificationHook},
             {.section = "debug", .key = "LogOeNotificationMessages", .keys = kKeysLogOeNotifications, .kind = ValueKind::Bool, .restart = RestartPolicy::RuntimeSafe, .tr_label = "gui.debug_log_oe_notifications", .label_fallback = "Log OE notification messages", .get_bool = &GetDebugLogOeNotifications, .set_bool = &SetDebugLogOeNotifications},
+            {.section = "debug", .key = "BinaryLog", .keys = kKeysBinaryLog, .kind = ValueKind::Bool, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.debug_binary_log", .label_fallback = "Binary log (decode with tools/binlog_decode.py)", .get_bool = &GetDebugBinaryLog, .set_bool = &SetDebugBinaryLog},
+            {.section = "debug", .key = "AsyncWriter", .keys = kKeysAsyncWriter, .kind = ValueKind::Bool, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.debug_async_writer", .label_fallback = "Write logs and dumps from a background thread", .get_bool = &GetDebugAsyncWriter, .set_bool = &SetDebugAsyncWriter},
+            {.section = "debug", .key = "SamplingProfiler", .keys = kKeysSamplingProfiler, .kind = ValueKind::Bool, .restart = RestartPolicy::RuntimeSafe, .tr_label = "gui.debug_sampling_profiler", .label_fallback = "Sample the game thread (Tools > Dump profile)", .get_bool = &GetDebugSamplingProfiler, .set_bool = &SetDebugSamplingProfiler},
+            {.section = "debug", .key = "TraceHooks", .keys = kKeysTraceHooks, .kind = ValueKind::String, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.debug_trace_hooks", .label_fallback = "Trace hooks (names, groups or *)", .omit_if_empty = true, .get_string = &GetDebugTraceHooks, .set_string = &SetDebugTraceHooks},
 
             // resolution_hack (subset)
             {.section = "resolution_hack", .key = "SectionEnabled", .keys = kKeysSectionEnabled, .kind = ValueKind::Bool, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.resolution_enabled", .label_fallback = "Enabled##res", .get_bool = &GetReshackActive, .set_bool = &SetReshackActive},
@@ -269,6 +304,9 @@ namespace d3::config_schema {
             {.section = "resolution_hack", .key = "OutputHandheldScale", .keys = kKeysReshackOutputHandheldScale, .kind = ValueKind::Float, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.resolution_output_handheld_scale", .label_fallback = "Handheld output scale (%)", .min_f = 0.0f, .max_f = PatchConfig::ResolutionHackConfig::kHandheldScaleMax, .step_f = PatchConfig::ResolutionHackConfig::kHandheldScaleStep, .get_float = &GetReshackOutputHandheldScale, .set_float = &SetReshackOutputHandheldScale},
             {.section = "resolution_hack", .key = "MinResScale", .keys = kKeysReshackMinResScale, .kind = ValueKind::Float, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.resolution_min_scale", .label_fallback = "Minimum resolution scale", .min_f = 10.0f, .max_f = 100.0f, .step_f = 1.0f, .get_float = &GetReshackMinResScale, .set_float = &SetReshackMinResScale},
             {.section = "resolution_hack", .key = "MaxResScale", .keys = kKeysReshackMaxResScale, .kind = ValueKind::Float, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.resolution_max_scale", .label_fallback = "Maximum resolution scale", .min_f = 10.0f, .max_f = 100.0f, .step_f = 1.0f, .get_float = &GetReshackMaxResScale, .set_float = &SetReshackMaxResScale},
+            {.section = "resolution_hack", .key = "AdaptiveRes", .keys = kKeysReshackAdaptiveRes, .kind = ValueKind::Bool, .restart = RestartPolicy::RuntimeSafe, .tr_label = "gui.resolution_adaptive", .label_fallback = "Adaptive resolution", .get_bool = &GetReshackAdaptiveRes, .set_bool = &SetReshackAdaptiveRes},
+            {.section = "resolution_hack", .key = "AdaptiveTargetMsDocked", .keys = kKeysReshackAdaptiveDockedMs, .kind = ValueKind::Float, .restart = RestartPolicy::RuntimeSafe, .tr_label = "gui.resolution_adaptive_docked_ms", .label_fallback = "Adaptive target (docked, ms)", .min_f = PatchConfig::ResolutionHackConfig::kAdaptiveTargetMsMin, .max_f = PatchConfig::ResolutionHackConfig::kAdaptiveTargetMsMax, .step_f = 0.1f, .get_float = &GetReshackAdaptiveDockedMs, .set_float = &SetReshackAdaptiveDockedMs},
+            {.section = "resolution_hack", .key = "AdaptiveTargetMsHandheld", .keys = kKeysReshackAdaptiveHandheldMs, .kind = ValueKind::Float, .restart = RestartPolicy::RuntimeSafe, .tr_label = "gui.resolution_adaptive_handheld_ms", .label_fallback = "Adaptive target (handheld, ms)", .min_f = PatchConfig::ResolutionHackConfig::kAdaptiveTargetMsMin, .max_f = PatchConfig::ResolutionHackConfig::kAdaptiveTargetMsMax, .step_f = 0.1f, .get_float = &GetReshackAdaptiveHandheldMs, .set_float = &SetReshackAdaptiveHandheldMs},
             {.section = "resolution_hack", .key = "ClampTextureResolution", .keys = kKeysReshackClampTextureResolution, .kind = ValueKind::U32, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.resolution_clamp_texture", .label_fallback = "Clamp texture height (0=off, 100-9999)", .min_u = 0, .max_u = PatchConfig::ResolutionHackConfig::kClampTextureResolutionMax, .step_u = 1, .get_u32 = &GetReshackClampTextureResolution, .set_u32 = &SetReshackClampTextureResolution},
             {.section = "resolution_hack", .key = "SpoofDocked", .keys = kKeysReshackSpoofDocked, .kind = ValueKind::Bool, .restart = RestartPolicy::RestartRequired, .tr_label = "gui.resolution_spoof_docked", .label_fallback = "Spoof docked", .get_bool = &GetReshackSpoofDocked, .set_bool = &SetReshackSpoofDocked},
             {.section = "resolution_hack", .key = "ExperimentalScheduler", .keys = kKeysReshackExpScheduler, .kind = ValueKind::Bool, .restart = RestartPolicy::RuntimeSafe, .tr_label = "gui.resolution_exp_scheduler", .label_fallback = "Experimental scheduler", .get_bool = &GetReshackExpScheduler, .set_bool = &SetReshackExpScheduler},
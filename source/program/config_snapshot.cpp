@@ -0,0 +1,100 @@
+#include "program/config_snapshot.hpp"
+
+#include "nn/os.hpp"  // IWYU pragma: keep
+#include "program/log_once.hpp"
+#include "program/logging.hpp"
+
+#include <array>
+#include <mutex>
+
+namespace d3::config_snapshot {
+    namespace detail {
+        std::atomic<Slot *> g_current {nullptr};
+
+        // Classic hazard check: announce the pin, then confirm the slot is still
+        // current. A writer that swapped the pointer before our increment sees
+        // either our count or (here) its new pointer, never neither, so the slot
+        // we return cannot be refilled until we unpin it.
+        auto Pin() -> Slot * {
+            for (;;) {
+                Slot *slot = g_current.load(std::memory_order_acquire);
+                if (slot == nullptr) {
+                    return nullptr;
+                }
+                slot->readers.fetch_add(1, std::memory_order_seq_cst);
+                if (g_current.load(std::memory_order_seq_cst) == slot) {
+                    return slot;
+                }
+                slot->readers.fetch_sub(1, std::memory_order_release);
+            }
+        }
+    }  // namespace detail
+
+    namespace {
+        using detail::Slot;
+
+        std::array<Slot, kSlots> g_slots {};
+        nn::os::Mutex            g_writer_mutex {};
+        PatchConfig              g_pending {};  // writer-only copy of a deferred publish
+        bool                     g_has_pending = false;
+        u32                      g_publishes   = 0;
+        u32                      g_deferred    = 0;
+
+        static auto PickSlot() -> Slot * {
+            const Slot *current = detail::g_current.load(std::memory_order_relaxed);
+            for (auto &slot : g_slots) {
+                if (&slot != current && slot.readers.load(std::memory_order_seq_cst) == 0) {
+                    return &slot;
+                }
+            }
+            return nullptr;
+        }
+
+        static auto TryPublish(const PatchConfig &next) -> bool {
+            Slot *slot = PickSlot();
+            if (slot == nullptr) {
+                return false;
+            }
+            slot->config = next;
+            detail::g_current.store(slot, std::memory_order_seq_cst);
+            ++g_publishes;
+            return true;
+        }
+    }  // namespace
+
+    void Publish(const PatchConfig &next) {
+        std::scoped_lock lock(g_writer_mutex);
+        if (TryPublish(next)) {
+            g_has_pending = false;
+            return;
+        }
+        // Every spare slot is still pinned by a callback in flight. Keep the
+        // newest config and retry at the next present rather than block here.
+        g_pending     = next;
+        g_has_pending = true;
+        ++g_deferred;
+        if (const auto verdict = log_once::Check("config_snapshot.publish_deferred", log_once::kRateLimited)) {
+            PRINT("[config_snapshot] every spare slot is pinned; publish deferred (deferred=%u)", g_deferred)
+        }
+    }
+
+    void OnPresent() {
+        std::unique_lock lock(g_writer_mutex, std::try_to_lock);
+        if (!lock.owns_lock() || !g_has_pending) {
+            return;
+        }
+        if (TryPublish(g_pending)) {
+            g_has_pending = false;
+        }
+    }
+
+    auto GetStats() -> Stats {
+        std::scoped_lock lock(g_writer_mutex);
+        return Stats {
+            .publishes = g_publishes,
+            .deferred  = g_deferred,
+            .pending   = g_has_pending,
+        };
+    }
+
+}  // namespace d3::config_snapshot
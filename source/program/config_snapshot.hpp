@@ -0,0 +1,71 @@
+#pragma once
+
+#include "program/config.hpp"
+#include "types.h"
+
+#include <atomic>
+
+namespace d3::config_snapshot {
+
+    // Immutable, atomically published copies of PatchConfig for hooks that run on
+    // game threads. Writers (boot + runtime apply) fill a spare slot and swap the
+    // pointer. Readers pin the slot they see for as long as they hold the
+    // Reader, and a writer never refills a slot that is current or still pinned,
+    // so a snapshot cannot change under a callback no matter how long it runs.
+    // When every spare slot is pinned the publish is deferred to the next present.
+    //
+    // global_config remains the GUI-thread working copy.
+    constexpr u32 kSlots = 4;
+
+    namespace detail {
+        struct Slot {
+            PatchConfig      config {};
+            std::atomic<u32> readers {0};
+        };
+
+        extern std::atomic<Slot *> g_current;
+
+        auto Pin() -> Slot *;
+    }  // namespace detail
+
+    // Pins one snapshot. Bind it once per callback and read through it; do not
+    // store it past the callback (a pinned slot cannot be recycled).
+    class Reader {
+       public:
+        Reader() : slot_(detail::Pin()) {}
+        ~Reader() {
+            if (slot_ != nullptr) {
+                slot_->readers.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        Reader(const Reader &)            = delete;
+        Reader &operator=(const Reader &) = delete;
+
+        // Falls back to global_config until the first Publish (boot, before hooks run).
+        auto operator*() const -> const PatchConfig & { return slot_ != nullptr ? slot_->config : global_config; }
+        auto operator->() const -> const PatchConfig * { return &**this; }
+
+       private:
+        detail::Slot *slot_;
+    };
+
+    // `const auto &cfg = config_snapshot::Current();` keeps the pin for the scope.
+    inline auto Current() -> Reader {
+        return Reader {};
+    }
+
+    // Copies `next` into a free slot and makes it current. Writer side only.
+    void Publish(const PatchConfig &next);
+
+    // Frame boundary (present thread); retries a deferred publish.
+    void OnPresent();
+
+    struct Stats {
+        u32  publishes = 0;
+        u32  deferred  = 0;  // publishes that found every spare slot pinned
+        bool pending   = false;
+    };
+    auto GetStats() -> Stats;
+
+}  // namespace d3::config_snapshot
@@ -0,0 +1,345 @@
+#include "program/crash_capture.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#include "lib/nx/result.h"
+#include "lib/util/sys/modules.hpp"
+#include "nn/fs.hpp"  // IWYU pragma: keep
+#include "nn/os.hpp"  // IWYU pragma: keep
+#include "program/boot_report.hpp"
+#include "program/build_stamp.hpp"
+#include "program/hook_registry.hpp"
+#include "types.h"
+
+namespace d3::crash_capture {
+    namespace {
+        constexpr char   kMagic[4] {'D', '3', 'C', 'R'};
+        constexpr u32    kVersion          = 1;
+        constexpr size_t kBufferBytes      = 64 * 1024;
+        constexpr size_t kStackWindowBytes = 16 * 1024;
+        constexpr size_t kCodeWindowBytes  = 256;  // each side of pc/lr
+        constexpr size_t kFarWindowBytes   = 64;
+        constexpr size_t kHooksMaxBytes    = 8 * 1024;
+        constexpr size_t kModuleNameBytes  = 64;
+
+        enum SectionType : u32 {
+            SectionType_Registers = 1,
+            SectionType_Memory    = 2,
+            SectionType_Modules   = 3,
+            SectionType_Hooks     = 4,
+            SectionType_LogTail   = 5,
+            SectionType_Build     = 6,
+        };
+
+        enum MemoryKind : u32 {
+            MemoryKind_Stack  = 0,
+            MemoryKind_CodePc = 1,
+            MemoryKind_CodeLr = 2,
+            MemoryKind_Far    = 3,
+        };
+
+        struct FileHeader {
+            char magic[4];
+            u32  version;
+            u32  section_count;
+            u32  total_bytes;
+            u64  tick;
+            u64  tick_frequency;
+            u32  exception_type;
+            s32  core;
+        };
+        static_assert(sizeof(FileHeader) == 40);
+
+        struct SectionHeader {
+            u32 type;
+            u32 payload_bytes;
+        };
+
+        struct MemoryHeader {
+            u64 address;
+            u32 kind;
+            u32 reserved;
+        };
+
+        enum ModuleFlag : u32 {
+            ModuleFlag_Main = 1u << 0,
+            ModuleFlag_Self = 1u << 1,
+        };
+
+        struct ModuleRecord {
+            u32  index;
+            u32  flags;
+            u64  start;
+            u64  end;
+            u64  text_start;
+            u64  text_end;
+            char name[kModuleNameBytes];
+        };
+        static_assert(sizeof(ModuleRecord) == 104);
+        // tools/crash_analyze.py decodes the register section at fixed offsets.
+        static_assert(sizeof(nn::os::UserExceptionInfoDetail) == 816);
+
+        alignas(16) std::array<u8, kBufferBytes> g_buffer {};
+        std::atomic_flag                         g_capturing = ATOMIC_FLAG_INIT;
+
+        std::array<char, kLogTailBytes> g_log_tail {};
+        std::atomic<u64>                g_log_cursor {0};
+
+        // Sections are appended in place; writes past the end are truncated so a
+        // large stack window can never push out the sections after it.
+        struct Builder {
+            size_t offset         = sizeof(FileHeader);
+            size_t section_offset = 0;
+            u32    section_count  = 0;
+
+            [[nodiscard]] auto Remaining() const -> size_t { return g_buffer.size() - offset; }
+
+            auto Begin(u32 type) -> bool {
+                if (Remaining() < sizeof(SectionHeader)) {
+                    return false;
+                }
+                section_offset = offset;
+                const SectionHeader header {type, 0};
+                std::memcpy(g_buffer.data() + offset, &header, sizeof(header));
+                offset += sizeof(header);
+                return true;
+            }
+
+            auto Put(const void *data, size_t size) -> size_t {
+                size = std::min(size, Remaining());
+                if (size != 0) {
+                    std::memcpy(g_buffer.data() + offset, data, size);
+                    offset += size;
+                }
+                return size;
+            }
+
+            void End() {
+                const u32 payload = static_cast<u32>(offset - section_offset - sizeof(SectionHeader));
+                std::memcpy(g_buffer.data() + section_offset + offsetof(SectionHeader, payload_bytes), &payload, sizeof(payload));
+                const size_t padded = std::min((offset + 7) & ~static_cast<size_t>(7), g_buffer.size());
+                std::memset(g_buffer.data() + offset, 0, padded - offset);
+                offset = padded;
+                ++section_count;
+            }
+        };
+
+        // Bytes readable from `address` within its mapping, capped at `want`.
+        static auto ReadableBytes(uintptr_t address, size_t want) -> size_t {
+            if (address == 0 || want == 0) {
+                return 0;
+            }
+            MemoryInfo info {};
+            u32        page_info = 0;
+            if (R_FAILED(svcQueryMemory(&info, &page_info, address)) || (info.perm & Perm_R) == 0 || info.type == 0) {
+                return 0;
+            }
+            const uintptr_t end = info.addr + info.size;
+            return end > address ? std::min(want, static_cast<size_t>(end - address)) : 0;
+        }
+
+        static void PutMemory(Builder &builder, MemoryKind kind, uintptr_t address, size_t want) {
+            const size_t size = ReadableBytes(address, want);
+            if (size == 0 || builder.Remaining() < sizeof(SectionHeader) + sizeof(MemoryHeader) + 16 || !builder.Begin(SectionType_Memory)) {
+                return;
+            }
+            const MemoryHeader header {address, kind, 0};
+            builder.Put(&header, sizeof(header));
+            builder.Put(reinterpret_cast<const void *>(address), size);
+            builder.End();
+        }
+
+        // Window centred on `address`, falling back to starting at it when the
+        // bytes before it are not mapped.
+        static void PutCode(Builder &builder, MemoryKind kind, uintptr_t address) {
+            if (address < kCodeWindowBytes) {
+                return;
+            }
+            const uintptr_t before = address - kCodeWindowBytes;
+            if (ReadableBytes(before, kCodeWindowBytes) == kCodeWindowBytes) {
+                PutMemory(builder, kind, before, kCodeWindowBytes * 2);
+            } else {
+                PutMemory(builder, kind, address, kCodeWindowBytes);
+            }
+        }
+
+        static void PutModules(Builder &builder) {
+            if (!builder.Begin(SectionType_Modules)) {
+                return;
+            }
+            u32 count = 0;
+            for (int i = static_cast<int>(exl::util::ModuleIndex::Start); i < static_cast<int>(exl::util::ModuleIndex::End); ++i) {
+                count += exl::util::HasModule(static_cast<exl::util::ModuleIndex>(i)) ? 1u : 0u;
+            }
+            const u32 counts[2] {count, 0};
+            builder.Put(counts, sizeof(counts));
+            for (int i = static_cast<int>(exl::util::ModuleIndex::Start); i < static_cast<int>(exl::util::ModuleIndex::End); ++i) {
+                const auto index = static_cast<exl::util::ModuleIndex>(i);
+                if (!exl::util::HasModule(index)) {
+                    continue;
+                }
+                const auto  &module = exl::util::GetModuleInfo(index);
+                const auto   name   = module.GetModuleName();
+                ModuleRecord record {};
+                record.index      = static_cast<u32>(i);
+                record.flags      = (&module == &exl::util::GetMainModuleInfo() ? ModuleFlag_Main : 0u) |
+                                    (&module == &exl::util::GetSelfModuleInfo() ? ModuleFlag_Self : 0u);
+                record.start      = module.m_Total.m_Start;
+                record.end        = module.m_Total.GetEnd();
+                record.text_start = module.m_Text.m_Start;
+                record.text_end   = module.m_Text.GetEnd();
+                std::memcpy(record.name, name.data(), std::min(name.size(), sizeof(record.name) - 1));
+                if (builder.Put(&record, sizeof(record)) != sizeof(record)) {
+                    break;
+                }
+            }
+            builder.End();
+        }
+
+        static auto FindRegistryEntry(const char *name) -> const hook_registry::HookEntry * {
+            for (const auto &entry : hook_registry::Entries()) {
+                if (entry.name != nullptr && std::strcmp(entry.name, name) == 0) {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+
+        static void PutHooks(Builder &builder) {
+            if (!builder.Begin(SectionType_Hooks)) {
+                return;
+            }
+            const size_t limit = builder.offset + std::min(kHooksMaxBytes, builder.Remaining());
+            auto         put   = [&](const char *kind, const boot_report::Timing &timing) {
+                if (timing.name == nullptr) {
+                    return;
+                }
+                const auto *entry = FindRegistryEntry(timing.name);
+                char        line[256];
+                const int   n = std::snprintf(
+                    line,
+                    sizeof(line),
+                    "%s\t%s\t%s\t%s\n",
+                    kind,
+                    timing.name,
+                    (entry != nullptr && entry->owner != nullptr) ? entry->owner : "-",
+                    (entry != nullptr && entry->feature != nullptr) ? entry->feature : "-"
+                );
+                const size_t len = n > 0 ? std::min(static_cast<size_t>(n), sizeof(line) - 1) : 0;
+                if (len != 0 && builder.offset + len <= limit) {
+                    builder.Put(line, len);
+                }
+            };
+            for (const auto &timing : boot_report::Hooks()) {
+                put("hook", timing);
+            }
+            for (const auto &timing : boot_report::Patches()) {
+                put("patch", timing);
+            }
+            builder.End();
+        }
+
+        // Torn lines at the wrap point (or from a writer racing the crash) are
+        // expected; the analyzer drops the partial first line.
+        static void PutLogTail(Builder &builder) {
+            const u64 end = g_log_cursor.load(std::memory_order_acquire);
+            if (end == 0 || !builder.Begin(SectionType_LogTail)) {
+                return;
+            }
+            const size_t count = static_cast<size_t>(std::min<u64>(end, kLogTailBytes));
+            const size_t start = static_cast<size_t>((end - count) % kLogTailBytes);
+            const size_t first = std::min(count, kLogTailBytes - start);
+            builder.Put(g_log_tail.data() + start, first);
+            builder.Put(g_log_tail.data(), count - first);
+            builder.End();
+        }
+
+        static void PutBuild(Builder &builder) {
+            if (!builder.Begin(SectionType_Build)) {
+                return;
+            }
+            builder.Put(build_stamp::kBuildDisplay, std::strlen(build_stamp::kBuildDisplay));
+            builder.End();
+        }
+
+        static auto WriteBuffer(size_t size) -> bool {
+            (void)nn::fs::DeleteFile(kDumpPath);
+            if (R_FAILED(nn::fs::CreateFile(kDumpPath, static_cast<s64>(size)))) {
+                return false;
+            }
+            nn::fs::FileHandle file {};
+            if (R_FAILED(nn::fs::OpenFile(&file, kDumpPath, nn::fs::OpenMode_Write))) {
+                return false;
+            }
+            const auto opt = nn::fs::WriteOption::CreateOption(nn::fs::WriteOptionFlag_Flush);
+            const bool ok  = R_SUCCEEDED(nn::fs::WriteFile(file, 0, g_buffer.data(), size, opt));
+            nn::fs::CloseFile(file);
+            return ok;
+        }
+    }  // namespace
+
+    void RecordLogLine(std::string_view line) {
+        if (line.empty()) {
+            return;
+        }
+        const bool   newline = line.back() != '\n';
+        const size_t len     = std::min(line.size(), kLogTailBytes / 4);
+        const size_t total   = len + (newline ? 1 : 0);
+        const u64    start   = g_log_cursor.fetch_add(total, std::memory_order_relaxed);
+        size_t       pos     = static_cast<size_t>(start % kLogTailBytes);
+        const size_t first   = std::min(len, kLogTailBytes - pos);
+        std::memcpy(g_log_tail.data() + pos, line.data(), first);
+        std::memcpy(g_log_tail.data(), line.data() + first, len - first);
+        if (newline) {
+            pos             = static_cast<size_t>((start + len) % kLogTailBytes);
+            g_log_tail[pos] = '\n';
+        }
+    }
+
+    auto Write(const nn::os::UserExceptionInfo *info) -> size_t {
+        if (info == nullptr || g_capturing.test_and_set(std::memory_order_acq_rel)) {
+            return 0;
+        }
+
+        const auto &detail = info->detail;
+        Builder     builder;
+        if (builder.Begin(SectionType_Registers)) {
+            builder.Put(&detail, sizeof(detail));
+            builder.End();
+        }
+        PutBuild(builder);
+        PutModules(builder);
+        PutHooks(builder);
+        PutLogTail(builder);
+        PutCode(builder, MemoryKind_CodePc, static_cast<uintptr_t>(detail.pc));
+        PutCode(builder, MemoryKind_CodeLr, static_cast<uintptr_t>(detail.lr));
+        PutMemory(builder, MemoryKind_Far, static_cast<uintptr_t>(detail.far), kFarWindowBytes);
+        // Last: the stack window is the largest section and takes what is left.
+        PutMemory(builder, MemoryKind_Stack, static_cast<uintptr_t>(detail.sp), kStackWindowBytes);
+
+        const FileHeader header {
+            .magic          = {kMagic[0], kMagic[1], kMagic[2], kMagic[3]},
+            .version        = kVersion,
+            .section_count  = builder.section_count,
+            .total_bytes    = static_cast<u32>(builder.offset),
+            .tick           = static_cast<u64>(nn::os::GetSystemTick().GetInt64Value()),
+            .tick_frequency = static_cast<u64>(nn::os::GetSystemTickFrequency()),
+            .exception_type = info->exceptionType,
+            .core           = nn::os::GetCurrentCoreNumber(),
+        };
+        std::memcpy(g_buffer.data(), &header, sizeof(header));
+
+        const size_t size = builder.offset;
+        if (!WriteBuffer(size)) {
+            g_capturing.clear(std::memory_order_release);
+            return 0;
+        }
+        return size;
+    }
+
+}  // namespace d3::crash_capture
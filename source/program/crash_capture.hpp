@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace nn::os {
+    struct UserExceptionInfo;
+}  // namespace nn::os
+
+namespace d3::crash_capture {
+
+    // Binary crash snapshot written by the user exception handler next to the
+    // text dump. Every section is laid out in one static buffer and the file is
+    // produced with a single WriteFile, so a wedged SD or a second fault costs
+    // at most one I/O. tools/crash_analyze.py pretty-prints and symbolizes it.
+    //
+    // File layout (little-endian):
+    //   header   "D3CR", u32 version, u32 section count, u32 total bytes,
+    //            u64 tick, u64 tick frequency, u32 exception type, s32 core
+    //   sections u32 type, u32 payload bytes, payload padded to 8 bytes
+    //     1 = registers  nn::os::UserExceptionInfoDetail as-is
+    //     2 = memory     u64 address, u32 kind, u32 reserved, bytes
+    //                    (kind 0 = stack from sp, 1 = code around pc,
+    //                    2 = code around lr, 3 = bytes at far)
+    //     3 = modules    u32 count, u32 reserved, then count x {u32 index,
+    //                    u32 flags (1 = main, 2 = self), u64 start, u64 end,
+    //                    u64 text start, u64 text end, char name[64]}
+    //     4 = hooks      text, one "hook|patch\t<name>\t<owner>\t<feature>" per line
+    //     5 = log tail   last kLogTailBytes of PRINT output, oldest first
+    //     6 = build      build display string
+    constexpr const char *kDumpPath     = "sd:/config/d3hack-nx/crash.d3cr";
+    constexpr size_t      kLogTailBytes = 8 * 1024;
+
+    // Appends one formatted PRINT line to the in-memory tail. Lock-free and
+    // allocation-free; concurrent writers reserve disjoint byte ranges.
+    void RecordLogLine(std::string_view line);
+
+    // Fills the capture buffer from `info` and writes it to kDumpPath. Safe
+    // from the exception handler stack: no heap, no locks. Returns the bytes
+    // written, or 0 on failure or when another core is already capturing.
+    auto Write(const nn::os::UserExceptionInfo *info) -> size_t;
+
+}  // namespace d3::crash_capture
@@ -8,6 +8,7 @@
 
 #if D3HACK_ENABLE_UTILITY_DEBUG_HOOKS
 #include "program/config.hpp"
+#include "program/config_snapshot.hpp"
 #include "program/d3/types/attributes.hpp"
 #include "program/d3/types/common.hpp"
 #include "lib/hook/inline.hpp"
@@ -99,7 +100,8 @@ namespace d3 {
     HOOK_DEFINE_TRAMPOLINE(Enum_GB_Types) {
         static void Callback(GameBalanceType eType, GBHandleList *listResults) {
             Orig(eType, listResults);
-            if (global_config.defaults_only || !global_config.debug.active || !global_config.debug.enable_debug_flags) {
+            const auto &cfg = config_snapshot::Current();
+            if (cfg->defaults_only || !cfg->debug.active || !cfg->debug.enable_debug_flags) {
                 return;
             }
 
@@ -154,9 +156,10 @@ namespace d3 {
     HOOK_DEFINE_TRAMPOLINE(TryPopNotificationMessageHook) {
         static auto Callback(u32 *pOutMessage) -> bool {
             const bool ret = Orig(pOutMessage);
+            const bool log = config_snapshot::Current()->debug.log_oe_notification_messages;
             if (ret && pOutMessage != nullptr) {
                 const auto msg = static_cast<u32>(*pOutMessage);
-                if (global_config.debug.log_oe_notification_messages) {
+                if (log) {
                     PRINT("TryPopNotificationMessage: %u (0x%x)", msg, msg)
                 }
                 return ret;
@@ -164,7 +167,7 @@ namespace d3 {
             if (g_pending_dock_notify && pOutMessage != nullptr) {
                 g_pending_dock_notify = false;
                 *pOutMessage          = 0x1Eu;
-                if (global_config.debug.log_oe_notification_messages) {
+                if (log) {
                     PRINT_LINE("TryPopNotificationMessage: forced 0x1E");
                 }
                 return true;
@@ -172,7 +175,7 @@ namespace d3 {
             if (g_pending_perf_notify && pOutMessage != nullptr) {
                 g_pending_perf_notify = false;
                 *pOutMessage          = 0x1Fu;
-                if (global_config.debug.log_oe_notification_messages) {
+                if (log) {
                     PRINT_LINE("TryPopNotificationMessage: forced 0x1F");
                 }
                 return true;
@@ -0,0 +1,87 @@
+#include "d3/attrib_meta.hpp"
+
+#include "d3/util_globals.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+
+namespace d3::attrib_meta {
+    namespace {
+        std::array<Info, kCount> g_info {};
+        std::atomic<u8>          g_info_state {0};  // 0 empty, 1 filling, 2 ready
+
+        static void FillInfo() {
+            for (s32 id = 0; id < kCount; ++id) {
+                Info &info = g_info[static_cast<size_t>(id)];
+                info.id    = id;
+                info.name  = kNames[id];
+                if (g_arAttribDefs != nullptr) {
+                    const AttribDef &def = g_arAttribDefs[id];
+                    info.data_type       = def.eAttributeDataType;
+                    info.param_type      = def.eParameterType;
+                    info.default_value   = def.tDefaultValue;
+                }
+            }
+        }
+
+        static auto Table() -> const std::array<Info, kCount> * {
+            u8 state = g_info_state.load(std::memory_order_acquire);
+            if (state == 0 && g_info_state.compare_exchange_strong(state, 1, std::memory_order_acquire)) {
+                FillInfo();
+                g_info_state.store(2, std::memory_order_release);
+                return &g_info;
+            }
+            // Another thread is filling it; callers treat this like an unknown id.
+            return state == 2 ? &g_info : nullptr;
+        }
+    }  // namespace
+
+    auto Describe(s32 id) -> const Info * {
+        if (id < 0 || id >= kCount) {
+            return nullptr;
+        }
+        const auto *table = Table();
+        return table != nullptr ? &(*table)[static_cast<size_t>(id)] : nullptr;
+    }
+
+    auto FormatKey(FastAttribKey key, char *out, size_t out_size) -> size_t {
+        if (out == nullptr || out_size == 0) {
+            return 0;
+        }
+        const s32              id    = key.nValue & 0xFFF;
+        const s32              param = key.nValue >> 12;
+        const std::string_view name  = NameOf(id);
+
+        int written = 0;
+        if (name.empty()) {
+            written = snprintf(out, out_size, "attrib_0x%X", static_cast<unsigned>(id));
+        } else if (param == 0 || param == -1) {
+            written = snprintf(out, out_size, "%.*s", static_cast<int>(name.size()), name.data());
+        } else {
+            written = snprintf(out, out_size, "%.*s[0x%X]", static_cast<int>(name.size()), name.data(), static_cast<unsigned>(param));
+        }
+        if (written < 0) {
+            out[0] = '\0';
+            return 0;
+        }
+        return std::min(static_cast<size_t>(written), out_size - 1);
+    }
+
+    auto FormatValue(s32 id, FastAttribValue value, char *out, size_t out_size) -> size_t {
+        if (out == nullptr || out_size == 0) {
+            return 0;
+        }
+        const Info *info   = Describe(id);
+        const bool  is_int = info != nullptr && info->IsInt();
+        const int written = is_int ? snprintf(out, out_size, "%d", value._anon_0.nValue)
+                                   : snprintf(out, out_size, "%.3f", static_cast<double>(value._anon_0.flValue));
+        if (written < 0) {
+            out[0] = '\0';
+            return 0;
+        }
+        return std::min(static_cast<size_t>(written), out_size - 1);
+    }
+
+}  // namespace d3::attrib_meta
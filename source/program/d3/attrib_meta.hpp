@@ -0,0 +1,120 @@
+#pragma once
+
+#include "d3/types/common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+namespace d3::attrib_meta {
+
+    // Attribute names generated from the Attributes enum (tools/gen_attribute_names.py).
+    // Indexed directly by attribute id; ids are contiguous from 0.
+    inline constexpr std::string_view kNames[] = {
+#define D3_ATTRIB(id, name) #name,
+#include "d3/types/attribute_names.inc"
+#undef D3_ATTRIB
+    };
+
+    inline constexpr s32 kCount = static_cast<s32>(std::size(kNames));
+
+    // Case-insensitive 32-bit FNV-1a, so config keys can use either the enum
+    // spelling (STRENGTH_TOTAL) or the game's (Strength_Total).
+    constexpr auto HashName(std::string_view name) -> u32 {
+        u32 hash = 2166136261u;
+        for (const char c : name) {
+            const char lower = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+            hash ^= static_cast<unsigned char>(lower);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    struct NameIndexEntry {
+        u32 hash;
+        s32 id;
+    };
+
+    inline constexpr auto kNameIndex = [] {
+        std::array<NameIndexEntry, std::size(kNames)> index {};
+        for (size_t i = 0; i < index.size(); ++i) {
+            index[i] = NameIndexEntry {.hash = HashName(kNames[i]), .id = static_cast<s32>(i)};
+        }
+        std::sort(index.begin(), index.end(), [](const NameIndexEntry &a, const NameIndexEntry &b) { return a.hash < b.hash; });
+        return index;
+    }();
+
+    static_assert(
+        [] {
+            for (size_t i = 1; i < kNameIndex.size(); ++i) {
+                if (kNameIndex[i - 1].hash == kNameIndex[i].hash) {
+                    return false;
+                }
+            }
+            return true;
+        }(),
+        "attribute name hash collision; switch HashName to 64-bit"
+    );
+
+    constexpr auto NameOf(s32 id) -> std::string_view {
+        if (id < 0 || id >= kCount) {
+            return {};
+        }
+        return kNames[id];
+    }
+
+    constexpr auto EqualsIgnoreCase(std::string_view a, std::string_view b) -> bool {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            const char ca = (a[i] >= 'A' && a[i] <= 'Z') ? static_cast<char>(a[i] - 'A' + 'a') : a[i];
+            const char cb = (b[i] >= 'A' && b[i] <= 'Z') ? static_cast<char>(b[i] - 'A' + 'a') : b[i];
+            if (ca != cb) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Returns the attribute id for `name`, or -1 (ATTRIBUTE_NONE) when unknown.
+    constexpr auto FindByName(std::string_view name) -> s32 {
+        const u32   hash = HashName(name);
+        const auto *it   = std::lower_bound(
+            kNameIndex.begin(), kNameIndex.end(), hash, [](const NameIndexEntry &e, u32 h) { return e.hash < h; }
+        );
+        if (it == kNameIndex.end() || it->hash != hash || !EqualsIgnoreCase(kNames[it->id], name)) {
+            return -1;
+        }
+        return it->id;
+    }
+
+    static_assert(NameOf(0xA) == "STRENGTH");
+    static_assert(FindByName("strength_total") == 0xE);
+    static_assert(FindByName("not_an_attribute") == -1);
+
+    // Per-id metadata. The name is constexpr; the data type, parameter kind and
+    // default are copied from the game's AttribDef array on the first lookup,
+    // so later lookups never touch game memory or string helpers.
+    struct Info {
+        s32                    id = -1;
+        std::string_view       name;
+        AttributeDataType      data_type  = 0;  // 1 = int, otherwise float
+        AttributeParameterType param_type = 0;
+        FastAttribValue        default_value {0};
+
+        auto IsInt() const -> bool { return data_type == 1; }
+    };
+
+    // nullptr for ids outside the table.
+    auto Describe(s32 id) -> const Info *;
+
+    // Formats "NAME" or "NAME[param]" into `out` without calling game string APIs.
+    auto FormatKey(FastAttribKey key, char *out, size_t out_size) -> size_t;
+
+    // Formats a value according to the attribute's data type ("123" / "1.500").
+    auto FormatValue(s32 id, FastAttribValue value, char *out, size_t out_size) -> size_t;
+
+}  // namespace d3::attrib_meta
@@ -0,0 +1,126 @@
+#include "d3/dynamic_res.hpp"
+
+#include "d3/util_globals.hpp"
+#include "program/config.hpp"
+#include "program/frame_timing.hpp"
+#include "program/logging.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+namespace d3::dynamic_res {
+    namespace {
+        Controller g_controller {};
+        u64        g_last_update_present = 0;
+        int        g_last_docked         = -1;  // -1 = controller not primed
+        bool       g_logged_fallback     = false;
+
+        std::atomic<u32> g_scale_bits {0};  // 0 = inactive
+
+        static auto BuildParams(const PatchConfig::ResolutionHackConfig &cfg, bool docked) -> ControllerParams {
+            ControllerParams p {};
+            p.min_scale = std::clamp(cfg.min_res_scale, 10.0f, 100.0f) * 0.01f;
+            p.max_scale = std::clamp(cfg.max_res_scale, cfg.min_res_scale, 100.0f) * 0.01f;
+            p.target_ms = docked ? cfg.adaptive_target_ms_docked : cfg.adaptive_target_ms_handheld;
+            return p;
+        }
+
+        static void ApplyToGame(float scale) {
+            const auto *rwindow  = g_ptMainRWindow;
+            auto       *var_data = (rwindow != nullptr) ? rwindow->m_ptVariableResRWindowData : nullptr;
+            if (var_data == nullptr) {
+                return;
+            }
+            // Pin the game's own controller to our output.
+            var_data->flMinPercent = scale;
+            var_data->flMaxPercent = scale;
+            var_data->flPercent    = scale;
+        }
+
+        static void Deactivate() {
+            g_last_docked = -1;
+            g_scale_bits.store(0, std::memory_order_relaxed);
+
+            // Hand the bounds back to the static config values.
+            const auto *rwindow  = g_ptMainRWindow;
+            auto       *var_data = (rwindow != nullptr) ? rwindow->m_ptVariableResRWindowData : nullptr;
+            if (var_data != nullptr) {
+                const auto &res        = global_config.resolution_hack;
+                const float min_pct    = std::clamp(res.min_res_scale, 10.0f, 100.0f);
+                const float max_pct    = std::clamp(res.max_res_scale, min_pct, 100.0f);
+                var_data->flMinPercent = min_pct * 0.01f;
+                var_data->flMaxPercent = max_pct * 0.01f;
+            }
+        }
+    }  // namespace
+
+    void OnPresent() {
+        const auto &res = global_config.resolution_hack;
+        if (!global_config.initialized || !res.active || !res.adaptive_res || g_ptGfxNVNGlobals == nullptr) {
+            if (g_last_docked != -1) {
+                Deactivate();
+            }
+            return;
+        }
+
+        const u64  presents = frame_timing::PresentCount();
+        const int  docked   = g_ptGfxNVNGlobals->bIsDocked != 0 ? 1 : 0;
+        const auto params   = BuildParams(res, docked != 0);
+
+        if (docked != g_last_docked) {
+            // Dock transitions change both the output size and the target: start from full scale.
+            g_controller.Reset(params.max_scale);
+            g_last_docked         = docked;
+            g_last_update_present = presents;
+            g_scale_bits.store(std::bit_cast<u32>(params.max_scale), std::memory_order_relaxed);
+            ApplyToGame(params.max_scale);
+            PRINT("[dynres] primed: docked=%d target=%.1fms scale=%.2f-%.2f", docked, params.target_ms, params.min_scale, params.max_scale)
+            return;
+        }
+
+        if (presents - g_last_update_present < kWindowFrames) {
+            return;
+        }
+        g_last_update_present = presents;
+
+        frame_timing::Stats stats {};
+        if (!frame_timing::ComputeStats(stats, kWindowFrames)) {
+            return;
+        }
+
+        // Work time (submit to GPU fence) is what resolution actually changes;
+        // the present interval is quantized to vsync and reads as a full 33.3 ms
+        // at a locked 30 fps whatever the load. Fences land a few frames late,
+        // so wait for half the window; fall back to the present interval only
+        // when no fence has ever landed (sync procs unavailable).
+        float cost_ms = stats.work_p90_ms;
+        if (stats.work_samples < kWindowFrames / 2) {
+            if (stats.work_samples != 0) {
+                return;
+            }
+            if (!g_logged_fallback) {
+                g_logged_fallback = true;
+                PRINT("[dynres] no GPU work samples; using the present interval (p90=%.1fms)", stats.p90_ms)
+            }
+            cost_ms = stats.p90_ms;
+        }
+
+        const float prev  = g_controller.scale();
+        const float scale = g_controller.Update(cost_ms, params);
+        g_scale_bits.store(std::bit_cast<u32>(scale), std::memory_order_relaxed);
+        if (scale != prev) {
+            ApplyToGame(scale);
+        }
+    }
+
+    auto CurrentScale(float &out_scale) -> bool {
+        const u32 bits = g_scale_bits.load(std::memory_order_relaxed);
+        if (bits == 0) {
+            return false;
+        }
+        out_scale = std::bit_cast<float>(bits);
+        return true;
+    }
+
+}  // namespace d3::dynamic_res
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "d3/dynamic_res_controller.hpp"
+
+namespace d3::dynamic_res {
+
+    // Present-thread hook: every kWindowFrames presents, feeds the frame_timing
+    // work-time p90 (present-interval p90 without GPU fences) into the controller
+    // and pushes the resulting scale into the game's VariableResRWindowData
+    // bounds. No-op unless resolution_hack.adaptive_res is set.
+    constexpr unsigned kWindowFrames = 30;
+
+    void OnPresent();
+
+    // Current adaptive scale as a fraction; false when the controller is inactive.
+    auto CurrentScale(float &out_scale) -> bool;
+
+}  // namespace d3::dynamic_res
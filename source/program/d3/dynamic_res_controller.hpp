@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+// Pure feedback controller for the adaptive dynamic-resolution mode.
+// No game or SDK dependencies so tools/dynres_sim can compile it on the host.
+namespace d3::dynamic_res {
+
+    struct ControllerParams {
+        float min_scale = 0.70f;
+        float max_scale = 1.00f;
+        float target_ms = 33.3f;
+
+        // Hysteresis band around target (fractions of target). Asymmetric on purpose:
+        // drop resolution as soon as we are slightly over budget, raise it only with clear headroom.
+        float over_band  = 0.03f;
+        float under_band = 0.12f;
+
+        // PI gains on the relative error. GPU cost scales ~ with pixel count (scale^2),
+        // so the proportional term is halved when mapped to a scale delta.
+        float kp = 0.60f;
+        float ki = 0.10f;
+
+        float    max_step         = 0.05f;  // max relative scale change per update
+        uint32_t cooldown_updates = 2;      // updates to hold after any change
+    };
+
+    class Controller {
+       public:
+        void Reset(float scale) {
+            scale_    = scale;
+            integral_ = 0.0f;
+            cooldown_ = 0;
+        }
+
+        auto scale() const -> float { return scale_; }
+
+        // Feed one window's frame-time percentile (ms). Returns the new scale.
+        auto Update(float percentile_ms, const ControllerParams &p) -> float {
+            scale_ = std::clamp(scale_, p.min_scale, p.max_scale);
+            if (percentile_ms <= 0.0f || p.target_ms <= 0.0f) {
+                return scale_;
+            }
+
+            const float err   = (percentile_ms - p.target_ms) / p.target_ms;  // > 0: too slow
+            const bool  over  = err > p.over_band;
+            const bool  under = err < -p.under_band;
+            if (!over && !under) {
+                integral_ *= 0.5f;
+                if (cooldown_ > 0) {
+                    --cooldown_;
+                }
+                return scale_;
+            }
+            // Raising resolution waits out the cooldown; dropping it never does.
+            if (under && cooldown_ > 0) {
+                --cooldown_;
+                return scale_;
+            }
+
+            integral_         = std::clamp(integral_ + err, -1.0f, 1.0f);
+            const float delta = std::clamp(-0.5f * (p.kp * err + p.ki * integral_), -p.max_step, p.max_step);
+            const float next  = std::clamp(scale_ * (1.0f + delta), p.min_scale, p.max_scale);
+            if (next != scale_) {
+                scale_    = next;
+                cooldown_ = p.cooldown_updates;
+            }
+            return scale_;
+        }
+
+       private:
+        float    scale_    = 1.0f;
+        float    integral_ = 0.0f;
+        uint32_t cooldown_ = 0;
+    };
+
+}  // namespace d3::dynamic_res
@@ -0,0 +1,241 @@
+#include "d3/gamebalance_index.hpp"
+
+#include "d3/gamebalance.hpp"
+#include "d3/util_globals.hpp"
+#include "program/log_once.hpp"
+#include "program/logging.hpp"
+#include "program/system_allocator.hpp"
+#include "symbols/common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+
+namespace d3::gamebalance_index {
+    namespace {
+        enum class State : u8 {
+            Empty,
+            Building,
+            Ready,
+        };
+
+        struct ItemSlot {
+            GBID gbid;
+            u32  index;  // into ItemAppGlobals::ptItems
+        };
+
+        struct TypeRange {
+            u32  offset;
+            u32  count;
+            bool truncated;
+        };
+
+        constexpr GBID kEmptyGbid = -1;
+
+        std::atomic<State> g_state {State::Empty};
+
+        ItemSlot   *g_item_slots = nullptr;
+        u32         g_item_mask  = 0;
+        u32         g_item_count = 0;
+        const Item *g_items_base = nullptr;
+        GBID       *g_gbid_pool  = nullptr;
+        u32         g_truncated  = 0;
+
+        std::array<TypeRange, NUM_GBTYPES> g_types {};
+
+        static auto HashGbid(GBID gbid) -> u32 {
+            // Fibonacci hashing; GBIDs are already string hashes so this mostly spreads low bits.
+            return static_cast<u32>((static_cast<u64>(static_cast<u32>(gbid)) * 0x9E3779B97F4A7C15ull) >> 32);
+        }
+
+        static auto TableMaxElements(GameBalanceType eType) -> u32 {
+            const auto idx = static_cast<size_t>(eType) + 2;
+            if (idx >= std::size(g_tGBTableUnshifted)) {
+                return 0;
+            }
+            return static_cast<u32>(g_tGBTableUnshifted[idx].maxElements);
+        }
+
+        static auto BuildItemTable(nn::mem::StandardAllocator *allocator, const ItemAppGlobals &item_globals) -> bool {
+            const u32 n_items = static_cast<u32>(item_globals.nItems);
+            // Size for a load factor <= 0.5 so probe chains stay short.
+            const u32 capacity = std::bit_ceil(std::max(n_items, TableMaxElements(GB_ITEMS)) * 2u);
+
+            auto *slots = static_cast<ItemSlot *>(allocator->Allocate(sizeof(ItemSlot) * capacity));
+            if (slots == nullptr) {
+                return false;
+            }
+            for (u32 i = 0; i < capacity; ++i) {
+                slots[i] = ItemSlot {.gbid = kEmptyGbid, .index = 0};
+            }
+
+            const u32 mask  = capacity - 1u;
+            u32       count = 0;
+            for (u32 i = 0; i < n_items; ++i) {
+                const GBID gbid = item_globals.ptItems[i].gbid;
+                if (gbid == kEmptyGbid) {
+                    continue;
+                }
+                u32 pos = HashGbid(gbid) & mask;
+                while (slots[pos].gbid != kEmptyGbid && slots[pos].gbid != gbid) {
+                    pos = (pos + 1u) & mask;
+                }
+                if (slots[pos].gbid == kEmptyGbid) {
+                    ++count;
+                }
+                slots[pos] = ItemSlot {.gbid = gbid, .index = i};
+            }
+
+            g_item_slots = slots;
+            g_item_mask  = mask;
+            g_item_count = count;
+            g_items_base = item_globals.ptItems;
+            return true;
+        }
+
+        static auto BuildTypeArrays(nn::mem::StandardAllocator *allocator) -> bool {
+            u32 total = 0;
+            for (s32 t = 0; t < NUM_GBTYPES; ++t) {
+                total += TableMaxElements(static_cast<GameBalanceType>(t));
+            }
+            if (total == 0) {
+                return true;
+            }
+
+            auto *pool = static_cast<GBID *>(allocator->Allocate(sizeof(GBID) * total));
+            if (pool == nullptr) {
+                return false;
+            }
+
+            u32 offset = 0;
+            for (s32 t = 0; t < NUM_GBTYPES; ++t) {
+                const auto eType    = static_cast<GameBalanceType>(t);
+                const u32  capacity = TableMaxElements(eType);
+                auto      &range    = g_types[static_cast<size_t>(t)];
+                range               = TypeRange {.offset = offset, .count = 0, .truncated = false};
+                if (capacity == 0) {
+                    continue;
+                }
+
+                GBHandleList listResults = {};
+                memset(static_cast<void *>(&listResults), 0, 20);
+                listResults.m_list.m_ptNodeAllocator = reinterpret_cast<XListMemoryPool<GBHandle> *>(GBGetHandlePool());
+                listResults.m_ConstructorCalled      = 1;
+                GBEnumerate(eType, &listResults);
+
+                for (auto *node = listResults.m_list.m_pHead; node != nullptr && node->m_tData.eType == eType; node = node->m_pNext) {
+                    if (range.count >= capacity) {
+                        range.truncated = true;
+                        break;
+                    }
+                    pool[offset + range.count++] = node->m_tData.gbid;
+                }
+                if (range.truncated) {
+                    ++g_truncated;
+                    PRINT("[gb_index] %s exceeds maxElements=%u; falling back to enumeration", g_tGBTableUnshifted[t + 2].name, capacity)
+                }
+                offset += capacity;
+            }
+
+            g_gbid_pool = pool;
+            return true;
+        }
+
+        static void ReleasePartial(nn::mem::StandardAllocator *allocator) {
+            if (g_item_slots != nullptr) {
+                allocator->Free(g_item_slots);
+            }
+            if (g_gbid_pool != nullptr) {
+                allocator->Free(g_gbid_pool);
+            }
+            g_item_slots = nullptr;
+            g_gbid_pool  = nullptr;
+            g_item_mask  = 0;
+            g_item_count = 0;
+            g_items_base = nullptr;
+            g_truncated  = 0;
+            g_types      = {};
+        }
+    }  // namespace
+
+    auto Build() -> bool {
+        if (g_state.load(std::memory_order_acquire) == State::Ready) {
+            return true;
+        }
+
+        const ItemAppGlobals *item_globals = g_tAppGlobals.ptItemAppGlobals;
+        if (item_globals == nullptr || item_globals->ptItems == nullptr || item_globals->nItems <= 0) {
+            return false;  // GameBalance not loaded yet.
+        }
+
+        auto *allocator = system_allocator::GetSystemAllocator();
+        if (allocator == nullptr) {
+            return false;
+        }
+
+        State expected = State::Empty;
+        if (!g_state.compare_exchange_strong(expected, State::Building, std::memory_order_acq_rel)) {
+            return expected == State::Ready;
+        }
+
+        if (!BuildItemTable(allocator, *item_globals) || !BuildTypeArrays(allocator)) {
+            ReleasePartial(allocator);
+            g_state.store(State::Empty, std::memory_order_release);
+            PRINT_ONCE("gb_index.alloc_failed", "%s", "[gb_index] allocation failed; lookups fall back to game tables")
+            return false;
+        }
+
+        g_state.store(State::Ready, std::memory_order_release);
+        PRINT("[gb_index] ready: %u items (mask=0x%x), %u truncated types", g_item_count, g_item_mask, g_truncated)
+        return true;
+    }
+
+    auto IsReady() -> bool {
+        return g_state.load(std::memory_order_acquire) == State::Ready;
+    }
+
+    auto FindItem(GBID gbid) -> const Item * {
+        if (gbid == kEmptyGbid || !Build()) {
+            return nullptr;
+        }
+        // The game never reallocates ptItems after load; if it ever does, refuse stale indices.
+        const ItemAppGlobals *item_globals = g_tAppGlobals.ptItemAppGlobals;
+        if (item_globals == nullptr || item_globals->ptItems != g_items_base) {
+            return nullptr;
+        }
+
+        u32 pos = HashGbid(gbid) & g_item_mask;
+        while (true) {
+            const ItemSlot &slot = g_item_slots[pos];
+            if (slot.gbid == gbid) {
+                return &g_items_base[slot.index];
+            }
+            if (slot.gbid == kEmptyGbid) {
+                return nullptr;
+            }
+            pos = (pos + 1u) & g_item_mask;
+        }
+    }
+
+    auto GBIDsOfType(GameBalanceType eType) -> std::span<const GBID> {
+        if (eType < 0 || eType >= NUM_GBTYPES || !Build()) {
+            return {};
+        }
+        const TypeRange &range = g_types[static_cast<size_t>(eType)];
+        if (range.truncated || g_gbid_pool == nullptr) {
+            return {};
+        }
+        return {g_gbid_pool + range.offset, range.count};
+    }
+
+    auto ItemCount() -> u32 {
+        return IsReady() ? g_item_count : 0u;
+    }
+
+    auto TruncatedTypeCount() -> u32 {
+        return IsReady() ? g_truncated : 0u;
+    }
+
+}  // namespace d3::gamebalance_index
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "d3/types/common.hpp"
+
+#include <span>
+
+namespace d3::gamebalance_index {
+
+    // One-time GameBalance index built after the game has loaded its GBID tables:
+    // - flat open-addressed GBID -> Item* table (replaces walking mapItems per lookup)
+    // - per-GameBalanceType contiguous GBID arrays sized from g_tGBTableUnshifted[].maxElements
+    //
+    // Build() is cheap to call repeatedly; it only does work once the item globals are
+    // populated. Queries never allocate and return nullptr/empty before the index is ready.
+    auto Build() -> bool;
+    auto IsReady() -> bool;
+
+    auto FindItem(GBID gbid) -> const Item *;
+    auto GBIDsOfType(GameBalanceType eType) -> std::span<const GBID>;
+
+    // Diagnostics.
+    auto ItemCount() -> u32;
+    auto TruncatedTypeCount() -> u32;
+
+}  // namespace d3::gamebalance_index
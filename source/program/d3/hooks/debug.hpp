@@ -1,8 +1,11 @@
 #pragma once
 
 #include "program/config.hpp"
+#include "program/config_snapshot.hpp"
+#include "program/hook_trace.hpp"
 #include "program/tagnx.hpp"
 #include "program/d3/_util.hpp"
+#include "program/d3/gamebalance_index.hpp"
 #include "program/d3/types/attributes.hpp"
 #include "program/d3/types/d3_account.hpp"
 #include "program/d3/types/common.hpp"
@@ -20,6 +23,7 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <span>
 
 namespace d3 {
     namespace {
@@ -294,8 +298,12 @@ namespace d3 {
                 fullattr, fullstr,
                 (fullattr >> 12), fullparamstr
             );
-            std::vector<GBID> eBonuses;
-            AllGBIDsOfType(GB_PARAGON_BONUSES, eBonuses);
+            std::vector<GBID>     eBonusesFallback;
+            std::span<const GBID> eBonuses = gamebalance_index::GBIDsOfType(GB_PARAGON_BONUSES);
+            if (eBonuses.empty()) {
+                AllGBIDsOfType(GB_PARAGON_BONUSES, eBonusesFallback);
+                eBonuses = eBonusesFallback;
+            }
             for (GBID bonusGbid : eBonuses) {
                 // break;
                 auto gbString = GbidStringAll(bonusGbid);  //, GB_PARAGON_BONUSES);
@@ -457,7 +465,7 @@ namespace d3 {
     }
 
     inline bool CacheChallengeRiftRaw(const char *filename, const blz::string *data, const char *log_line) {
-        if (data == nullptr || global_config.debug.enable_pubfile_dump == false) {
+        if (data == nullptr || config_snapshot::Current()->debug.enable_pubfile_dump == false) {
             return false;
         }
         const char  *bytes = data->m_elements ? data->m_elements : data->m_storage;
@@ -470,7 +478,7 @@ namespace d3 {
             return false;
         }
         EnsurePubfileCacheDir();
-        if (WriteTestFile(cache_path, const_cast<char *>(bytes), size)) {
+        if (WriteFileSync(cache_path, const_cast<char *>(bytes), size)) {
             PRINT_LINE(log_line);
             return true;
         }
@@ -787,26 +795,22 @@ namespace d3 {
             if ((fdata == nullptr) || (fdata->m_fileData == nullptr))
                 return;
             PRINT("BDFileDataMem (size: %d)\n %s", fdata->m_fileSize, (char *)fdata->m_fileData)
-            auto         length     = static_cast<u32>(fdata->m_fileSize);
-            const auto  *bytes      = reinterpret_cast<const u8 *>(fdata->m_fileData);
-            const u32    dumpLen    = (length < 100u) ? length : 100u;
-            const char   kPrefix[]  = "FILE CONTENT: ";
-            const size_t kPrefixLen = sizeof(kPrefix) - 1;
-            const size_t outLen     = kPrefixLen + (static_cast<size_t>(dumpLen) * 3);
-            auto        *out        = static_cast<char *>(SigmaMemoryNew(outLen + 1, 0, nullptr, 1));
-            if (out != nullptr) {
-                SigmaMemoryMove(out, const_cast<char *>(kPrefix), kPrefixLen);
-                size_t pos = kPrefixLen;
-                for (u32 i = 0; i < dumpLen; ++i) {
-                    const u8 value = bytes[i];
-                    out[pos++]     = ByteToChar((value >> 4) & 0xF);
-                    out[pos++]     = ByteToChar(value & 0xF);
-                    out[pos++]     = ' ';
-                }
-                out[pos] = '\0';
-                TraceInternal_Log(SLVL_INFO, 3u, OUTPUTSTREAM_DEFAULT, ": %s\n", out);
-                SigmaMemoryFree(out, nullptr);
+            // Hex preview goes through PRINT so it rides the async log writer
+            // instead of a direct ErrorManager stream write.
+            constexpr u32 kMaxDump = 100u;
+            auto          length   = static_cast<u32>(fdata->m_fileSize);
+            const auto   *bytes    = reinterpret_cast<const u8 *>(fdata->m_fileData);
+            const u32     dumpLen  = (length < kMaxDump) ? length : kMaxDump;
+            char          out[(kMaxDump * 3) + 1];
+            size_t        pos = 0;
+            for (u32 i = 0; i < dumpLen; ++i) {
+                const u8 value = bytes[i];
+                out[pos++]     = ByteToChar((value >> 4) & 0xF);
+                out[pos++]     = ByteToChar(value & 0xF);
+                out[pos++]     = ' ';
             }
+            out[pos] = '\0';
+            PRINT("FILE CONTENT: %s", out)
 
             if (length == 31) {
                 // auto chaldata = *(ChallengeData *)fdata->m_fileData;
@@ -829,8 +833,8 @@ namespace d3 {
             auto m_size = LODWORD(usize);
 
             PRINT("PublisherFileDataHex blz::basic_string (filesize: %d | stringsize: %d)", length, m_size)
-            auto        dump_path     = blz_make_stringf("%s/dumps/dmp_%u.dat", g_szBaseDir, length);
-            const char *dump_path_str = dump_path.m_elements ? dump_path.m_elements : "";
+            char dump_path_str[96] {};
+            snprintf(dump_path_str, sizeof(dump_path_str), "%s/dumps/dmp_%u.dat", g_szBaseDir, length);
             PRINT_EXPR("Trying to write to: %s", dump_path_str)
             if (bytes && WriteTestFile(dump_path_str, bytes, length))
                 PRINT_EXPR("Wrote to: %s !", dump_path_str)
@@ -871,8 +875,10 @@ namespace d3 {
     // };
 
     HOOK_DEFINE_TRAMPOLINE(ChallengeRiftCallback) {
+        HOOK_TRACE("DebuggingHooks", "challenge_rift_callback");
+
         static void Callback(void *bind, StorageResult *pRes, ChallengeData *ptChalConf, WeeklyChallengeData *ptChalData) {
-            const bool can_populate = global_config.challenge_rifts.active && ptChalConf && ptChalData && pRes;
+            const bool can_populate = config_snapshot::Current()->challenge_rifts.active && ptChalConf && ptChalData && pRes;
             if (can_populate) {
                 if (PopulateChallengeRiftData(*ptChalConf, *ptChalData))
                     *pRes = Console::Online::STORAGE_SUCCESS;
@@ -892,14 +898,15 @@ namespace d3 {
     // Fix: if we have a nonzero season number, tag the reward before running the stock save path.
     HOOK_DEFINE_TRAMPOLINE(ChallengeRiftRewardEarned_SaveToProfileHook) {
         static void Callback(int32 nUserIndex, void *tReward) {
+            const auto &cfg = config_snapshot::Current();
             PRINT(
                 "[cr_reward_save] ENTER user=%d reward=0x%lx active=%d",
                 nUserIndex,
                 reinterpret_cast<uintptr_t>(tReward),
-                global_config.challenge_rifts.active ? 1 : 0
+                cfg->challenge_rifts.active ? 1 : 0
             )
 
-            if (!global_config.challenge_rifts.active || tReward == nullptr) {
+            if (!cfg->challenge_rifts.active || tReward == nullptr) {
                 Orig(nUserIndex, tReward);
                 return;
             }
@@ -994,7 +1001,7 @@ namespace d3 {
     // rewrite its season_earned to the current season right before running the stock grant logic.
     HOOK_DEFINE_TRAMPOLINE(ChallengeRiftGrantRewardToPlayerIfEligibleHook) {
         static void Callback(Player *ptPlayer) {
-            if (global_config.challenge_rifts.active && ptPlayer != nullptr) {
+            if (config_snapshot::Current()->challenge_rifts.active && ptPlayer != nullptr) {
                 constexpr uintptr_t kRewardsListSentinelOff = 0xDD88;
                 constexpr uintptr_t kRewardsListHeadOff     = 0xDD90;
                 constexpr uintptr_t kNodeNextOff            = 0x8;
@@ -1076,7 +1083,8 @@ namespace d3 {
     // the same challenge for the next run.
     HOOK_DEFINE_TRAMPOLINE(ChallengeRiftHandleChallengeRewardsHook) {
         static void Callback(Player *ptPlayer, int32 arg1, void *reward_screen_info) {
-            if (global_config.challenge_rifts.active && ptPlayer != nullptr) {
+            const auto &cfg = config_snapshot::Current();
+            if (cfg->challenge_rifts.active && ptPlayer != nullptr) {
                 const uint32 cur_season              = OnlineServiceGetSeasonNum ? OnlineServiceGetSeasonNum() : 0u;
                 const int32  season_state            = OnlineServiceGetSeasonState ? OnlineServiceGetSeasonState() : -1;
                 const bool   is_game_seasonal        = GameIsSeasonal ? GameIsSeasonal() : false;
@@ -1099,7 +1107,7 @@ namespace d3 {
 
             Orig(ptPlayer, arg1, reward_screen_info);
 
-            if (global_config.challenge_rifts.active && ptPlayer != nullptr) {
+            if (cfg->challenge_rifts.active && ptPlayer != nullptr) {
                 const uint32 before_clear = ptPlayer->nLastRewardChallengeNumber;
                 // const uint32 challenge_num = cr_debug::GetCurrentChallengeNumber();
                 // const uint32 rearm_value = (challenge_num > 1u) ? (challenge_num - 1u) : 1u;
@@ -1128,8 +1136,10 @@ namespace d3 {
     // Player::nLastRewardChallengeNumber. Force-rearm that field before stock open logic so
     // test runs always begin in an eligible state.
     HOOK_DEFINE_TRAMPOLINE(OpenChallengeRiftHook) {
+        HOOK_TRACE("DebuggingHooks", "OpenChallengeRift");
+
         static void Callback() {
-            if (global_config.challenge_rifts.active) {
+            if (config_snapshot::Current()->challenge_rifts.active) {
                 const uint32 weekly_num = cr_debug::GetCurrentChallengeNumber();
                 int          patched    = 0;
                 for (Player *pt = PlayerGetFirstAll(); pt != nullptr; pt = PlayerGetNextAll(pt)) {
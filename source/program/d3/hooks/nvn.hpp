@@ -7,6 +7,7 @@
 #include "lib/hook/inline.hpp"
 #include "lib/util/modules.hpp"
 #include "program/config.hpp"
+#include "program/config_snapshot.hpp"
 #include <nvn/nvn.h>
 
 namespace d3::nvn {
@@ -27,14 +28,18 @@ namespace d3::nvn {
     static_assert(offsetof(NVNTexInfo, bIsWindowTexture) == 0x5C);
 
     inline auto ClampTexturesEnabled() -> bool {
-        return global_config.resolution_hack.active && global_config.resolution_hack.ClampTexturesEnabled();
+        const auto &cfg = config_snapshot::Current();
+        const auto &res = cfg->resolution_hack;
+        return res.active && res.ClampTexturesEnabled();
     }
 
     inline auto GetClampDims(u32 &limitW, u32 &limitH) -> bool {
-        if (!ClampTexturesEnabled())
+        const auto &cfg = config_snapshot::Current();
+        const auto &res = cfg->resolution_hack;
+        if (!res.active || !res.ClampTexturesEnabled())
             return false;
-        limitH = global_config.resolution_hack.ClampTextureHeightPx();
-        limitW = global_config.resolution_hack.ClampTextureWidthPx();
+        limitH = res.ClampTextureHeightPx();
+        limitW = res.ClampTextureWidthPx();
         return limitW != 0 && limitH != 0;
     }
 
@@ -192,10 +197,12 @@ namespace d3::nvn {
             u32        cur_width  = width;
             u32        cur_height = height;
 
-            const u32 outW = global_config.resolution_hack.OutputWidthPx();
-            const u32 outH = global_config.resolution_hack.OutputHeightPx();
+            const auto &cfg  = config_snapshot::Current();
+            const auto &res  = cfg->resolution_hack;
+            const u32   outW = res.OutputWidthPx();
+            const u32   outH = res.OutputHeightPx();
 
-            if (global_config.resolution_hack.active && outW != 0 && outH != 0 && IsSwapchainTexCreateLR(lrOffset)) {
+            if (res.active && outW != 0 && outH != 0 && IsSwapchainTexCreateLR(lrOffset)) {
                 if (cur_width != outW || cur_height != outH) {
                     tex->dwPixelWidth  = outW;
                     tex->dwPixelHeight = outH;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "program/config.hpp"
+#include "program/config_snapshot.hpp"
 #include "program/d3/_util.hpp"
 #include "program/d3/patches.hpp"
 #include "program/d3/setting.hpp"
@@ -13,7 +14,9 @@
 namespace d3 {
     extern float g_rt_scale;
     inline auto  ClampTexturesEnabled() -> bool {
-        return global_config.resolution_hack.active && global_config.resolution_hack.ClampTexturesEnabled();
+        const auto &cfg = config_snapshot::Current();
+        const auto &res = cfg->resolution_hack;
+        return res.active && res.ClampTexturesEnabled();
     }
     HOOK_DEFINE_TRAMPOLINE(GfxGetDesiredDisplayModeHook) {
         // @ DisplayMode *__struct_ptr GfxGetDesiredDisplayMode()
@@ -25,7 +28,9 @@ namespace d3 {
                 g_ptGfxNVNGlobals->dwReducedDeviceWidth,
                 g_ptGfxNVNGlobals->dwReducedDeviceHeight
             );
-            if (!global_config.resolution_hack.active)
+            const auto &cfg = config_snapshot::Current();
+            const auto &res = cfg->resolution_hack;
+            if (!res.active)
                 return Orig();
             // PRINT(
             //     "POST GFXNVN globals: dev=%ux%u reduced=%ux%u",
@@ -37,7 +42,7 @@ namespace d3 {
 
             auto result = Orig();
 
-            const auto &extra = global_config.resolution_hack.extra;
+            const auto &extra = res.extra;
             if (extra.window_left >= 0)
                 result.nWinLeft = extra.window_left;
             if (extra.window_top >= 0)
@@ -2,6 +2,9 @@
 
 #include "lib/hook/trampoline.hpp"
 #include "program/config.hpp"
+#include "program/config_snapshot.hpp"
+#include "program/frame_arena.hpp"
+#include "program/hook_trace.hpp"
 #include "d3/types/common.hpp"
 #include "d3/_util.hpp"
 #include "symbols/common.hpp"
@@ -10,8 +13,8 @@
 
 namespace d3 {
     namespace {
-        auto IsLocalConfigReady() -> bool {
-            return global_config.initialized;
+        auto IsLocalConfigReady(const PatchConfig &cfg) -> bool {
+            return cfg.initialized;
         }
 
         // Mailbox UI is used by the season swap flow to deliver unequipped items
@@ -23,7 +26,8 @@ namespace d3 {
         // overridden by d3hack.
         HOOK_DEFINE_TRAMPOLINE(MailboxCheckLobbyConnection) {
             static bool Callback(void *self) {
-                if (global_config.initialized && global_config.seasons.active) {
+                const auto &cfg = config_snapshot::Current();
+                if (cfg->initialized && cfg->seasons.active) {
                     return true;
                 }
                 return Orig(self);
@@ -98,19 +102,22 @@ namespace d3 {
             return value ? "1" : "0";
         }
 
-        void AppendConfigLine(std::string &out, const char *key, const char *value) {
+        void AppendConfigLine(frame_arena::String &out, const char *key, const char *value) {
             out += key;
             out += " \"";
             out += value;
             out += "\"\n";
         }
 
-        void AppendConfigBool(std::string &out, const char *key, bool value) {
+        void AppendConfigBool(frame_arena::String &out, const char *key, bool value) {
             AppendConfigLine(out, key, BoolToConfig(value));
         }
 
-        auto BuildConfigSwapString() -> std::string {
-            std::string out;
+        // Caller holds a frame_arena::Scope; the string lives until it closes.
+        auto BuildConfigSwapString(const PatchConfig &cfg) -> frame_arena::String {
+            const auto &events = cfg.events;
+
+            frame_arena::String out;
             out.reserve(1024);
             AppendConfigLine(out, "HeroPublishFrequencyMinutes", "30");
             AppendConfigLine(out, "EnableCrossPlatformSaveMigration", "1");
@@ -118,30 +125,30 @@ namespace d3 {
             AppendConfigLine(out, "EnableDiablo4Advertisement", "1");
             AppendConfigLine(out, "CommunityBuffStart", "???, 16 Sep 2023 00:00:00 GMT");
             AppendConfigLine(out, "CommunityBuffEnd", "???, 01 Dec 2027 01:00:00 GMT");
-            AppendConfigBool(out, "CommunityBuffDoubleGoblins", global_config.events.DoubleTreasureGoblins);
-            AppendConfigBool(out, "CommunityBuffDoubleBountyBags", global_config.events.DoubleBountyBags);
-            AppendConfigBool(out, "CommunityBuffRoyalGrandeur", global_config.events.RoyalGrandeur);
-            AppendConfigBool(out, "CommunityBuffLegacyOfNightmares", global_config.events.LegacyOfNightmares);
-            AppendConfigBool(out, "CommunityBuffTriunesWill", global_config.events.TriunesWill);
-            AppendConfigBool(out, "CommunityBuffPandemonium", global_config.events.Pandemonium);
-            AppendConfigBool(out, "CommunityBuffKanaiPowers", global_config.events.KanaiPowers);
-            AppendConfigBool(out, "CommunityBuffTrialsOfTempests", global_config.events.TrialsOfTempests);
+            AppendConfigBool(out, "CommunityBuffDoubleGoblins", events.DoubleTreasureGoblins);
+            AppendConfigBool(out, "CommunityBuffDoubleBountyBags", events.DoubleBountyBags);
+            AppendConfigBool(out, "CommunityBuffRoyalGrandeur", events.RoyalGrandeur);
+            AppendConfigBool(out, "CommunityBuffLegacyOfNightmares", events.LegacyOfNightmares);
+            AppendConfigBool(out, "CommunityBuffTriunesWill", events.TriunesWill);
+            AppendConfigBool(out, "CommunityBuffPandemonium", events.Pandemonium);
+            AppendConfigBool(out, "CommunityBuffKanaiPowers", events.KanaiPowers);
+            AppendConfigBool(out, "CommunityBuffTrialsOfTempests", events.TrialsOfTempests);
             AppendConfigBool(out, "CommunityBuffSeasonOnly", false);
-            AppendConfigBool(out, "CommunityBuffShadowClones", global_config.events.ShadowClones);
-            AppendConfigBool(out, "CommunityBuffFourthKanaisCubeSlot", global_config.events.FourthKanaisCubeSlot);
-            AppendConfigBool(out, "CommunityBuffEtherealItems", global_config.events.EtherealItems);
-            AppendConfigBool(out, "CommunityBuffSoulShards", global_config.events.SoulShards);
-            AppendConfigBool(out, "CommunityBuffSwarmRifts", global_config.events.SwarmRifts);
-            AppendConfigBool(out, "CommunityBuffSanctifiedItems", global_config.events.SanctifiedItems);
-            AppendConfigBool(out, "CommunityBuffDarkAlchemy", global_config.events.DarkAlchemy);
+            AppendConfigBool(out, "CommunityBuffShadowClones", events.ShadowClones);
+            AppendConfigBool(out, "CommunityBuffFourthKanaisCubeSlot", events.FourthKanaisCubeSlot);
+            AppendConfigBool(out, "CommunityBuffEtherealItems", events.EtherealItems);
+            AppendConfigBool(out, "CommunityBuffSoulShards", events.SoulShards);
+            AppendConfigBool(out, "CommunityBuffSwarmRifts", events.SwarmRifts);
+            AppendConfigBool(out, "CommunityBuffSanctifiedItems", events.SanctifiedItems);
+            AppendConfigBool(out, "CommunityBuffDarkAlchemy", events.DarkAlchemy);
             AppendConfigBool(out, "CommunityBuffParagonCap", false);
-            AppendConfigBool(out, "CommunityBuffNestingPortals", global_config.events.NestingPortals);
+            AppendConfigBool(out, "CommunityBuffNestingPortals", events.NestingPortals);
             AppendConfigLine(out, "CommunityBuffLegendaryFind", "1337420666999.9");
             AppendConfigLine(out, "CommunityBuffGoldFind", "1337420666999.8");
             AppendConfigLine(out, "CommunityBuffXP", "1337420666999.7");
-            AppendConfigBool(out, "CommunityBuffEasterEggWorld", global_config.events.EasterEggWorldEnabled);
-            AppendConfigBool(out, "CommunityBuffDoubleRiftKeystones", global_config.events.DoubleRiftKeystones);
-            AppendConfigBool(out, "CommunityBuffDoubleBloodShards", global_config.events.DoubleBloodShards);
+            AppendConfigBool(out, "CommunityBuffEasterEggWorld", events.EasterEggWorldEnabled);
+            AppendConfigBool(out, "CommunityBuffDoubleRiftKeystones", events.DoubleRiftKeystones);
+            AppendConfigBool(out, "CommunityBuffDoubleBloodShards", events.DoubleBloodShards);
             AppendConfigLine(out, "UpdateVersion", "1");
             return out;
         }
@@ -211,7 +218,7 @@ namespace d3 {
                 return false;
             }
             EnsurePubfileCacheDir();
-            if (WriteTestFile(cache_path, const_cast<char *>(data), size)) {
+            if (WriteFileSync(cache_path, const_cast<char *>(data), size)) {
                 PRINT_LINE(log_line);
                 return true;
             }
@@ -233,21 +240,22 @@ namespace d3 {
             return false;
         }
 
-        void OverrideConfigIfNeeded(blz::shared_ptr<blz::string> *pszFileData) {
-            if (!pszFileData || !global_config.events.active)
+        void OverrideConfigIfNeeded(blz::shared_ptr<blz::string> *pszFileData, const PatchConfig &cfg) {
+            if (!pszFileData || !cfg.events.active)
                 return;
             static blz::string s_fallback;
             EnsureSharedPtrData(pszFileData, s_fallback);
-            auto swap = BuildConfigSwapString();
-            ReplaceBlzString(*pszFileData->m_pointer, swap.c_str());
+            const frame_arena::Scope scratch;
+            const auto               swap = BuildConfigSwapString(cfg);
+            ReplaceBlzString(*pszFileData->m_pointer, swap.data(), swap.size());
         }
 
-        void OverrideSeasonsIfNeeded(blz::shared_ptr<blz::string> *pszFileData) {
-            if (!pszFileData || !global_config.seasons.active)
+        void OverrideSeasonsIfNeeded(blz::shared_ptr<blz::string> *pszFileData, const PatchConfig &cfg) {
+            if (!pszFileData || !cfg.seasons.active)
                 return;
             static blz::string s_fallback;
             EnsureSharedPtrData(pszFileData, s_fallback);
-            auto swap = BuildSeasonSwapString(global_config.seasons.current_season);
+            auto swap = BuildSeasonSwapString(cfg.seasons.current_season);
             ReplaceBlzString(*pszFileData->m_pointer, swap);
         }
 
@@ -266,8 +274,12 @@ namespace d3 {
     }  // namespace
 
     HOOK_DEFINE_TRAMPOLINE(ConfigFileRetrieved) {
+        HOOK_TRACE_CALLBACK("SeasonEventHooks", "OnConfigFileRetrieved");
+
         static void Callback(Console::Online::LobbyServiceInternal *self, int32 eResult, blz::shared_ptr<blz::string> *pszFileData) {
-            if (!IsLocalConfigReady()) {
+            HOOK_TRACE_CALLBACK_SCOPE(self, eResult);
+            const auto &cfg = config_snapshot::Current();
+            if (!IsLocalConfigReady(*cfg)) {
                 ClearConfigRequestFlag();
                 return;
             }
@@ -284,17 +296,21 @@ namespace d3 {
                     result = 0;
                 }
             }
-            if (global_config.events.active) {
+            if (cfg->events.active) {
                 result = 0;
-                OverrideConfigIfNeeded(pszFileData);
+                OverrideConfigIfNeeded(pszFileData, *cfg);
             }
             Orig(self, result, pszFileData);
         }
     };
 
     HOOK_DEFINE_TRAMPOLINE(SeasonsFileRetrieved) {
+        HOOK_TRACE_CALLBACK("SeasonEventHooks", "OnSeasonsFileRetrieved");
+
         static void Callback(Console::Online::LobbyServiceInternal *self, int32 eResult, blz::shared_ptr<blz::string> *pszFileData) {
-            if (!IsLocalConfigReady()) {
+            HOOK_TRACE_CALLBACK_SCOPE(self, eResult);
+            const auto &cfg = config_snapshot::Current();
+            if (!IsLocalConfigReady(*cfg)) {
                 ClearSeasonsRequestFlag();
                 return;
             }
@@ -311,17 +327,21 @@ namespace d3 {
                     result = 0;
                 }
             }
-            if (global_config.seasons.active) {
+            if (cfg->seasons.active) {
                 result = 0;
-                OverrideSeasonsIfNeeded(pszFileData);
+                OverrideSeasonsIfNeeded(pszFileData, *cfg);
             }
             Orig(self, result, pszFileData);
         }
     };
 
     HOOK_DEFINE_TRAMPOLINE(BlacklistFileRetrieved) {
+        HOOK_TRACE_CALLBACK("SeasonEventHooks", "OnBlacklistFileRetrieved");
+
         static void Callback(Console::Online::LobbyServiceInternal *self, int32 eResult, blz::shared_ptr<blz::string> *pszFileData) {
-            if (!IsLocalConfigReady()) {
+            HOOK_TRACE_CALLBACK_SCOPE(self, eResult);
+            const auto &cfg = config_snapshot::Current();
+            if (!IsLocalConfigReady(*cfg)) {
                 ClearBlacklistRequestFlag();
                 return;
             }
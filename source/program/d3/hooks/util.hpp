@@ -1,5 +1,7 @@
 #include "program/config.hpp"
+#include "program/config_snapshot.hpp"
 #include "program/d3/_util.hpp"
+#include "program/d3/dynamic_res.hpp"
 #include "program/d3/patches.hpp"
 #include "program/d3/types/common.hpp"
 #include "program/d3/types/attributes.hpp"
@@ -26,10 +28,11 @@ namespace d3 {
     HOOK_DEFINE_TRAMPOLINE(MoveSpeed) {
         // @ float CPlayerGetMoveSpeedForStickInput(ActorCommonData *tACDPlayer, Player *tPlayer, SNO snoPower, float flMinClientWalkSpeed)
         static auto Callback(ActorCommonData *tACDPlayer, Player *tPlayer, SNO snoPower, float flMinClientWalkSpeed) -> float {
-            auto MoveSpeed = Orig(tACDPlayer, tPlayer, snoPower, flMinClientWalkSpeed);
-            if (!global_config.rare_cheats.active)
+            auto        MoveSpeed = Orig(tACDPlayer, tPlayer, snoPower, flMinClientWalkSpeed);
+            const auto &cfg       = config_snapshot::Current();
+            if (!cfg->rare_cheats.active)
                 return MoveSpeed;
-            const auto mult = static_cast<float>(global_config.rare_cheats.move_speed);
+            const auto mult = static_cast<float>(cfg->rare_cheats.move_speed);
             if (mult <= 0.0f)
                 return MoveSpeed;
             return MoveSpeed * mult;
@@ -39,26 +42,29 @@ namespace d3 {
     HOOK_DEFINE_TRAMPOLINE(EquipAny) {
         //   @ GameError ACDInventoryItemAllowedInSlot(const ActorCommonData *tACDItem, const InventoryLocation *tInvLoc, const BOOL fSkipRequirements, const BOOL fSwapping)
         static auto Callback(const ActorCommonData *tACDItem, const InventoryLocation *tInvLoc, const BOOL fSkipRequirements, const BOOL fSwapping) -> GameError {
-            auto rGameError = Orig(tACDItem, tInvLoc, fSkipRequirements, fSwapping);
-            if (!global_config.rare_cheats.active || !global_config.rare_cheats.equip_any_slot)
+            auto        rGameError = Orig(tACDItem, tInvLoc, fSkipRequirements, fSwapping);
+            const auto &cfg        = config_snapshot::Current();
+            if (!cfg->rare_cheats.active || !cfg->rare_cheats.equip_any_slot)
                 return rGameError;
             return GAMEERROR_NONE;
         }
     };
 
     inline void AugmentSpecifier(LootSpecifier *tSpecifier) {
-        if (global_config.loot_modifiers.ForcedILevel > 0) {
-            tSpecifier->tLooteeParams.nForcedILevel = global_config.loot_modifiers.ForcedILevel;
-        }
-        if (global_config.loot_modifiers.TieredLootRunLevel > 0) {
-            tSpecifier->tLooteeParams.nTieredLootRunLevel = global_config.loot_modifiers.TieredLootRunLevel;
-        }
-        tSpecifier->tLooteeParams.bDisableAncientDrops       = static_cast<BOOL>(global_config.loot_modifiers.DisableAncientDrops);
-        tSpecifier->tLooteeParams.bDisablePrimalAncientDrops = static_cast<BOOL>(global_config.loot_modifiers.DisablePrimalAncientDrops);
-        tSpecifier->tLooteeParams.bDisableTormentDrops       = static_cast<BOOL>(global_config.loot_modifiers.DisableTormentDrops);
-        tSpecifier->tLooteeParams.bDisableTormentCheck       = static_cast<BOOL>(global_config.loot_modifiers.DisableTormentCheck);
-        tSpecifier->tLooteeParams.bSuppressGiftGeneration    = static_cast<BOOL>(global_config.loot_modifiers.SuppressGiftGeneration);
-        tSpecifier->eAncientRank                             = global_config.loot_modifiers.AncientRankValue;
+        const auto &cfg  = config_snapshot::Current();
+        const auto &loot = cfg->loot_modifiers;
+        if (loot.ForcedILevel > 0) {
+            tSpecifier->tLooteeParams.nForcedILevel = loot.ForcedILevel;
+        }
+        if (loot.TieredLootRunLevel > 0) {
+            tSpecifier->tLooteeParams.nTieredLootRunLevel = loot.TieredLootRunLevel;
+        }
+        tSpecifier->tLooteeParams.bDisableAncientDrops       = static_cast<BOOL>(loot.DisableAncientDrops);
+        tSpecifier->tLooteeParams.bDisablePrimalAncientDrops = static_cast<BOOL>(loot.DisablePrimalAncientDrops);
+        tSpecifier->tLooteeParams.bDisableTormentDrops       = static_cast<BOOL>(loot.DisableTormentDrops);
+        tSpecifier->tLooteeParams.bDisableTormentCheck       = static_cast<BOOL>(loot.DisableTormentCheck);
+        tSpecifier->tLooteeParams.bSuppressGiftGeneration    = static_cast<BOOL>(loot.SuppressGiftGeneration);
+        tSpecifier->eAncientRank                             = loot.AncientRankValue;
     }
 
     HOOK_DEFINE_REPLACE(ForceAncient) {
@@ -91,10 +97,17 @@ namespace d3 {
 
     HOOK_DEFINE_INLINE(VarResHook) {
         static void Callback(exl::hook::InlineCtx *ctx) {
-            auto *ptVarRWindow = reinterpret_cast<VariableResRWindowData *>(ctx->X[19]);
-            if (ptVarRWindow != nullptr && global_config.resolution_hack.active) {
-                const float min_pct        = std::clamp(global_config.resolution_hack.min_res_scale, 10.0f, 100.0f);
-                const float max_pct        = std::clamp(global_config.resolution_hack.max_res_scale, min_pct, 100.0f);
+            auto       *ptVarRWindow = reinterpret_cast<VariableResRWindowData *>(ctx->X[19]);
+            const auto &cfg          = config_snapshot::Current();
+            const auto &res          = cfg->resolution_hack;
+            if (ptVarRWindow != nullptr && res.active) {
+                if (float adaptive = 0.0f; dynamic_res::CurrentScale(adaptive)) {
+                    ptVarRWindow->flMinPercent = adaptive;
+                    ptVarRWindow->flMaxPercent = adaptive;
+                    return;
+                }
+                const float min_pct        = std::clamp(res.min_res_scale, 10.0f, 100.0f);
+                const float max_pct        = std::clamp(res.max_res_scale, min_pct, 100.0f);
                 ptVarRWindow->flMinPercent = min_pct * 0.01f;
                 ptVarRWindow->flMaxPercent = max_pct * 0.01f;
             }
@@ -103,7 +116,7 @@ namespace d3 {
 
     HOOK_DEFINE_TRAMPOLINE(SpoofDocked) {
         static auto Callback() -> nn::oe::OperationMode {
-            if (!global_config.resolution_hack.spoof_docked)
+            if (!config_snapshot::Current()->resolution_hack.spoof_docked)
                 return Orig();
             return nn::oe::OperationMode_Docked;
         }
@@ -111,7 +124,7 @@ namespace d3 {
 
     HOOK_DEFINE_TRAMPOLINE(SpoofPerfMode) {
         static auto Callback() -> nn::oe::PerformanceMode {
-            if (!global_config.resolution_hack.spoof_docked)
+            if (!config_snapshot::Current()->resolution_hack.spoof_docked)
                 return Orig();
             return nn::oe::PerformanceMode_Boost;
         }
@@ -3,6 +3,7 @@
 #include "symbols/common.hpp"
 #include "nn/util/util_snprintf.hpp"
 #include "program/build_info.hpp"
+#include "program/log_once.hpp"
 #include "program/logging.hpp"
 #include <cstdio>
 
@@ -46,6 +47,7 @@
 #define PRINT(...) (static_cast<void>(sizeof(__VA_ARGS__)));
 #define PRINT_LINE PRINT
 #define PRINT_EXPR PRINT
+#define PRINT_ONCE(key, ...) (static_cast<void>(sizeof(key)));
 #else
 #define PRINT(fmt, ...)                                      \
     {                                                        \
@@ -59,6 +61,13 @@
                            "[" EXL_MODULE_NAME "]    " #__VA_ARGS__ " = " fmt, \
                            __PRETTY_FUNCTION__, ##__VA_ARGS__);                \
     }  // __PRETTY_FUNCTION__ | __FUNCTION__
+// `key` is a log_once::Key (registered in program/log_once_keys.hpp).
+#define PRINT_ONCE(key, ...)                \
+    {                                       \
+        if (d3::log_once::ShouldLog(key)) { \
+            PRINT(__VA_ARGS__)              \
+        }                                   \
+    }
 
 #endif
 
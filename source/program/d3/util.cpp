@@ -1,9 +1,12 @@
 #include "d3/util.hpp"
 
+#include "d3/gamebalance_index.hpp"
 #include "lib/util/stack_trace.hpp"
 #include "lib/util/strings.hpp"
 #include "lib/util/sys/modules.hpp"
+#include "program/async_writer.hpp"
 #include "program/config.hpp"
+#include "program/config_snapshot.hpp"
 #include "d3/setting.hpp"
 #include "d3/types/sno.hpp"
 
@@ -45,6 +48,10 @@ namespace d3 {
     }
 
     auto GetItemPtr(GBID gbidItem) -> const Item * {
+        if (const Item *ptItem = gamebalance_index::FindItem(gbidItem); ptItem) {
+            return ptItem;
+        }
+        // Index not built yet (or GBID missing from it): walk the game's hash table.
         if (ItemAppGlobals const *ptItemAppGlobals = g_tAppGlobals.ptItemAppGlobals; ptItemAppGlobals) {
             auto  g_mapItems = ptItemAppGlobals->mapItems;
             auto  nHashMask  = g_mapItems.m_map.m_nHashMask;
@@ -63,6 +70,10 @@ namespace d3 {
     }
 
     void AllGBIDsOfType(GameBalanceType eType, std::vector<GBID> &ids) {
+        if (const auto indexed = gamebalance_index::GBIDsOfType(eType); !indexed.empty()) {
+            ids.assign(indexed.begin(), indexed.end());
+            return;
+        }
         GBHandleList listResults = {};
         memset(static_cast<void *>(&listResults), 0, 20);
         listResults.m_list.m_ptNodeAllocator = reinterpret_cast<XListMemoryPool<GBHandle> *>(GBGetHandlePool());
@@ -269,9 +280,10 @@ namespace d3 {
         (void)nn::fs::CreateDirectory(g_szPubfileCacheDir);
     }
 
-    auto WriteTestFile(const std::string &szPath, void *ptBuf, size_type dwSize, bool bSuccess) -> bool {
+    auto WriteFileSync(LPCSTR szPath, void *ptBuf, size_type dwSize) -> bool {
+        bool          bSuccess = false;
         FileReference tFileRef;
-        FileReferenceInit(&tFileRef, szPath.c_str());
+        FileReferenceInit(&tFileRef, szPath);
         FileCreate(&tFileRef);
         if (FileOpen(&tFileRef, 2u) != 0) {
             if (FileWrite(&tFileRef, ptBuf, -1, dwSize, ERROR_FILE_WRITE) != 0)
@@ -281,8 +293,15 @@ namespace d3 {
         return bSuccess;
     }
 
-    auto ReadFileToBuffer(const std::string &szPath, u32 *dwSize, FileReference tFileRef) -> char * {
-        if (FileReferenceInit(&tFileRef, szPath.c_str()); FileExists(&tFileRef) != 0)
+    auto WriteTestFile(LPCSTR szPath, void *ptBuf, size_type dwSize, bool bSuccess) -> bool {
+        // Queued dumps report success once copied; the writer thread owns the SD I/O.
+        if (async_writer::Replace(szPath, ptBuf, dwSize))
+            return true;
+        return WriteFileSync(szPath, ptBuf, dwSize) || bSuccess;
+    }
+
+    auto ReadFileToBuffer(LPCSTR szPath, u32 *dwSize, FileReference tFileRef) -> char * {
+        if (FileReferenceInit(&tFileRef, szPath); FileExists(&tFileRef) != 0)
             if (char *lpBuf = reinterpret_cast<char *>(FileReadIntoMemory(&tFileRef, dwSize, ERROR_FILE_READ)); lpBuf)
                 return lpBuf;
         return nullptr;
@@ -324,7 +343,7 @@ namespace d3 {
     }
 
     auto PopulateChallengeRiftData(D3::ChallengeRifts::ChallengeData &ptChalConf, D3::Leaderboard::WeeklyChallengeData &ptChalData) -> bool {
-        auto PopulateData = [](google::protobuf::MessageLite *dest, const std::string &szPath, u32 dwSize = 0) -> bool {
+        auto PopulateData = [](google::protobuf::MessageLite *dest, LPCSTR szPath, u32 dwSize = 0) -> bool {
             if (char *pFileBuffer = ReadFileToBuffer(szPath, &dwSize); pFileBuffer) {
                 blz::string sFileData;
                 ReplaceBlzString(sFileData, pFileBuffer, dwSize);
@@ -336,8 +355,8 @@ namespace d3 {
         };
 
         auto PopulateDataWithFallback = [&](google::protobuf::MessageLite *dest,
-                                            const std::string             &cache_path,
-                                            const std::string             &local_path,
+                                            LPCSTR                         cache_path,
+                                            LPCSTR                         local_path,
                                             const char                    *cache_log,
                                             const char                    *local_log,
                                             bool                          &used_cache) -> bool {
@@ -350,13 +369,15 @@ namespace d3 {
                 PRINT_LINE(local_log);
                 return true;
             }
-            PRINT("Missing challenge rift file: %s", local_path.c_str());
+            PRINT("Missing challenge rift file: %s", local_path);
             return false;
         };
 
-        const u32 nMin  = global_config.challenge_rifts.range_start;
-        const u32 nMax  = global_config.challenge_rifts.range_end;
-        const u32 nPick = global_config.challenge_rifts.random
+        const auto &cfg   = config_snapshot::Current();
+        const auto &rifts = cfg->challenge_rifts;
+        const u32   nMin  = rifts.range_start;
+        const u32   nMax  = rifts.range_end;
+        const u32   nPick = rifts.random
                               ? static_cast<u32>(GameRandRangeInt(static_cast<int>(nMin), static_cast<int>(nMax)))
                               : nMin;
 
@@ -364,14 +385,16 @@ namespace d3 {
         char           lpBuf[sizeof(szFormat) + 16] {};
         snprintf(lpBuf, sizeof(lpBuf), szFormat, nPick);
 
-        const std::string baseDir  = g_szBaseDir;
-        const std::string cacheDir = g_szPubfileCacheDir;
+        char cache_path[128] {};
+        char local_path[128] {};
+        snprintf(cache_path, sizeof(cache_path), "%s/challengerift_config.dat", g_szPubfileCacheDir);
+        snprintf(local_path, sizeof(local_path), "%s/rift_data/challengerift_config.dat", g_szBaseDir);
 
         bool       config_from_cache = false;
         const auto configOk          = PopulateDataWithFallback(
             &ptChalConf,
-            cacheDir + "/challengerift_config.dat",
-            baseDir + "/rift_data/challengerift_config.dat",
+            cache_path,
+            local_path,
             "[pubfiles] challenge rift config cache hit",
             "[pubfiles] challenge rift config fallback to rift_data",
             config_from_cache
@@ -394,11 +417,14 @@ namespace d3 {
         char local_name[64] {};
         snprintf(local_name, sizeof(local_name), "challengerift_%02u.dat", static_cast<unsigned int>(nPick));
 
+        snprintf(cache_path, sizeof(cache_path), "%s/%s", g_szPubfileCacheDir, cache_name);
+        snprintf(local_path, sizeof(local_path), "%s/rift_data/%s", g_szBaseDir, local_name);
+
         bool       data_from_cache = false;
         const auto dataOk          = PopulateDataWithFallback(
             &ptChalData,
-            cacheDir + "/" + cache_name,
-            baseDir + "/rift_data/" + local_name,
+            cache_path,
+            local_path,
             "[pubfiles] challenge rift data cache hit",
             "[pubfiles] challenge rift data fallback to rift_data",
             data_from_cache
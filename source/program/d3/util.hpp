@@ -40,8 +40,13 @@ namespace d3 {
 
     auto ByteToChar(uchar b) -> char;
 
-    auto WriteTestFile(const std::string &szPath, void *ptBuf, size_type dwSize, bool bSuccess = false) -> bool;
-    auto ReadFileToBuffer(const std::string &szPath, u32 *dwSize, FileReference tFileRef = {}) -> char *;
+    // Write-only dumps: queued on async_writer when it runs, so the file may
+    // not be on SD yet when this returns.
+    auto WriteTestFile(LPCSTR szPath, void *ptBuf, size_type dwSize, bool bSuccess = false) -> bool;
+    // Files that are read back later (pubfile and challenge rift caches): on SD
+    // when this returns true.
+    auto WriteFileSync(LPCSTR szPath, void *ptBuf, size_type dwSize) -> bool;
+    auto ReadFileToBuffer(LPCSTR szPath, u32 *dwSize, FileReference tFileRef = {}) -> char *;
     void ReplaceBlzString(blz::string &dst, const char *data, size_t len);
     auto BlizzStringFromFile(LPCSTR szFilenameSD, u32 dwSize = 0) -> blz::string;
 
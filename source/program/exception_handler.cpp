@@ -3,6 +3,10 @@
 #include "d3/_util.hpp"
 #include "lib/diag/assert.hpp"
 #include "nn/os.hpp"
+#include "program/async_writer.hpp"
+#include "program/binlog.hpp"
+#include "program/crash_capture.hpp"
+#include "program/symbolizer.hpp"
 
 #include <cstdarg>
 #include <cstdio>
@@ -13,6 +17,7 @@ namespace d3 {
         constexpr char   k_user_exception_dump_path[]       = "sd:/config/d3hack-nx/user_exception.txt";
         constexpr size_t k_user_exception_stack_trace_depth = 64;
         constexpr size_t k_dying_message_size               = 0x1000;
+        constexpr s64    k_log_drain_budget_ms              = 200;  // per log stream
 
         alignas(nn::os::HandlerStackAlignment) u8 g_user_exception_stack[0x8000] = {};
         nn::os::UserExceptionInfo g_user_exception_info                          = {};
@@ -111,7 +116,14 @@ namespace d3 {
             const auto offset = address - module->m_Total.m_Start;
             writer->Write("%s: 0x%016llx (", label, static_cast<unsigned long long>(address));
             writer->WriteRaw(name.data(), name.size());
-            writer->Write("+0x%llx)\n", static_cast<unsigned long long>(offset));
+            writer->Write("+0x%llx)", static_cast<unsigned long long>(offset));
+            char         symbol[192];
+            const size_t symbol_len = symbolizer::Format(address, symbol, sizeof(symbol));
+            if (symbol_len != 0) {
+                writer->WriteRaw(" ", 1);
+                writer->WriteRaw(symbol, symbol_len);
+            }
+            writer->WriteRaw("\n", 1);
         }
 
         void WriteRegisterDump(FileWriter *writer, const nn::os::UserExceptionInfoDetail &detail) {
@@ -346,7 +358,19 @@ namespace d3 {
             FileClose(&tFileRef);
         }
 
+        // Buffered log lines are what explains the crash; get them onto SD
+        // before either dump. Bounded and try-lock only, so a fault inside the
+        // logger costs at most the budget.
+        void DrainLogsForCrash() {
+            (void)binlog::DrainForCrash(k_log_drain_budget_ms);
+            (void)async_writer::DrainForCrash(k_log_drain_budget_ms);
+        }
+
         void UserExceptionHandler(nn::os::UserExceptionInfo *info) {
+            DrainLogsForCrash();
+            // Binary capture first: one write, so it survives even if the text
+            // dump below faults or hangs in the game's file layer.
+            (void)crash_capture::Write(info);
             UserExceptionDump(info);
             EXL_ABORT("UserExceptionHandler invoked");
         }
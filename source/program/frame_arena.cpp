@@ -0,0 +1,231 @@
+#include "program/frame_arena.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include "lib/nx/result.h"
+#include "nn/os.hpp"  // IWYU pragma: keep
+#include "program/d3/setting.hpp"
+#include "program/system_allocator.hpp"
+
+namespace d3::frame_arena {
+    namespace {
+        struct Block {
+            Block *next;
+            size_t capacity;  // usable bytes after the header
+
+            auto Data() -> char * { return reinterpret_cast<char *>(this + 1); }
+        };
+        static_assert(sizeof(Block) % alignof(std::max_align_t) == 0);
+
+        // Owned by one thread; only that thread ever touches it.
+        struct Arena {
+            Block *chunks   = nullptr;  // standard chunks, reused in order every frame
+            Block *current  = nullptr;
+            size_t offset   = 0;        // bump cursor inside current
+            Block *oversize = nullptr;  // freed at the next rewind
+            u32    depth    = 0;        // open Scopes
+            u64    epoch    = 0;        // frame of the last rewind
+        };
+
+        nn::os::TlsSlot   g_slot {};
+        std::atomic<bool> g_ready {false};
+        std::atomic<u64>  g_epoch {1};
+
+        static auto AlignUp(uintptr_t value, size_t alignment) -> uintptr_t {
+            return (value + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        }
+
+        static auto NewBlock(size_t capacity) -> Block * {
+            auto *allocator = system_allocator::GetSystemAllocator();
+            if (allocator == nullptr) {
+                return nullptr;
+            }
+            void *memory = allocator->Allocate(sizeof(Block) + capacity);
+            if (memory == nullptr) {
+                return nullptr;
+            }
+            return new (memory) Block {nullptr, capacity};
+        }
+
+        static void FreeList(Block *block) {
+            auto *allocator = system_allocator::GetSystemAllocator();
+            while (block != nullptr) {
+                Block *next = block->next;
+                allocator->Free(block);
+                block = next;
+            }
+        }
+
+        static void Rewind(Arena &arena) {
+            FreeList(arena.oversize);
+            arena.oversize = nullptr;
+            arena.current  = arena.chunks;
+            arena.offset   = 0;
+        }
+
+        static auto InList(const Block *block, const void *ptr) -> bool {
+            const auto *p = static_cast<const char *>(ptr);
+            for (; block != nullptr; block = block->next) {
+                const auto *data = reinterpret_cast<const char *>(block + 1);
+                if (p >= data && p < data + block->capacity) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void DestroyArena(uintptr_t value) {
+            auto *arena = reinterpret_cast<Arena *>(value);
+            if (arena == nullptr) {
+                return;
+            }
+            FreeList(arena->chunks);
+            FreeList(arena->oversize);
+            arena->~Arena();
+            system_allocator::GetSystemAllocator()->Free(arena);
+        }
+
+        static auto CurrentArena() -> Arena * {
+            if (!g_ready.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+            return reinterpret_cast<Arena *>(nn::os::GetTlsValue(g_slot));
+        }
+
+        static auto AcquireArena() -> Arena * {
+            if (Arena *arena = CurrentArena(); arena != nullptr || !g_ready.load(std::memory_order_relaxed)) {
+                return arena;
+            }
+            auto *allocator = system_allocator::GetSystemAllocator();
+            void *memory    = allocator != nullptr ? allocator->Allocate(sizeof(Arena)) : nullptr;
+            if (memory == nullptr) {
+                return nullptr;
+            }
+            auto *arena = new (memory) Arena();
+            nn::os::SetTlsValue(g_slot, reinterpret_cast<uintptr_t>(arena));
+            return arena;
+        }
+
+        static auto BumpFrom(Arena &arena, size_t size, size_t alignment) -> void * {
+            while (arena.current != nullptr) {
+                const uintptr_t base  = reinterpret_cast<uintptr_t>(arena.current->Data());
+                const uintptr_t start = AlignUp(base + arena.offset, alignment);
+                if (start + size <= base + arena.current->capacity) {
+                    arena.offset = start + size - base;
+                    return reinterpret_cast<void *>(start);
+                }
+                // Leave the tail; the next chunk (kept from earlier frames) may fit.
+                if (arena.current->next == nullptr) {
+                    break;
+                }
+                arena.current = arena.current->next;
+                arena.offset  = 0;
+            }
+
+            Block *block = NewBlock(kChunkBytes);
+            if (block == nullptr) {
+                return nullptr;
+            }
+            if (arena.current == nullptr) {
+                arena.chunks = block;
+            } else {
+                arena.current->next = block;
+            }
+            arena.current = block;
+            arena.offset  = 0;
+            return BumpFrom(arena, size, alignment);
+        }
+    }  // namespace
+
+    auto Initialize() -> bool {
+        if (g_ready.load(std::memory_order_relaxed)) {
+            return true;
+        }
+        const Result rc = nn::os::AllocateTlsSlot(&g_slot, &DestroyArena);
+        if (R_FAILED(rc)) {
+            PRINT("[frame_arena] TLS slot allocation failed (rc=0x%x); scratch memory unavailable", rc)
+            return false;
+        }
+        g_ready.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void OnPresent() {
+        g_epoch.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Scope::Scope() {
+        Arena *arena = AcquireArena();
+        if (arena == nullptr) {
+            return;
+        }
+        if (arena->depth++ == 0) {
+            const u64 epoch = g_epoch.load(std::memory_order_relaxed);
+            if (arena->epoch != epoch) {
+                Rewind(*arena);
+                arena->epoch = epoch;
+            }
+        }
+    }
+
+    Scope::~Scope() {
+        if (Arena *arena = CurrentArena(); arena != nullptr && arena->depth > 0) {
+            --arena->depth;
+        }
+    }
+
+    auto Allocate(size_t size, size_t alignment) -> void * {
+        Arena *arena = CurrentArena();
+        if (arena == nullptr || arena->depth == 0) {
+            return nullptr;
+        }
+        alignment = std::max<size_t>(alignment, 1);
+        size      = std::max<size_t>(size, 1);
+
+        if (size + alignment > kOversizeBytes) {
+            Block *block = NewBlock(size + alignment);
+            if (block == nullptr) {
+                return nullptr;
+            }
+            block->next     = arena->oversize;
+            arena->oversize = block;
+            return reinterpret_cast<void *>(AlignUp(reinterpret_cast<uintptr_t>(block->Data()), alignment));
+        }
+        return BumpFrom(*arena, size, alignment);
+    }
+
+    void Free(void *ptr, size_t size) {
+        Arena *arena = CurrentArena();
+        if (arena == nullptr || arena->current == nullptr || ptr == nullptr) {
+            return;
+        }
+        char *data = arena->current->Data();
+        char *end  = static_cast<char *>(ptr) + size;
+        if (static_cast<char *>(ptr) >= data && end == data + arena->offset) {
+            arena->offset = static_cast<size_t>(static_cast<char *>(ptr) - data);
+        }
+    }
+
+    auto AllocateOrHeap(size_t size, size_t alignment) -> void * {
+        if (void *ptr = Allocate(size, alignment); ptr != nullptr) {
+            return ptr;
+        }
+        return ::operator new(size, std::align_val_t {alignment});
+    }
+
+    void Release(void *ptr, size_t size, size_t alignment) {
+        if (ptr == nullptr) {
+            return;
+        }
+        const Arena *arena = CurrentArena();
+        if (arena != nullptr && (InList(arena->chunks, ptr) || InList(arena->oversize, ptr))) {
+            Free(ptr, size);
+            return;
+        }
+        // Served by the fallback in AllocateOrHeap.
+        ::operator delete(ptr, size, std::align_val_t {alignment});
+    }
+
+}  // namespace d3::frame_arena
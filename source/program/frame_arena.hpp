@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "types.h"
+
+namespace d3::frame_arena {
+
+    // Per-thread bump arena for transient hook and overlay work (paths, small
+    // strings, scratch buffers), so it stays off the game's general heap.
+    // Chunks come from the system allocator (program/system_allocator.hpp) and
+    // are kept across frames; only oversized blocks are returned.
+    //
+    // Lifetime: memory is valid for the rest of the current frame. Each present
+    // advances the frame epoch, and a thread's arena rewinds the next time that
+    // thread opens an outermost Scope in a later frame, never while a Scope is
+    // open. Allocating requires an open Scope on the calling thread.
+    //
+    // Footprint: a thread that opens a Scope keeps its chunks (kChunkBytes each,
+    // usually one) until it exits. Only open Scopes on threads that build
+    // strings repeatedly; one-off work is cheaper on the stack.
+    constexpr size_t kChunkBytes    = 4 * 1024;
+    constexpr size_t kOversizeBytes = kChunkBytes / 2;  // larger requests get their own block
+
+    // Allocates the TLS slot. Call once at boot before any Scope is opened.
+    auto Initialize() -> bool;
+
+    // Present thread, once per frame.
+    void OnPresent();
+
+    class Scope {
+       public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope &)            = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+
+    // Returns nullptr when the system allocator is out of memory or there is
+    // no open Scope on this thread.
+    auto Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) -> void *;
+
+    // Gives the block back only if it is the most recent allocation (lets a
+    // growing string reuse its tail); otherwise the frame reset reclaims it.
+    void Free(void *ptr, size_t size);
+
+    // Allocate, falling back to operator new when the arena cannot serve the
+    // request; Release tells the two apart and frees accordingly.
+    auto AllocateOrHeap(size_t size, size_t alignment) -> void *;
+    void Release(void *ptr, size_t size, size_t alignment);
+
+    // STL adaptor. Stateless: every instance draws from the calling thread's
+    // arena, so containers must not outlive the Scope (or the frame) they were
+    // filled in, nor be grown from another thread. Without an open Scope (or
+    // with the system allocator exhausted) it behaves like std::allocator.
+    template<typename T>
+    struct Allocator {
+        using value_type = T;
+
+        Allocator() = default;
+        template<typename U>
+        constexpr Allocator(const Allocator<U> &) noexcept {}
+
+        auto allocate(size_t count) -> T * { return static_cast<T *>(AllocateOrHeap(count * sizeof(T), alignof(T))); }
+
+        void deallocate(T *ptr, size_t count) noexcept { Release(ptr, count * sizeof(T), alignof(T)); }
+
+        template<typename U>
+        constexpr auto operator==(const Allocator<U> &) const noexcept -> bool { return true; }
+    };
+
+    using String = std::basic_string<char, std::char_traits<char>, Allocator<char>>;
+    template<typename T>
+    using Vector = std::vector<T, Allocator<T>>;
+
+}  // namespace d3::frame_arena
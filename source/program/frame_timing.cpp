@@ -0,0 +1,173 @@
+#include "program/frame_timing.hpp"
+
+#include "d3/util_globals.hpp"
+#include "nn/os.hpp"
+#include "program/fs_util.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdio>
+
+namespace d3::frame_timing {
+    namespace {
+        static_assert(std::has_single_bit(kCapacity));
+
+        struct Slot {
+            std::atomic<u32> frame_us {0};
+            std::atomic<u32> overlay_us {0};
+            std::atomic<u32> res_bits {0};
+            std::atomic<u32> work_us {0};
+        };
+
+        std::array<Slot, kCapacity> g_ring {};
+        std::atomic<u64>            g_head {0};
+        u64                         g_last_present_tick = 0;
+        s64                         g_tick_freq         = 0;
+
+        static auto NowTick() -> u64 {
+            return static_cast<u64>(nn::os::GetSystemTick().GetInt64Value());
+        }
+
+        static auto CurrentResScale() -> float {
+            const auto *rwindow  = g_ptMainRWindow;
+            const auto *var_data = (rwindow != nullptr) ? rwindow->m_ptVariableResRWindowData : nullptr;
+            return (var_data != nullptr) ? var_data->flPercent : 0.0f;
+        }
+
+        static auto Percentile(std::array<u32, kCapacity> &values, size_t count, u32 pct) -> u32 {
+            if (count == 0) {
+                return 0;
+            }
+            const size_t idx = std::min(count - 1, (count * pct) / 100u);
+            std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(idx), values.begin() + static_cast<std::ptrdiff_t>(count));
+            return values[idx];
+        }
+    }  // namespace
+
+    auto TicksToUs(u64 ticks) -> u32 {
+        if (g_tick_freq <= 0) {
+            g_tick_freq = nn::os::GetSystemTickFrequency();
+            if (g_tick_freq <= 0) {
+                return 0;
+            }
+        }
+        const u64 us = (ticks * 1000000ull) / static_cast<u64>(g_tick_freq);
+        return static_cast<u32>(std::min<u64>(us, 0xFFFFFFFFull));
+    }
+
+    auto BeginPresent() -> u64 {
+        return NowTick();
+    }
+
+    void EndPresent(u64 begin_tick) {
+        const u64 end_tick = NowTick();
+        const u64 prev     = g_last_present_tick;
+
+        g_last_present_tick = begin_tick;
+        if (prev == 0 || begin_tick <= prev) {
+            return;  // First frame (or tick wrap): no interval yet.
+        }
+
+        const u64 head = g_head.load(std::memory_order_relaxed);
+        Slot     &slot = g_ring[head & (kCapacity - 1)];
+        slot.frame_us.store(TicksToUs(begin_tick - prev), std::memory_order_relaxed);
+        slot.overlay_us.store(TicksToUs(end_tick - begin_tick), std::memory_order_relaxed);
+        slot.res_bits.store(std::bit_cast<u32>(CurrentResScale()), std::memory_order_relaxed);
+        slot.work_us.store(0, std::memory_order_relaxed);
+        g_head.store(head + 1, std::memory_order_release);
+    }
+
+    void RecordWork(u64 index, u32 work_us) {
+        // Late fences for slots the ring already reused are dropped.
+        if (g_head.load(std::memory_order_acquire) - index > kCapacity) {
+            return;
+        }
+        g_ring[index & (kCapacity - 1)].work_us.store(std::max<u32>(work_us, 1), std::memory_order_relaxed);
+    }
+
+    auto PresentCount() -> u64 {
+        return g_head.load(std::memory_order_acquire);
+    }
+
+    auto CopyRecent(Sample *out, size_t max) -> size_t {
+        if (out == nullptr || max == 0) {
+            return 0;
+        }
+        const u64    head  = g_head.load(std::memory_order_acquire);
+        const size_t count = static_cast<size_t>(std::min<u64>({head, static_cast<u64>(max), static_cast<u64>(kCapacity)}));
+        const u64    first = head - count;
+        for (size_t i = 0; i < count; ++i) {
+            const Slot &slot  = g_ring[(first + i) & (kCapacity - 1)];
+            out[i].frame_us   = slot.frame_us.load(std::memory_order_relaxed);
+            out[i].overlay_us = slot.overlay_us.load(std::memory_order_relaxed);
+            out[i].res_scale  = std::bit_cast<float>(slot.res_bits.load(std::memory_order_relaxed));
+            out[i].work_us    = slot.work_us.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    auto ComputeStats(Stats &out, size_t window) -> bool {
+        out = {};
+
+        std::array<Sample, kCapacity> samples {};
+        const size_t                  count = CopyRecent(samples.data(), std::min(window, kCapacity));
+        if (count == 0) {
+            return false;
+        }
+
+        std::array<u32, kCapacity> frame_us {};
+        std::array<u32, kCapacity> work_us {};
+        size_t                     work_count  = 0;
+        u64                        frame_sum   = 0;
+        u64                        overlay_sum = 0;
+        u32                        overlay_max = 0;
+        for (size_t i = 0; i < count; ++i) {
+            frame_us[i] = samples[i].frame_us;
+            frame_sum += samples[i].frame_us;
+            overlay_sum += samples[i].overlay_us;
+            overlay_max = std::max(overlay_max, samples[i].overlay_us);
+            if (samples[i].work_us != 0) {
+                work_us[work_count++] = samples[i].work_us;
+            }
+        }
+
+        const auto to_ms = [](u64 us) -> float { return static_cast<float>(us) * 0.001f; };
+
+        out.samples        = static_cast<u32>(count);
+        out.avg_ms         = to_ms(frame_sum / count);
+        out.max_ms         = to_ms(*std::max_element(frame_us.begin(), frame_us.begin() + static_cast<std::ptrdiff_t>(count)));
+        out.p50_ms         = to_ms(Percentile(frame_us, count, 50));
+        out.p90_ms         = to_ms(Percentile(frame_us, count, 90));
+        out.p99_ms         = to_ms(Percentile(frame_us, count, 99));
+        out.overlay_avg_ms = to_ms(overlay_sum / count);
+        out.overlay_max_ms = to_ms(overlay_max);
+        out.res_scale      = samples[count - 1].res_scale;
+        out.work_samples   = static_cast<u32>(work_count);
+        out.work_p90_ms    = to_ms(Percentile(work_us, work_count, 90));
+        return true;
+    }
+
+    auto DumpCsv(const char *path, std::string &error_out) -> bool {
+        std::array<Sample, kCapacity> samples {};
+        const size_t                  count = CopyRecent(samples.data(), samples.size());
+        if (count == 0) {
+            error_out = "no samples recorded";
+            return false;
+        }
+
+        std::string text;
+        text.reserve(40 + count * 32);
+        text += "frame_us,overlay_us,res_scale,work_us\n";
+        char line[64];
+        for (size_t i = 0; i < count; ++i) {
+            const int n = std::snprintf(line, sizeof(line), "%u,%u,%.3f,%u\n", samples[i].frame_us, samples[i].overlay_us, samples[i].res_scale, samples[i].work_us);
+            if (n > 0) {
+                text.append(line, static_cast<size_t>(std::min<int>(n, sizeof(line) - 1)));
+            }
+        }
+        return fs_util::WriteAllAtomic(path, text, "frame trace", error_out);
+    }
+
+}  // namespace d3::frame_timing
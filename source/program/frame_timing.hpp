@@ -0,0 +1,60 @@
+#pragma once
+
+#include "types.h"
+
+#include <cstddef>
+#include <string>
+
+namespace d3::frame_timing {
+
+    // Per-present timing ring, written from the NVN present interception.
+    // Recording is two tick reads and one slot store per frame; all aggregation
+    // happens on the read side so the cost when no HUD/consumer runs is ~zero.
+    constexpr size_t kCapacity = 256;  // power of two
+
+    struct Sample {
+        u32   frame_us   = 0;     // present-to-present interval
+        u32   overlay_us = 0;     // CPU time spent in the overlay present callback
+        float res_scale  = 0.0f;  // dynamic-resolution percent at present time (0 when unknown)
+        u32   work_us    = 0;     // first submit to GPU fence, vsync wait excluded (0 until the fence lands)
+    };
+
+    struct Stats {
+        u32   samples        = 0;
+        float avg_ms         = 0.0f;
+        float p50_ms         = 0.0f;
+        float p90_ms         = 0.0f;
+        float p99_ms         = 0.0f;
+        float max_ms         = 0.0f;
+        float overlay_avg_ms = 0.0f;
+        float overlay_max_ms = 0.0f;
+        float res_scale      = 0.0f;
+        u32   work_samples   = 0;  // samples whose GPU fence has landed
+        float work_p90_ms    = 0.0f;
+    };
+
+    // Present thread only.
+    auto BeginPresent() -> u64;
+    void EndPresent(u64 begin_tick);
+
+    // Total presents recorded since boot (monotonic; the ring holds the last kCapacity).
+    auto PresentCount() -> u64;
+
+    // Fills in work_us for the sample at `index` (PresentCount() - 1 when its
+    // fence was queued). Called by the GPU fence waiter once the fence lands.
+    void RecordWork(u64 index, u32 work_us);
+
+    // Copies up to `max` most recent samples, oldest first. Returns the number copied.
+    auto CopyRecent(Sample *out, size_t max) -> size_t;
+
+    // Aggregates the most recent `window` samples (clamped to kCapacity).
+    auto ComputeStats(Stats &out, size_t window = kCapacity) -> bool;
+
+    auto TicksToUs(u64 ticks) -> u32;
+
+    // Writes the ring as "frame_us,overlay_us,res_scale,work_us" CSV (oldest
+    // first) for replay in tools/dynres_sim.
+    constexpr const char *kTracePath = "sd:/config/d3hack-nx/frame_trace.csv";
+    auto DumpCsv(const char *path, std::string &error_out) -> bool;
+
+}  // namespace d3::frame_timing
@@ -0,0 +1,134 @@
+#include "program/gui2/backend/gpu_fence.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+#include "lib/nx/result.h"
+#include "nn/os.hpp"  // IWYU pragma: keep
+#include "program/d3/setting.hpp"
+#include "program/frame_timing.hpp"
+#include "types.h"
+
+namespace d3::gui2::backend::gpu_fence {
+    namespace {
+        constexpr size_t kStackSize     = 0x2000;
+        constexpr u64    kWaitTimeoutNs = 100'000'000;
+
+        struct Fence {
+            NVNsync sync {};
+            u64     index       = 0;  // frame_timing sample the fence belongs to
+            u64     submit_tick = 0;  // first submit of that frame
+        };
+
+        PFNNVNQUEUEFENCESYNCPROC g_fence_sync = nullptr;
+        PFNNVNSYNCWAITPROC       g_sync_wait  = nullptr;
+
+        // Present thread queues fences at g_queued; the waiter retires them in
+        // order at g_retired. A slot is reused only after it was retired.
+        std::array<Fence, kMaxFences> g_fences {};
+        std::atomic<u64>              g_queued {0};
+        std::atomic<u64>              g_retired {0};
+        std::atomic<u64>              g_first_submit {0};  // 0 until the current frame submits
+        std::atomic<bool>             g_ready {false};
+        bool                          g_init_tried = false;
+        nn::os::EventType             g_wake {};
+        nn::os::ThreadType            g_thread {};
+
+        alignas(0x1000) std::array<u8, kStackSize> g_stack {};
+
+        static auto NowTick() -> u64 {
+            return static_cast<u64>(nn::os::GetSystemTick().GetInt64Value());
+        }
+
+        static void WaiterMain(void *) {
+            u64 prev_done = 0;
+            for (;;) {
+                const u64 n = g_retired.load(std::memory_order_relaxed);
+                if (n == g_queued.load(std::memory_order_acquire)) {
+                    nn::os::WaitEvent(&g_wake);
+                    continue;
+                }
+                Fence     &fence  = g_fences[n % kMaxFences];
+                const auto result = g_sync_wait(&fence.sync, kWaitTimeoutNs);
+                const u64  done   = NowTick();
+                if (result == NVN_SYNC_WAIT_RESULT_TIMEOUT_EXPIRED) {
+                    continue;  // GPU still busy (or the present has not flushed yet)
+                }
+                // Only a wait that actually blocked gives a usable completion
+                // time; an already-signalled fence means we woke up late.
+                if (result == NVN_SYNC_WAIT_RESULT_CONDITION_SATISFIED) {
+                    const u64 start = std::max(fence.submit_tick, prev_done);
+                    if (done > start) {
+                        frame_timing::RecordWork(fence.index, frame_timing::TicksToUs(done - start));
+                    }
+                }
+                prev_done = done;
+                g_retired.store(n + 1, std::memory_order_release);
+            }
+        }
+
+        static auto Initialize(NVNdevice *device, PFNNVNDEVICEGETPROCADDRESSPROC get_proc) -> bool {
+            const auto sync_initialize = reinterpret_cast<PFNNVNSYNCINITIALIZEPROC>(get_proc(device, "nvnSyncInitialize"));
+            g_fence_sync               = reinterpret_cast<PFNNVNQUEUEFENCESYNCPROC>(get_proc(device, "nvnQueueFenceSync"));
+            g_sync_wait                = reinterpret_cast<PFNNVNSYNCWAITPROC>(get_proc(device, "nvnSyncWait"));
+            if (sync_initialize == nullptr || g_fence_sync == nullptr || g_sync_wait == nullptr) {
+                PRINT_LINE("[gpu_fence] sync entry points missing; adaptive resolution follows the present interval");
+                return false;
+            }
+            for (auto &fence : g_fences) {
+                if (sync_initialize(&fence.sync, device) == 0) {
+                    PRINT_LINE("[gpu_fence] nvnSyncInitialize failed; adaptive resolution follows the present interval");
+                    return false;
+                }
+            }
+
+            nn::os::InitializeEvent(&g_wake, false, nn::os::EventClearMode_AutoClear);
+            // Highest priority: it only ever blocks, and the completion tick is
+            // taken right after the wait returns.
+            const Result rc = nn::os::CreateThread(&g_thread, WaiterMain, nullptr, g_stack.data(), g_stack.size(), nn::os::HighestThreadPriority);
+            if (R_FAILED(rc)) {
+                PRINT("[gpu_fence] waiter thread not started (rc=0x%x); adaptive resolution follows the present interval", rc)
+                return false;
+            }
+            nn::os::SetThreadNamePointer(&g_thread, "d3hack.gpu_fence");
+            nn::os::StartThread(&g_thread);
+            return true;
+        }
+    }  // namespace
+
+    void OnSubmit() {
+        u64 expected = 0;
+        (void)g_first_submit.compare_exchange_strong(expected, NowTick(), std::memory_order_relaxed);
+    }
+
+    void OnPresent(NVNdevice *device, NVNqueue *queue, PFNNVNDEVICEGETPROCADDRESSPROC get_proc) {
+        if (!g_ready.load(std::memory_order_relaxed)) {
+            if (g_init_tried || device == nullptr || get_proc == nullptr) {
+                return;
+            }
+            g_init_tried = true;
+            if (!Initialize(device, get_proc)) {
+                return;
+            }
+            g_ready.store(true, std::memory_order_relaxed);
+        }
+
+        const u64 submit   = g_first_submit.exchange(0, std::memory_order_relaxed);
+        const u64 presents = frame_timing::PresentCount();
+        if (queue == nullptr || submit == 0 || presents == 0) {
+            return;
+        }
+        const u64 queued = g_queued.load(std::memory_order_relaxed);
+        if (queued - g_retired.load(std::memory_order_acquire) >= kMaxFences) {
+            return;  // waiter still owns every sync; this frame goes unmeasured
+        }
+        Fence &fence      = g_fences[queued % kMaxFences];
+        fence.index       = presents - 1;
+        fence.submit_tick = submit;
+        g_fence_sync(queue, &fence.sync, NVN_SYNC_CONDITION_ALL_GPU_COMMANDS_COMPLETE, 0);
+        g_queued.store(queued + 1, std::memory_order_release);
+        nn::os::SignalEvent(&g_wake);
+    }
+
+}  // namespace d3::gui2::backend::gpu_fence
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <nvn/nvn.h>
+
+namespace d3::gui2::backend::gpu_fence {
+
+    // Per-frame work time for the adaptive resolution controller: from the
+    // frame's first queue submit (or the previous frame's fence, if the GPU
+    // was still busy) until the GPU signals a fence queued at present. Unlike
+    // the present-to-present interval this does not snap to vsync multiples,
+    // so the controller can see headroom while the game runs at a locked rate.
+    // A waiter thread blocks on each fence and stores the result with
+    // frame_timing::RecordWork.
+    constexpr int kMaxFences = 4;  // frames the GPU may run behind before we skip one
+
+    // Called from the nvnQueueSubmitCommands interposer.
+    void OnSubmit();
+
+    // Present thread, right before the real present (which flushes the fence).
+    // Resolves the sync entry points and starts the waiter on first use.
+    void OnPresent(NVNdevice *device, NVNqueue *queue, PFNNVNDEVICEGETPROCADDRESSPROC get_proc);
+
+}  // namespace d3::gui2::backend::gpu_fence
@@ -6,7 +6,14 @@
 #include <cstring>
 
 #include "lib/hook/trampoline.hpp"
+#include "program/config_snapshot.hpp"
+#include "program/gui2/backend/gpu_fence.hpp"
+#include "program/d3/dynamic_res.hpp"
 #include "program/d3/setting.hpp"
+#include "program/frame_arena.hpp"
+#include "program/frame_timing.hpp"
+#include "program/log_once.hpp"
+#include "program/sampling_profiler.hpp"
 
 // Pull in only the C NVN API (avoid the NVN C++ funcptr shim headers which declare
 // a conflicting `nvnBootstrapLoader` symbol).
@@ -22,6 +29,7 @@ namespace d3::gui2::backend::nvn_hooks {
     namespace {
         using NvnDeviceGetProcAddressFn     = PFNNVNDEVICEGETPROCADDRESSPROC;
         using NvnQueuePresentTextureFn      = PFNNVNQUEUEPRESENTTEXTUREPROC;
+        using NvnQueueSubmitCommandsFn      = PFNNVNQUEUESUBMITCOMMANDSPROC;
         using NvnCommandBufferInitializeFn  = PFNNVNCOMMANDBUFFERINITIALIZEPROC;
         using NvnWindowBuilderSetTexturesFn = PFNNVNWINDOWBUILDERSETTEXTURESPROC;
         using NvnWindowSetCropFn            = PFNNVNWINDOWSETCROPPROC;
@@ -30,6 +38,7 @@ namespace d3::gui2::backend::nvn_hooks {
 
         NvnDeviceGetProcAddressFn    g_orig_get_proc           = nullptr;
         NvnQueuePresentTextureFn     g_orig_present            = nullptr;
+        NvnQueueSubmitCommandsFn     g_orig_queue_submit       = nullptr;
         NvnCommandBufferInitializeFn g_orig_cmd_buf_initialize = nullptr;
         NVNdevice                   *g_device                  = nullptr;
         NVNqueue                    *g_queue                   = nullptr;
@@ -83,6 +92,11 @@ namespace d3::gui2::backend::nvn_hooks {
             return g_orig_cmd_buf_initialize(buffer, device);
         }
 
+        static void QueueSubmitCommandsWrapper(NVNqueue *queue, int num_commands, const NVNcommandHandle *handles) {
+            gpu_fence::OnSubmit();
+            g_orig_queue_submit(queue, num_commands, handles);
+        }
+
         static void QueuePresentTextureWrapper(NVNqueue *queue, NVNwindow *window, int texture_index) {
             static bool s_logged_present = false;
             if (!s_logged_present) {
@@ -94,9 +108,17 @@ namespace d3::gui2::backend::nvn_hooks {
                 g_queue = queue;
             }
 
+            const u64 present_tick = d3::frame_timing::BeginPresent();
             if (g_on_present != nullptr) {
                 g_on_present(queue, window, texture_index);
             }
+            d3::frame_timing::EndPresent(present_tick);
+            d3::dynamic_res::OnPresent();
+            d3::config_snapshot::OnPresent();
+            d3::frame_arena::OnPresent();
+            d3::log_once::PumpSummaries();
+            d3::sampling_profiler::OnPresent();
+            gpu_fence::OnPresent(g_device, queue, g_orig_get_proc);
 
             if (g_orig_present != nullptr) {
                 g_orig_present(queue, window, texture_index);
@@ -135,6 +157,11 @@ namespace d3::gui2::backend::nvn_hooks {
                     return reinterpret_cast<PFNNVNGENERICFUNCPTRPROC>(&WindowSetCropHook);
                 }
 
+                if (std::strcmp(name, "nvnQueueSubmitCommands") == 0) {
+                    g_orig_queue_submit = reinterpret_cast<NvnQueueSubmitCommandsFn>(fn);
+                    return reinterpret_cast<PFNNVNGENERICFUNCPTRPROC>(&QueueSubmitCommandsWrapper);
+                }
+
                 if (std::strcmp(name, "nvnQueuePresentTexture") == 0) {
                     g_orig_present = reinterpret_cast<NvnQueuePresentTextureFn>(fn);
                     return reinterpret_cast<PFNNVNGENERICFUNCPTRPROC>(&QueuePresentTextureWrapper);
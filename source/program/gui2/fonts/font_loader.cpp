@@ -4,6 +4,7 @@
 #include <cstddef>
 
 #include "program/d3/setting.hpp"
+#include "program/gui2/fonts/glyph_cache.hpp"
 #include "program/gui2/imgui_glyph_ranges.hpp"
 #include "program/gui2/ui/overlay.hpp"
 
@@ -43,8 +44,53 @@ namespace d3::gui2::fonts::font_loader {
         bool    g_font_build_in_progress = false;
         ImFont *g_font_body              = nullptr;
         ImFont *g_font_title             = nullptr;
+        int     g_last_compact_frame     = 0;
+
+        // Alpha8 atlas: 4 MiB is 2048x2048, enough for the UI strings of any language
+        // plus a few baked sizes; the texture only exceeds it with heavy CJK use.
+        constexpr size_t kAtlasBudgetBytes         = 4u * 1024u * 1024u;
+        constexpr int    kCompactMinIntervalFrames = 600;
+
+        static auto DynamicGlyphsEnabled(const ImGuiIO &io) -> bool {
+            return (io.BackendFlags & ImGuiBackendFlags_RendererHasTextures) != 0;
+        }
     }  // namespace
 
+    void MaintainAtlas() {
+        if (!g_font_atlas_built) {
+            return;
+        }
+        ImGuiIO &io = ImGui::GetIO();
+        if (io.Fonts == nullptr || !DynamicGlyphsEnabled(io)) {
+            return;
+        }
+        const ImTextureData *tex = io.Fonts->TexData;
+        if (tex == nullptr || tex->Status != ImTextureStatus_OK) {
+            return;
+        }
+        const int frame = ImGui::GetFrameCount();
+        if (frame - g_last_compact_frame < kCompactMinIntervalFrames) {
+            return;
+        }
+        const size_t bytes = static_cast<size_t>(tex->Width) * static_cast<size_t>(tex->Height) * static_cast<size_t>(tex->BytesPerPixel);
+        if (bytes <= kAtlasBudgetBytes) {
+            return;
+        }
+        g_last_compact_frame = frame;
+        io.Fonts->CompactCache();
+        PRINT("[font_loader] atlas over budget (%dx%d, %u KiB); compacted unused glyphs", tex->Width, tex->Height, static_cast<unsigned>(bytes / 1024))
+    }
+
+    void UpdateGlyphCache() {
+        if (!g_font_atlas_built || g_font_body == nullptr || !DynamicGlyphsEnabled(ImGui::GetIO())) {
+            return;
+        }
+        if (ImGui::GetFont() != g_font_body) {
+            return;
+        }
+        glyph_cache::Update(ImGui::GetFontBaked());
+    }
+
     auto IsFontAtlasBuilt() -> bool {
         return g_font_atlas_built;
     }
@@ -134,38 +180,46 @@ namespace d3::gui2::fonts::font_loader {
         font_cfg.OversampleV                        = (desired_lang == "zh") ? 1 : 2;
         const std::array<ImWchar, 3> nvn_ext_ranges = {0xE000, 0xE152, 0};
 
-        static ImVector<ImWchar> s_font_ranges;
-        static bool              s_font_ranges_built = false;
-        if (!s_font_ranges_built || s_ranges_lang != desired_lang) {
-            // Keep the atlas small/stable: build a language-focused range set and rely on the
-            // Nintendo shared system fonts for coverage, rather than importing every CJK block.
-            ImFontGlyphRangesBuilder builder;
-            builder.AddRanges(d3::imgui_overlay::glyph_ranges::GetDefault());
-
-            if (desired_lang == "zh") {
-                // Ultra-low-memory path: build ranges from the actual translated UI strings.
-                overlay.AppendTranslationGlyphs(builder);
-            } else if (desired_lang == "ko") {
-                builder.AddRanges(d3::imgui_overlay::glyph_ranges::GetKorean());
-            } else if (desired_lang == "ja") {
-                builder.AddRanges(d3::imgui_overlay::glyph_ranges::GetJapanese());
-            } else {
-                // "Good enough" default: support Cyrillic for RU users without pulling in all CJK.
-                builder.AddRanges(d3::imgui_overlay::glyph_ranges::GetCyrillic());
-            }
+        // With RendererHasTextures (ImGui 1.92 dynamic fonts) glyphs are rasterized from the
+        // shared font on first use and packed into the atlas incrementally, so no up-front
+        // range set is needed; GlyphRanges would only restrict coverage. The range builder
+        // below is kept for backends without texture updates.
+        const bool     dynamic_glyphs = DynamicGlyphsEnabled(io);
+        const ImWchar *ranges         = nullptr;
+        if (!dynamic_glyphs) {
+            static ImVector<ImWchar> s_font_ranges;
+            static bool              s_font_ranges_built = false;
+            if (!s_font_ranges_built || s_ranges_lang != desired_lang) {
+                // Keep the atlas small/stable: build a language-focused range set and rely on the
+                // Nintendo shared system fonts for coverage, rather than importing every CJK block.
+                ImFontGlyphRangesBuilder builder;
+                builder.AddRanges(d3::imgui_overlay::glyph_ranges::GetDefault());
+
+                if (desired_lang == "zh") {
+                    // Ultra-low-memory path: build ranges from the actual translated UI strings.
+                    overlay.AppendTranslationGlyphs(builder);
+                } else if (desired_lang == "ko") {
+                    builder.AddRanges(d3::imgui_overlay::glyph_ranges::GetKorean());
+                } else if (desired_lang == "ja") {
+                    builder.AddRanges(d3::imgui_overlay::glyph_ranges::GetJapanese());
+                } else {
+                    // "Good enough" default: support Cyrillic for RU users without pulling in all CJK.
+                    builder.AddRanges(d3::imgui_overlay::glyph_ranges::GetCyrillic());
+                }
 
-            // Private-use glyphs used by Nintendo's extension fonts.
-            builder.AddRanges(nvn_ext_ranges.data());
+                // Private-use glyphs used by Nintendo's extension fonts.
+                builder.AddRanges(nvn_ext_ranges.data());
 
-            s_font_ranges.clear();
-            builder.BuildRanges(&s_font_ranges);
-            s_font_ranges_built = true;
-            s_ranges_lang       = desired_lang;
-        }
+                s_font_ranges.clear();
+                builder.BuildRanges(&s_font_ranges);
+                s_font_ranges_built = true;
+                s_ranges_lang       = desired_lang;
+            }
 
-        const ImWchar *ranges = s_font_ranges.Data;
-        if (ranges == nullptr || ranges[0] == 0) {
-            ranges = d3::imgui_overlay::glyph_ranges::GetDefault();
+            ranges = s_font_ranges.Data;
+            if (ranges == nullptr || ranges[0] == 0) {
+                ranges = d3::imgui_overlay::glyph_ranges::GetDefault();
+            }
         }
 
         auto get_shared_font_type = [](const std::string &lang, bool extension) -> nn::pl::SharedFontType {
@@ -181,6 +235,8 @@ namespace d3::gui2::fonts::font_loader {
 
         bool          used_shared_font = false;
         ImFont const *font_body        = nullptr;
+        const void   *body_data        = nullptr;
+        size_t        body_size        = 0;
 
         const nn::pl::SharedFontType shared_base = get_shared_font_type(desired_lang, false);
         const nn::pl::SharedFontType shared_ext  = get_shared_font_type(desired_lang, true);
@@ -221,6 +277,8 @@ namespace d3::gui2::fonts::font_loader {
                     PRINT_LINE("[font_loader] ERROR: AddFontFromMemoryTTF failed for shared base font");
                 } else {
                     used_shared_font = true;
+                    body_data        = shared_font;
+                    body_size        = shared_size;
                 }
             }
         }
@@ -269,6 +327,10 @@ namespace d3::gui2::fonts::font_loader {
         g_font_body  = const_cast<ImFont *>(font_body);
         g_font_title = g_font_body;
 
+        if (dynamic_glyphs && font_body != nullptr) {
+            glyph_cache::SetFontIdentity(desired_lang, body_data, body_size);
+        }
+
         g_font_atlas_built = true;
         result.atlas_built = true;
         s_font_lang        = desired_lang;
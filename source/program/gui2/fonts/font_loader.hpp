@@ -17,6 +17,15 @@ namespace d3::gui2::fonts::font_loader {
     auto PrepareFonts(d3::gui2::ui::Overlay &overlay, const std::string &desired_lang)
         -> PrepareResult;
 
+    // Call between frames (before ImGui::NewFrame). With on-demand glyph baking the
+    // atlas only grows; when it exceeds the budget, baked sizes/glyphs that have not
+    // been used recently are discarded and the texture is repacked.
+    void MaintainAtlas();
+
+    // Call right after ImGui::NewFrame(): warms/persists the SD glyph cache for the
+    // body font at its current baked size (see glyph_cache.hpp).
+    void UpdateGlyphCache();
+
     auto IsFontAtlasBuilt() -> bool;
     auto GetTitleFont() -> ImFont *;
     auto GetBodyFont() -> ImFont *;
@@ -0,0 +1,192 @@
+#include "program/gui2/fonts/glyph_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#include "program/async_writer.hpp"
+#include "program/fs_util.hpp"
+#include "program/logging.hpp"
+#include "program/romfs_assets.hpp"
+
+#include "imgui/imgui.h"
+
+namespace d3::gui2::fonts::glyph_cache {
+    namespace {
+        struct Header {
+            char magic[4];
+            u32  version;
+            u32  size_px;
+            u32  font_hash;
+            u32  glyph_hash;
+            u32  glyph_count;
+            char lang[8];
+        };
+        static_assert(sizeof(Header) == 32);
+
+        constexpr size_t kMaxGlyphs           = 16384;
+        constexpr int    kSaveIntervalFrames  = 1800;  // ~30 s at 60 fps
+        constexpr size_t kFontHashPrefixBytes = 64u * 1024u;
+        constexpr size_t kMaxFileBytes        = sizeof(Header) + kMaxGlyphs * sizeof(u32);
+
+        std::string      g_lang;
+        u32              g_font_hash       = 0;
+        u32              g_warm_size_px    = 0;  // size the current key was warmed for; 0 = not yet
+        std::vector<u32> g_known;                // sorted; loaded from SD plus everything baked since
+        int              g_last_save_frame = 0;
+
+        static auto Fnv1a32(const void *data, size_t size, u32 hash = 2166136261u) -> u32 {
+            const auto *bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        static auto CachePath(u32 size_px) -> std::string {
+            char path[96];
+            snprintf(path, sizeof(path), "sd:/config/d3hack-nx/glyphs_%s_%u.bin", g_lang.c_str(), size_px);
+            return path;
+        }
+
+        static auto CollectCodepoints(const ImFontBaked &baked) -> std::vector<u32> {
+            std::vector<u32> out;
+            out.reserve(static_cast<size_t>(baked.Glyphs.Size));
+            for (const ImFontGlyph &glyph : baked.Glyphs) {
+                if (glyph.Codepoint >= 0x20) {
+                    out.push_back(glyph.Codepoint);
+                }
+            }
+            std::sort(out.begin(), out.end());
+            out.erase(std::unique(out.begin(), out.end()), out.end());
+            return out;
+        }
+
+        static auto LoadCodepoints(u32 size_px, std::vector<u32> &out) -> bool {
+            out.clear();
+            const std::string path = CachePath(size_px);
+            std::string       blob;
+            if (!d3::romfs::ReadFileToString(path.c_str(), blob, kMaxFileBytes)) {
+                return false;
+            }
+            Header header {};
+            if (blob.size() < sizeof(header)) {
+                return false;
+            }
+            std::memcpy(&header, blob.data(), sizeof(header));
+            const bool header_ok =
+                std::memcmp(header.magic, kMagic.data(), sizeof(header.magic)) == 0 &&
+                header.version == kVersion &&
+                header.size_px == size_px &&
+                header.font_hash == g_font_hash &&
+                header.glyph_count <= kMaxGlyphs &&
+                blob.size() == sizeof(header) + header.glyph_count * sizeof(u32) &&
+                std::strncmp(header.lang, g_lang.c_str(), sizeof(header.lang)) == 0;
+            if (!header_ok) {
+                PRINT("[glyph_cache] ignoring stale/invalid %s", path.c_str())
+                return false;
+            }
+            out.resize(header.glyph_count);
+            std::memcpy(out.data(), blob.data() + sizeof(header), out.size() * sizeof(u32));
+            if (Fnv1a32(out.data(), out.size() * sizeof(u32)) != header.glyph_hash || !std::is_sorted(out.begin(), out.end())) {
+                PRINT("[glyph_cache] checksum mismatch in %s", path.c_str())
+                out.clear();
+                return false;
+            }
+            return true;
+        }
+
+        static void SaveCodepoints(u32 size_px, const std::vector<u32> &codepoints) {
+            Header header {};
+            std::memcpy(header.magic, kMagic.data(), sizeof(header.magic));
+            header.version     = kVersion;
+            header.size_px     = size_px;
+            header.font_hash   = g_font_hash;
+            header.glyph_hash  = Fnv1a32(codepoints.data(), codepoints.size() * sizeof(u32));
+            header.glyph_count = static_cast<u32>(codepoints.size());
+            std::strncpy(header.lang, g_lang.c_str(), sizeof(header.lang));
+
+            std::string blob;
+            blob.reserve(sizeof(header) + codepoints.size() * sizeof(u32));
+            blob.append(reinterpret_cast<const char *>(&header), sizeof(header));
+            blob.append(reinterpret_cast<const char *>(codepoints.data()), codepoints.size() * sizeof(u32));
+
+            // This runs on the present thread: hand the file to the SD writer.
+            // Replace() is not atomic, but a torn file fails the size/checksum
+            // check in LoadCodepoints and is simply ignored.
+            const std::string path = CachePath(size_px);
+            if (d3::async_writer::Replace(path.c_str(), blob.data(), blob.size())) {
+                PRINT("[glyph_cache] queued %u glyphs for %s", header.glyph_count, path.c_str())
+                return;
+            }
+            std::string error;
+            if (!d3::fs_util::WriteAllAtomic(path.c_str(), blob, "glyph cache", error)) {
+                PRINT("[glyph_cache] save failed: %s", error.c_str())
+                return;
+            }
+            PRINT("[glyph_cache] saved %u glyphs to %s", header.glyph_count, path.c_str())
+        }
+    }  // namespace
+
+    void SetFontIdentity(const std::string &lang, const void *data, size_t size) {
+        g_lang = lang.substr(0, sizeof(Header::lang) - 1);
+        // Size plus a prefix of the font file: cheap, and enough to tell firmware
+        // font revisions apart without hashing several MiB on the boot path.
+        const u64 size64 = size;
+        g_font_hash      = Fnv1a32(&size64, sizeof(size64));
+        if (data != nullptr) {
+            g_font_hash = Fnv1a32(data, std::min(size, kFontHashPrefixBytes), g_font_hash);
+        }
+        g_warm_size_px    = 0;
+        g_last_save_frame = 0;
+        g_known.clear();
+    }
+
+    void Update(ImFontBaked *baked) {
+        if (baked == nullptr || g_lang.empty()) {
+            return;
+        }
+        const u32 size_px = static_cast<u32>(std::lround(baked->Size));
+        if (size_px == 0) {
+            return;
+        }
+        const int frame = ImGui::GetFrameCount();
+
+        if (g_warm_size_px != size_px) {
+            // New key (first frame, or the GUI scale changed): bake everything this
+            // size used last time while the atlas is still being assembled.
+            g_warm_size_px    = size_px;
+            g_last_save_frame = frame;
+            if (LoadCodepoints(size_px, g_known)) {
+                for (const u32 cp : g_known) {
+                    if (cp <= IM_UNICODE_CODEPOINT_MAX) {
+                        baked->FindGlyph(static_cast<ImWchar>(cp));
+                    }
+                }
+                PRINT("[glyph_cache] warmed %u glyphs (%s, %upx)", static_cast<unsigned>(g_known.size()), g_lang.c_str(), size_px)
+            }
+            return;
+        }
+
+        if (frame - g_last_save_frame < kSaveIntervalFrames) {
+            return;
+        }
+        g_last_save_frame = frame;
+        // Union with the known set: after a CompactCache() the baked set can be
+        // smaller than what was saved, and that should not shrink the warm list.
+        const std::vector<u32> baked_now = CollectCodepoints(*baked);
+        std::vector<u32>       merged;
+        merged.reserve(g_known.size() + baked_now.size());
+        std::set_union(g_known.begin(), g_known.end(), baked_now.begin(), baked_now.end(), std::back_inserter(merged));
+        if (merged.size() == g_known.size() || merged.size() > kMaxGlyphs) {
+            return;
+        }
+        g_known = std::move(merged);
+        SaveCodepoints(size_px, g_known);
+    }
+
+}  // namespace d3::gui2::fonts::glyph_cache
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "types.h"
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+struct ImFontBaked;
+
+namespace d3::gui2::fonts::glyph_cache {
+
+    // Persisted glyph set for one (language, pixel size, shared font) combination:
+    //   sd:/config/d3hack-nx/glyphs_<lang>_<px>.bin
+    // On a later boot the listed codepoints are baked during the first overlay
+    // frame, so they land in the initial atlas upload instead of trickling in as
+    // per-glyph rasterize + texture updates while menus are first opened.
+    //
+    // The R8 atlas and glyph metrics are out of scope: ImGui 1.92 owns the packer
+    // and baked-glyph tables (no API to restore them), and re-rasterizing a few
+    // hundred glyphs from the resident shared font is cheaper than reading a
+    // multi-MiB image from SD. Saves go through async_writer, with a synchronous
+    // fallback when the writer is not running or the list is too large for it.
+    constexpr std::array<char, 4> kMagic   = {'D', '3', 'G', 'C'};
+    constexpr u32                 kVersion = 1;
+
+    // Called by PrepareFonts whenever the atlas is (re)built. `data`/`size` identify
+    // the base font (nullptr for the built-in ImGui font); a firmware font update
+    // changes the identity and invalidates old cache files.
+    void SetFontIdentity(const std::string &lang, const void *data, size_t size);
+
+    // Call once per frame right after ImGui::NewFrame() with the current baked font.
+    // Warms the cache for the active size once, then periodically persists the set
+    // when new glyphs have been baked.
+    void Update(ImFontBaked *baked);
+
+}  // namespace d3::gui2::fonts::glyph_cache
@@ -4,7 +4,6 @@
 #include <algorithm>
 #include <atomic>
 #include <cstdarg>
-#include <cctype>
 #include <cfloat>
 #include <cstdint>
 #include <cstdlib>
@@ -24,15 +23,16 @@
 #include "program/gui2/backend/nvn_hooks.hpp"
 #include "program/gui2/fonts/font_loader.hpp"
 #include "program/gui2/input/hid_block.hpp"
+#include "program/gui2/input/input_snapshot.hpp"
 #include "program/gui2/memory/imgui_alloc.hpp"
 #include "program/gui2/ui/overlay.hpp"
+#include "program/gui2/ui/theme_overrides.hpp"
 #include "program/gui2/ui/windows/notifications_window.hpp"
 #include "program/gui2/input_util.hpp"
 #include "program/d3/_util.hpp"
 #include "program/d3/setting.hpp"
 #include "program/log_once.hpp"
 #include "symbols/common.hpp"
-#include "tomlplusplus/toml.hpp"
 
 #include "imgui/imgui.h"
 #include "imgui_backend/imgui_impl_nvn.hpp"
@@ -53,73 +53,6 @@ namespace d3::imgui_overlay {
 
         static void OnPresent(NVNqueue *queue, NVNwindow *window, int texture_index);
 
-        struct NpadCombinedState {
-            u64                       buttons = 0;
-            nn::hid::AnalogStickState stick_l {};
-            nn::hid::AnalogStickState stick_r {};
-            bool                      have_stick_l = false;
-            bool                      have_stick_r = false;
-        };
-
-        static auto CombineNpadState(NpadCombinedState &out, uint port) -> bool {
-            out = {};
-
-            d3::gui2::input::hid_block::ScopedHidPassthroughForOverlay const passthrough_guard;
-
-            auto consider_stick = [](bool &have, nn::hid::AnalogStickState &dst, const nn::hid::AnalogStickState &src) -> void {
-                const auto mag     = static_cast<u64>(std::abs(src.X)) + static_cast<u64>(std::abs(src.Y));
-                const auto dst_mag = static_cast<u64>(std::abs(dst.X)) + static_cast<u64>(std::abs(dst.Y));
-                if (!have || mag > dst_mag) {
-                    dst  = src;
-                    have = true;
-                }
-            };
-
-            auto accumulate = [&](const nn::hid::NpadBaseState &state) -> void {
-                out.buttons |= state.mButtons.field[0];
-                consider_stick(out.have_stick_l, out.stick_l, state.mAnalogStickL);
-                consider_stick(out.have_stick_r, out.stick_r, state.mAnalogStickR);
-            };
-
-            constexpr uint              kHandheldPort = 0x20;
-            const nn::hid::NpadStyleSet style         = nn::hid::GetNpadStyleSet(port);
-            bool                        read_any      = false;
-
-            if (style.isBitSet(nn::hid::NpadStyleTag::NpadStyleFullKey)) {
-                nn::hid::NpadFullKeyState full {};
-                nn::hid::GetNpadState(&full, port);
-                accumulate(full);
-                read_any = true;
-            }
-            if (style.isBitSet(nn::hid::NpadStyleTag::NpadStyleJoyDual)) {
-                nn::hid::NpadJoyDualState joy_dual {};
-                nn::hid::GetNpadState(&joy_dual, port);
-                accumulate(joy_dual);
-                read_any = true;
-            }
-            if (style.isBitSet(nn::hid::NpadStyleTag::NpadStyleJoyLeft)) {
-                nn::hid::NpadJoyLeftState joy_left {};
-                nn::hid::GetNpadState(&joy_left, port);
-                accumulate(joy_left);
-                read_any = true;
-            }
-            if (style.isBitSet(nn::hid::NpadStyleTag::NpadStyleJoyRight)) {
-                nn::hid::NpadJoyRightState joy_right {};
-                nn::hid::GetNpadState(&joy_right, port);
-                accumulate(joy_right);
-                read_any = true;
-            }
-
-            if (style.isBitSet(nn::hid::NpadStyleTag::NpadStyleHandheld) || !read_any) {
-                nn::hid::NpadHandheldState handheld {};
-                nn::hid::GetNpadState(&handheld, kHandheldPort);
-                accumulate(handheld);
-                read_any = true;
-            }
-
-            return out.buttons != 0 || out.have_stick_l || out.have_stick_r;
-        }
-
         static auto NpadButtonDown(u64 buttons, nn::hid::NpadButton button) -> bool {
             const auto bit = static_cast<u64>(button);
             return (buttons & (1ULL << bit)) != 0;
@@ -129,31 +62,22 @@ namespace d3::imgui_overlay {
             return state.keys.isBitSet(key);
         }
 
-        static d3::gui2::ui::Overlay g_overlay {};
-        static NpadCombinedState     g_last_npad {};
-        static bool                  g_last_npad_valid = false;
-
-        static void PushImGuiGamepadInputs(float dt_s);
-        static auto PushImGuiTouchInputs(const ImVec2 &viewport_size) -> bool;
-        static auto PushImGuiMouseInputs(const ImVec2 &viewport_size) -> bool;
-        static void PushImGuiKeyboardInputs();
-        static void DetectOverlaySwipe(const ImVec2 &viewport_size);
-        static void UpdateImGuiStyleAndScale(ImVec2 viewport_size);
+        using d3::gui2::input::InputSnapshot;
 
-        static bool g_touch_init_tried = false;
+        static d3::gui2::ui::Overlay g_overlay {};
 
-        static void EnsureTouchInitialized() {
-            if (g_touch_init_tried) {
-                return;
-            }
-            g_touch_init_tried = true;
-            nn::hid::InitializeTouchScreen();
-        }
+        static void PushImGuiGamepadInputs(const InputSnapshot &input, float dt_s);
+        static auto PushImGuiTouchInputs(const InputSnapshot &input, const ImVec2 &viewport_size) -> bool;
+        static auto PushImGuiMouseInputs(const InputSnapshot &input, const ImVec2 &viewport_size) -> bool;
+        static void PushImGuiKeyboardInputs(const InputSnapshot &input);
+        static void DetectOverlaySwipe(const InputSnapshot &input);
+        static void UpdateImGuiStyleAndScale(ImVec2 viewport_size);
 
         static bool                   g_imgui_style_initialized = false;
         static ImGuiStyle             g_imgui_base_style {};
-        static float                  g_last_gui_scale = -1.0f;
-        static d3::gui2::ui::GuiTheme g_imgui_theme    = d3::gui2::ui::GuiTheme::D3Dark;
+        static float                  g_last_gui_scale         = -1.0f;
+        static d3::gui2::ui::GuiTheme g_imgui_theme            = d3::gui2::ui::GuiTheme::D3Dark;
+        static u32                    g_imgui_theme_generation = 0;
 
         static auto ComputeGuiScale(ImVec2 viewport_size) -> float {
             constexpr float kScaleMinClamp = 0.95f;
@@ -216,198 +140,6 @@ namespace d3::imgui_overlay {
             style.TabBorderSize            = 1.0f;
         }
 
-        static auto ThemeOverrideStem(d3::gui2::ui::GuiTheme theme) -> const char * {
-            switch (theme) {
-            case d3::gui2::ui::GuiTheme::D3Dark:
-                return "d3";
-            case d3::gui2::ui::GuiTheme::Blueish:
-                return "blueish";
-            }
-            return "d3";
-        }
-
-        static auto NormalizeThemeKey(std::string_view input) -> std::string {
-            std::string out;
-            out.reserve(input.size());
-            for (const char ch : input) {
-                const unsigned char uch = static_cast<unsigned char>(ch);
-                if (std::isspace(uch) || ch == '_' || ch == '-') {
-                    continue;
-                }
-                out.push_back(static_cast<char>(std::tolower(uch)));
-            }
-            if (out.rfind("imguicol", 0) == 0) {
-                out.erase(0, std::strlen("imguicol"));
-            }
-            return out;
-        }
-
-        static auto ParseHexNibble(char ch, u8 &out) -> bool {
-            if (ch >= '0' && ch <= '9') {
-                out = static_cast<u8>(ch - '0');
-                return true;
-            }
-            if (ch >= 'a' && ch <= 'f') {
-                out = static_cast<u8>(10 + (ch - 'a'));
-                return true;
-            }
-            if (ch >= 'A' && ch <= 'F') {
-                out = static_cast<u8>(10 + (ch - 'A'));
-                return true;
-            }
-            return false;
-        }
-
-        static auto ParseHexColor(std::string_view s, ImVec4 &out) -> bool {
-            if (s.empty()) {
-                return false;
-            }
-            if (s.front() == '#') {
-                s.remove_prefix(1);
-            }
-            if (s.size() != 6 && s.size() != 8) {
-                return false;
-            }
-
-            auto parse_byte = [&](size_t i, u8 &b) -> bool {
-                u8 hi = 0;
-                u8 lo = 0;
-                if (!ParseHexNibble(s[i], hi) || !ParseHexNibble(s[i + 1], lo)) {
-                    return false;
-                }
-                b = static_cast<u8>((hi << 4) | lo);
-                return true;
-            };
-
-            u8 r = 0, g = 0, b = 0, a = 0xFF;
-            if (!parse_byte(0, r) || !parse_byte(2, g) || !parse_byte(4, b)) {
-                return false;
-            }
-            if (s.size() == 8) {
-                if (!parse_byte(6, a)) {
-                    return false;
-                }
-            }
-
-            out = ImVec4(
-                static_cast<float>(r) / 255.0f,
-                static_cast<float>(g) / 255.0f,
-                static_cast<float>(b) / 255.0f,
-                static_cast<float>(a) / 255.0f
-            );
-            return true;
-        }
-
-        static void TryApplyThemeOverrides(ImGuiStyle &style, d3::gui2::ui::GuiTheme theme) {
-            std::string path = "sd:/config/d3hack-nx/themes/";
-            path += ThemeOverrideStem(theme);
-            path += ".toml";
-
-            std::string text;
-            if (!d3::romfs::ReadFileToString(path.c_str(), text, 64 * 1024)) {
-                return;
-            }
-
-            auto result = toml::parse(text, std::string_view {path});
-            if (!result) {
-                if (d3::log_once::ShouldLog("gui.theme_override.parse_failed")) {
-                    const auto &err = result.error();
-                    PRINT("[gui] theme override parse failed: %s", std::string(err.description()).c_str());
-                }
-                return;
-            }
-
-            const toml::table &root   = result.table();
-            const toml::table *colors = nullptr;
-            if (auto node = root.get("colors"); node && node->is_table()) {
-                colors = node->as_table();
-            }
-            if (colors == nullptr) {
-                return;
-            }
-
-            auto apply_color = [&](std::string_view key, const toml::node &node) -> void {
-                auto v = node.value<std::string>();
-                if (!v) {
-                    return;
-                }
-                ImVec4 color {};
-                if (!ParseHexColor(*v, color)) {
-                    return;
-                }
-
-                const std::string normalized = NormalizeThemeKey(key);
-                if (normalized == "text") {
-                    style.Colors[ImGuiCol_Text] = color;
-                } else if (normalized == "textdisabled") {
-                    style.Colors[ImGuiCol_TextDisabled] = color;
-                } else if (normalized == "windowbg") {
-                    style.Colors[ImGuiCol_WindowBg] = color;
-                } else if (normalized == "popupbg") {
-                    style.Colors[ImGuiCol_PopupBg] = color;
-                } else if (normalized == "border") {
-                    style.Colors[ImGuiCol_Border] = color;
-                } else if (normalized == "framebg") {
-                    style.Colors[ImGuiCol_FrameBg] = color;
-                } else if (normalized == "framebghovered") {
-                    style.Colors[ImGuiCol_FrameBgHovered] = color;
-                } else if (normalized == "framebgactive") {
-                    style.Colors[ImGuiCol_FrameBgActive] = color;
-                } else if (normalized == "titlebg") {
-                    style.Colors[ImGuiCol_TitleBg] = color;
-                } else if (normalized == "titlebgactive") {
-                    style.Colors[ImGuiCol_TitleBgActive] = color;
-                } else if (normalized == "menubarbg") {
-                    style.Colors[ImGuiCol_MenuBarBg] = color;
-                } else if (normalized == "checkmark") {
-                    style.Colors[ImGuiCol_CheckMark] = color;
-                } else if (normalized == "slidergrab") {
-                    style.Colors[ImGuiCol_SliderGrab] = color;
-                } else if (normalized == "slidergrabactive") {
-                    style.Colors[ImGuiCol_SliderGrabActive] = color;
-                } else if (normalized == "button") {
-                    style.Colors[ImGuiCol_Button] = color;
-                } else if (normalized == "buttonhovered") {
-                    style.Colors[ImGuiCol_ButtonHovered] = color;
-                } else if (normalized == "buttonactive") {
-                    style.Colors[ImGuiCol_ButtonActive] = color;
-                } else if (normalized == "header") {
-                    style.Colors[ImGuiCol_Header] = color;
-                } else if (normalized == "headerhovered") {
-                    style.Colors[ImGuiCol_HeaderHovered] = color;
-                } else if (normalized == "headeractive") {
-                    style.Colors[ImGuiCol_HeaderActive] = color;
-                } else if (normalized == "separator") {
-                    style.Colors[ImGuiCol_Separator] = color;
-                } else if (normalized == "separatorhovered") {
-                    style.Colors[ImGuiCol_SeparatorHovered] = color;
-                } else if (normalized == "separatoractive") {
-                    style.Colors[ImGuiCol_SeparatorActive] = color;
-                } else if (normalized == "tab") {
-                    style.Colors[ImGuiCol_Tab] = color;
-                } else if (normalized == "tabhovered") {
-                    style.Colors[ImGuiCol_TabHovered] = color;
-                } else if (normalized == "tabselected") {
-                    style.Colors[ImGuiCol_TabSelected] = color;
-                } else if (normalized == "textselectedbg") {
-                    style.Colors[ImGuiCol_TextSelectedBg] = color;
-                } else if (normalized == "navcursor") {
-                    style.Colors[ImGuiCol_NavCursor] = color;
-                } else if (normalized == "navwindowinghighlight") {
-                    style.Colors[ImGuiCol_NavWindowingHighlight] = color;
-                }
-            };
-
-            colors->for_each([&](const toml::key &k, const toml::node &v) -> void {
-                apply_color(std::string_view {k.str()}, v);
-            });
-
-            const char *key = (theme == d3::gui2::ui::GuiTheme::Blueish) ? "gui.theme_override.applied.blueish" : "gui.theme_override.applied.d3";
-            if (d3::log_once::ShouldLog(key)) {
-                PRINT("[gui] theme overrides applied: %s", path.c_str());
-            }
-        }
-
         static void ApplyImGuiThemeColors(ImGuiStyle &style, d3::gui2::ui::GuiTheme theme) {
             ImVec4 *colors = style.Colors;
 
@@ -461,7 +193,7 @@ namespace d3::imgui_overlay {
                 colors[ImGuiCol_TextSelectedBg]        = ImVec4(kAccent.x, kAccent.y, kAccent.z, 0.35f);
                 colors[ImGuiCol_NavCursor]             = ImVec4(kAccentHi.x, kAccentHi.y, kAccentHi.z, 0.80f);
                 colors[ImGuiCol_NavWindowingHighlight] = ImVec4(kAccent.x, kAccent.y, kAccent.z, 0.80f);
-                TryApplyThemeOverrides(style, theme);
+                d3::gui2::ui::theme_overrides::Apply(style, theme);
                 return;
             }
 
@@ -515,10 +247,13 @@ namespace d3::imgui_overlay {
             colors[ImGuiCol_NavCursor]             = ImVec4(kAccentHi.x, kAccentHi.y, kAccentHi.z, 0.80f);
             colors[ImGuiCol_NavWindowingHighlight] = ImVec4(kAccent.x, kAccent.y, kAccent.z, 0.80f);
 
-            TryApplyThemeOverrides(style, theme);
+            d3::gui2::ui::theme_overrides::Apply(style, theme);
         }
 
         static void InitializeImGuiStyle(d3::gui2::ui::GuiTheme theme) {
+            d3::gui2::ui::theme_overrides::Start();
+            g_imgui_theme_generation = d3::gui2::ui::theme_overrides::Generation();
+
             ImGuiStyle &style = ImGui::GetStyle();
             style             = ImGuiStyle();
             ImGui::StyleColorsDark(&style);
@@ -534,8 +269,10 @@ namespace d3::imgui_overlay {
         }
 
         static void UpdateImGuiStyleAndScale(ImVec2 viewport_size) {
+            d3::gui2::ui::theme_overrides::SetPolling(g_overlay.overlay_visible());
             const auto desired_theme = g_overlay.theme();
-            if (!g_imgui_style_initialized || desired_theme != g_imgui_theme) {
+            if (!g_imgui_style_initialized || desired_theme != g_imgui_theme ||
+                d3::gui2::ui::theme_overrides::Generation() != g_imgui_theme_generation) {
                 InitializeImGuiStyle(desired_theme);
                 g_last_gui_scale = -1.0f;
             }
@@ -571,19 +308,8 @@ namespace d3::imgui_overlay {
             g_last_gui_scale    = gui_scale;
         }
 
-        static void PushImGuiGamepadInputs(float dt_s) {
-            if (!g_imgui_ctx_initialized) {
-                return;
-            }
-
-            // Avoid calling into hid early; wait until the game has completed shell initialization.
-            if (d3::g_ptMainRWindow == nullptr) {
-                return;
-            }
-
-            NpadCombinedState st {};
-            g_last_npad_valid = CombineNpadState(st, 0);
-            g_last_npad       = st;
+        static void PushImGuiGamepadInputs(const InputSnapshot &input, float dt_s) {
+            const auto &st = input.npad;
 
             const bool plus  = NpadButtonDown(st.buttons, nn::hid::NpadButton::Plus);
             const bool minus = NpadButtonDown(st.buttons, nn::hid::NpadButton::Minus);
@@ -645,16 +371,8 @@ namespace d3::imgui_overlay {
             }
         }
 
-        static void DetectOverlaySwipe(const ImVec2 &viewport_size) {
-            if (!g_imgui_ctx_initialized) {
-                return;
-            }
-
-            if (d3::g_ptMainRWindow == nullptr) {
-                return;
-            }
-
-            if (!g_overlay.imgui_render_enabled()) {
+        static void DetectOverlaySwipe(const InputSnapshot &input) {
+            if (!g_overlay.imgui_render_enabled() || !input.touch_sampled) {
                 return;
             }
 
@@ -662,18 +380,12 @@ namespace d3::imgui_overlay {
                 return;
             }
 
-            d3::gui2::input::hid_block::ScopedHidPassthroughForOverlay const passthrough_guard;
-            EnsureTouchInitialized();
-
-            nn::hid::TouchScreenState<nn::hid::TouchStateCountMax> st {};
-            nn::hid::GetTouchScreenState(&st);
-
             static bool s_swipe_active    = false;
             static bool s_swipe_triggered = false;
             static s32  s_start_x         = 0;
             static s32  s_start_y         = 0;
 
-            const bool down = st.count > 0;
+            const bool down = input.touch_count > 0;
             if (!down) {
                 s_swipe_active    = false;
                 s_swipe_triggered = false;
@@ -683,8 +395,8 @@ namespace d3::imgui_overlay {
             if (!s_swipe_active) {
                 s_swipe_active    = true;
                 s_swipe_triggered = false;
-                s_start_x         = st.touches[0].x;
-                s_start_y         = st.touches[0].y;
+                s_start_x         = input.touch_x;
+                s_start_y         = input.touch_y;
             }
 
             if (s_swipe_triggered) {
@@ -704,25 +416,18 @@ namespace d3::imgui_overlay {
                 return;
             }
 
-            const s32 dx = st.touches[0].x - s_start_x;
-            const s32 dy = st.touches[0].y - s_start_y;
+            const s32 dx = input.touch_x - s_start_x;
+            const s32 dy = input.touch_y - s_start_y;
             if (dx >= static_cast<s32>(trigger_px) &&
                 std::abs(dy) <= static_cast<s32>(max_vertical_delta)) {
                 g_overlay.set_overlay_visible_persist(true);
                 s_swipe_triggered = true;
                 PRINT_LINE("[imgui_overlay] Swipe opened overlay");
             }
-
-            (void)viewport_size;
         }
 
-        static auto PushImGuiTouchInputs(const ImVec2 &viewport_size) -> bool {
-            if (!g_imgui_ctx_initialized) {
-                return false;
-            }
-
-            // Avoid calling into hid early; wait until the game has completed shell initialization.
-            if (d3::g_ptMainRWindow == nullptr) {
+        static auto PushImGuiTouchInputs(const InputSnapshot &input, const ImVec2 &viewport_size) -> bool {
+            if (!input.touch_sampled) {
                 return false;
             }
 
@@ -732,15 +437,7 @@ namespace d3::imgui_overlay {
 
             ImGuiIO &io = ImGui::GetIO();
 
-            // Keep touch reads scoped so our own HID hooks don't block us while the overlay is visible.
-            d3::gui2::input::hid_block::ScopedHidPassthroughForOverlay const passthrough_guard;
-
-            EnsureTouchInitialized();
-
-            nn::hid::TouchScreenState<nn::hid::TouchStateCountMax> st {};
-            nn::hid::GetTouchScreenState(&st);
-
-            const bool down     = st.count > 0;
+            const bool down     = input.touch_count > 0;
             const bool pressed  = down && !s_prev_down;
             const bool released = !down && s_prev_down;
             const bool active   = down || released;
@@ -752,8 +449,8 @@ namespace d3::imgui_overlay {
             }
 
             if (down) {
-                s_last_touch_x = st.touches[0].x;
-                s_last_touch_y = st.touches[0].y;
+                s_last_touch_x = input.touch_x;
+                s_last_touch_y = input.touch_y;
             }
 
             if (active) {
@@ -779,28 +476,13 @@ namespace d3::imgui_overlay {
             return active;
         }
 
-        static auto PushImGuiMouseInputs(const ImVec2 &viewport_size) -> bool {
-            if (!g_imgui_ctx_initialized) {
+        static auto PushImGuiMouseInputs(const InputSnapshot &input, const ImVec2 &viewport_size) -> bool {
+            if (!input.mouse_sampled) {
                 return false;
             }
 
-            // Avoid calling into hid early; wait until the game has completed shell initialization.
-            if (d3::g_ptMainRWindow == nullptr) {
-                return false;
-            }
-
-            // Keep KBM init and reads scoped so our own HID hooks don't block us while the overlay is visible.
-            d3::gui2::input::hid_block::ScopedHidPassthroughForOverlay const passthrough_guard;
-
-            static bool s_mouse_init_tried = false;
-            if (!s_mouse_init_tried) {
-                s_mouse_init_tried = true;
-                nn::hid::InitializeMouse();
-            }
-
-            nn::hid::MouseState st {};
-            nn::hid::GetMouseState(&st);
-            const bool mouse_connected = st.attributes.isBitSet(nn::hid::MouseAttribute::IsConnected);
+            const nn::hid::MouseState &st              = input.mouse;
+            const bool                 mouse_connected = st.attributes.isBitSet(nn::hid::MouseAttribute::IsConnected);
 
             ImGuiIO &io = ImGui::GetIO();
             if (!mouse_connected) {
@@ -833,26 +515,12 @@ namespace d3::imgui_overlay {
             return mouse_connected;
         }
 
-        static void PushImGuiKeyboardInputs() {
-            if (!g_imgui_ctx_initialized) {
+        static void PushImGuiKeyboardInputs(const InputSnapshot &input) {
+            if (!input.keyboard_sampled) {
                 return;
             }
 
-            // Avoid calling into hid early; wait until the game has completed shell initialization.
-            if (d3::g_ptMainRWindow == nullptr) {
-                return;
-            }
-
-            d3::gui2::input::hid_block::ScopedHidPassthroughForOverlay const passthrough_guard;
-
-            static bool s_keyboard_init_tried = false;
-            if (!s_keyboard_init_tried) {
-                s_keyboard_init_tried = true;
-                nn::hid::InitializeKeyboard();
-            }
-
-            nn::hid::KeyboardState st {};
-            nn::hid::GetKeyboardState(&st);
+            const nn::hid::KeyboardState &st = input.keyboard;
 
             ImGuiIO &io = ImGui::GetIO();
 
@@ -1017,7 +685,17 @@ namespace d3::imgui_overlay {
 
                 const ImVec2 viewport_size = ImguiNvnBackend::getBackendData()->viewportSize;
                 UpdateImGuiStyleAndScale(viewport_size);
-                DetectOverlaySwipe(viewport_size);
+
+                // Sample every HID source once for this frame; swipe detection, the toggle chord
+                // and ImGui input all read the same snapshot. Avoid calling into hid early; wait
+                // until the game has completed shell initialization.
+                const InputSnapshot *input = nullptr;
+                if (d3::g_ptMainRWindow != nullptr) {
+                    const bool want_kbm = g_overlay.overlay_visible();
+                    input               = &d3::gui2::input::Sample({.touch = true, .mouse = want_kbm, .keyboard = want_kbm});
+                    DetectOverlaySwipe(*input);
+                }
+
                 ImGuiIO   &io              = ImGui::GetIO();
                 const bool overlay_visible = g_overlay.overlay_visible();
 
@@ -1027,32 +705,40 @@ namespace d3::imgui_overlay {
                     io.MouseDrawCursor = false;
                 }
 
-                PushImGuiGamepadInputs(io.DeltaTime);
+                if (input != nullptr) {
+                    PushImGuiGamepadInputs(*input, io.DeltaTime);
+                }
 
                 if (overlay_visible) {
-                    bool       mouse_connected = false;
-                    const bool touch_active    = PushImGuiTouchInputs(viewport_size);
-                    if (!touch_active) {
-                        mouse_connected = PushImGuiMouseInputs(viewport_size);
+                    bool mouse_connected = false;
+                    bool touch_active    = false;
+                    if (input != nullptr) {
+                        touch_active = PushImGuiTouchInputs(*input, viewport_size);
+                        if (!touch_active) {
+                            mouse_connected = PushImGuiMouseInputs(*input, viewport_size);
+                        }
+                        PushImGuiKeyboardInputs(*input);
                     }
-                    PushImGuiKeyboardInputs();
                     io.MouseDrawCursor = touch_active || mouse_connected;
                 }
 
+                d3::gui2::fonts::font_loader::MaintainAtlas();
                 ImGui::NewFrame();
+                d3::gui2::fonts::font_loader::UpdateGlyphCache();
 
+                const InputSnapshot &last_input = d3::gui2::input::Current();
                 g_overlay.UpdateFrame(
                     g_font_uploaded,
                     d3::gui2::backend::nvn_hooks::GetCropWidth(),
                     d3::gui2::backend::nvn_hooks::GetCropHeight(),
                     d3::gui2::backend::nvn_hooks::GetSwapchainTextureCount(),
                     viewport_size,
-                    g_last_npad_valid,
-                    static_cast<unsigned long long>(g_last_npad.buttons),
-                    g_last_npad.stick_l.X,
-                    g_last_npad.stick_l.Y,
-                    g_last_npad.stick_r.X,
-                    g_last_npad.stick_r.Y
+                    last_input.npad_valid,
+                    static_cast<unsigned long long>(last_input.npad.buttons),
+                    last_input.npad.stick_l.X,
+                    last_input.npad.stick_l.Y,
+                    last_input.npad.stick_r.X,
+                    last_input.npad.stick_r.Y
                 );
 
                 d3::gui2::input::hid_block::SetBlockGamepadInputToGame(g_overlay.focus_state().should_block_game_input);
@@ -1079,13 +765,10 @@ namespace d3::imgui_overlay {
             return;
         }
 
-        std::array<char, 1024> buf {};
-        va_list                ap;
+        va_list ap;
         va_start(ap, fmt);
-        vsnprintf(buf.data(), buf.size(), fmt, ap);
+        notifications->AddNotificationV(color, ttl_s, fmt, ap);
         va_end(ap);
-
-        notifications->AddNotification(color, ttl_s, "%s", buf.data());
     }
 
     void Initialize() {
@@ -16,15 +16,21 @@
 
 namespace d3::gui2::input::hid_block {
     namespace {
-        std::atomic<bool>      g_block_gamepad_input_to_game {false};
-        std::atomic<bool>      g_allow_left_stick_passthrough {false};
-        bool                   g_hid_hooks_installed = false;
-        std::atomic<int>       g_hid_passthrough_depth {0};
-        std::atomic<uintptr_t> g_hid_passthrough_thread {0};
-
-        static auto GetCurrentThreadToken() -> uintptr_t {
-            const auto *thread = nn::os::GetCurrentThread();
-            return reinterpret_cast<uintptr_t>(thread);
+        // Packed policy word so the game's hot GetNpadState(s) path decides with one relaxed load.
+        constexpr u32 kPolicyBlockGamepad         = 1u << 0;
+        constexpr u32 kPolicyAllowLeftPassthrough = 1u << 1;
+
+        std::atomic<u32> g_policy {0};
+        bool             g_hid_hooks_installed = false;
+
+        // Per-thread passthrough depth lives in an nn::os TLS slot (module-level
+        // thread_local is not set up for exlaunch modules). Any number of threads
+        // may hold a passthrough scope at once.
+        nn::os::TlsSlot   g_passthrough_slot {};
+        std::atomic<bool> g_passthrough_slot_ready {false};
+
+        static auto PassthroughDepth() -> uintptr_t {
+            return nn::os::GetTlsValue(g_passthrough_slot);
         }
 
         enum class GamepadBlockMode {
@@ -34,24 +40,24 @@ namespace d3::gui2::input::hid_block {
         };
 
         static auto GetGamepadBlockMode() -> GamepadBlockMode {
-            if (!g_block_gamepad_input_to_game.load(std::memory_order_relaxed)) {
+            const u32 policy = g_policy.load(std::memory_order_relaxed);
+            if ((policy & kPolicyBlockGamepad) == 0) {
                 return GamepadBlockMode::None;
             }
-
-            const bool allow_left_stick =
-                g_allow_left_stick_passthrough.load(std::memory_order_relaxed);
-
-            const int depth = g_hid_passthrough_depth.load(std::memory_order_relaxed);
-            if (depth <= 0) {
-                return allow_left_stick ? GamepadBlockMode::LeftStickOnly : GamepadBlockMode::Full;
-            }
-
-            const auto passthrough_thread = g_hid_passthrough_thread.load(std::memory_order_acquire);
-            if (passthrough_thread != 0 && passthrough_thread == GetCurrentThreadToken()) {
+            // Only blocked calls pay for the TLS lookup. The slot is allocated
+            // before any hook is installed, so it is always valid here.
+            if (PassthroughDepth() != 0) {
                 return GamepadBlockMode::None;
             }
+            return (policy & kPolicyAllowLeftPassthrough) != 0 ? GamepadBlockMode::LeftStickOnly : GamepadBlockMode::Full;
+        }
 
-            return allow_left_stick ? GamepadBlockMode::LeftStickOnly : GamepadBlockMode::Full;
+        static void SetPolicyBit(u32 bit, bool enabled) {
+            if (enabled) {
+                g_policy.fetch_or(bit, std::memory_order_relaxed);
+            } else {
+                g_policy.fetch_and(~bit, std::memory_order_relaxed);
+            }
         }
 
         template<typename TState>
@@ -235,53 +241,31 @@ namespace d3::gui2::input::hid_block {
     }  // namespace
 
     void SetBlockGamepadInputToGame(bool block) {
-        g_block_gamepad_input_to_game.store(block, std::memory_order_relaxed);
+        SetPolicyBit(kPolicyBlockGamepad, block);
     }
 
     void SetAllowLeftStickPassthrough(bool allow) {
-        g_allow_left_stick_passthrough.store(allow, std::memory_order_relaxed);
+        SetPolicyBit(kPolicyAllowLeftPassthrough, allow);
     }
 
     ScopedHidPassthroughForOverlay::ScopedHidPassthroughForOverlay() {
-        const uintptr_t token = GetCurrentThreadToken();
-        EXL_ABORT_UNLESS(token != 0, "[hid_block] Failed to get current thread token");
-
-        const int prev = g_hid_passthrough_depth.fetch_add(1, std::memory_order_acq_rel);
-        EXL_ABORT_UNLESS(prev >= 0, "[hid_block] HID passthrough depth underflow on enter (prev=%d)", prev);
-
-        if (prev == 0) {
-            g_hid_passthrough_thread.store(token, std::memory_order_release);
-        } else {
-            const auto owner = g_hid_passthrough_thread.load(std::memory_order_acquire);
-            EXL_ABORT_UNLESS(
-                owner == token,
-                "[hid_block] HID passthrough entered on different thread (owner=0x%lx current=0x%lx depth=%d)",
-                owner,
-                token,
-                prev + 1
-            );
+        // Before InstallHidHooks() nothing is filtered, so there is nothing to bypass.
+        if (!g_passthrough_slot_ready.load(std::memory_order_acquire)) {
+            return;
         }
+        const uintptr_t prev = PassthroughDepth();
+        EXL_ABORT_UNLESS(prev < 0x10000, "[hid_block] HID passthrough depth runaway (prev=%lu)", prev);
+        nn::os::SetTlsValue(g_passthrough_slot, prev + 1);
+        engaged_ = true;
     }
 
     ScopedHidPassthroughForOverlay::~ScopedHidPassthroughForOverlay() {
-        const uintptr_t token = GetCurrentThreadToken();
-        EXL_ABORT_UNLESS(token != 0, "[hid_block] Failed to get current thread token");
-
-        const auto owner = g_hid_passthrough_thread.load(std::memory_order_acquire);
-        EXL_ABORT_UNLESS(
-            owner == 0 || owner == token,
-            "[hid_block] HID passthrough exited on different thread (owner=0x%lx current=0x%lx)",
-            owner,
-            token
-        );
-
-        const int prev = g_hid_passthrough_depth.fetch_sub(1, std::memory_order_acq_rel);
-        EXL_ABORT_UNLESS(prev > 0, "[hid_block] HID passthrough depth underflow on exit (prev=%d)", prev);
-
-        if (prev <= 1) {
-            g_hid_passthrough_depth.store(0, std::memory_order_relaxed);
-            g_hid_passthrough_thread.store(0, std::memory_order_release);
+        if (!engaged_) {
+            return;
         }
+        const uintptr_t prev = PassthroughDepth();
+        EXL_ABORT_UNLESS(prev > 0, "[hid_block] HID passthrough depth underflow on exit");
+        nn::os::SetTlsValue(g_passthrough_slot, prev - 1);
     }
 
     void InstallHidHooks() {
@@ -289,6 +273,15 @@ namespace d3::gui2::input::hid_block {
             return;
         }
 
+        if (!g_passthrough_slot_ready.load(std::memory_order_relaxed)) {
+            const Result rc = nn::os::AllocateTlsSlot(&g_passthrough_slot, nullptr);
+            if (R_FAILED(rc)) {
+                PRINT("[hid_block] TLS slot allocation failed (rc=0x%x); input blocking disabled", rc);
+                return;
+            }
+            g_passthrough_slot_ready.store(true, std::memory_order_release);
+        }
+
         HidGetNpadStateFullKeyHook::InstallAtFuncPtr(static_cast<GetNpadStateFullKeyFn>(&nn::hid::GetNpadState));
         HidGetNpadStateHandheldHook::InstallAtFuncPtr(static_cast<GetNpadStateHandheldFn>(&nn::hid::GetNpadState));
         HidGetNpadStateJoyDualHook::InstallAtFuncPtr(static_cast<GetNpadStateJoyDualFn>(&nn::hid::GetNpadState));
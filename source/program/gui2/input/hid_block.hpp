@@ -8,12 +8,16 @@ namespace d3::gui2::input::hid_block {
     void SetAllowLeftStickPassthrough(bool allow);
 
     // RAII: while held, the calling thread is allowed to query hid state even if input is blocked.
-    // Used by the overlay when sampling gamepad state for swipe/toggle detection.
+    // Nestable and per-thread; several threads may hold one concurrently.
+    // Held once per frame by input::Sample(), which gathers all overlay HID reads.
     struct ScopedHidPassthroughForOverlay {
         ScopedHidPassthroughForOverlay();
         ~ScopedHidPassthroughForOverlay();
 
         ScopedHidPassthroughForOverlay(const ScopedHidPassthroughForOverlay &)            = delete;
         ScopedHidPassthroughForOverlay &operator=(const ScopedHidPassthroughForOverlay &) = delete;
+
+       private:
+        bool engaged_ = false;
     };
 }  // namespace d3::gui2::input::hid_block
@@ -0,0 +1,136 @@
+#include "program/gui2/input/input_snapshot.hpp"
+
+#include <cstdlib>
+
+#include "program/gui2/input/hid_block.hpp"
+
+namespace d3::gui2::input {
+    namespace {
+        InputSnapshot g_snapshot {};
+        bool          g_touch_init_tried    = false;
+        bool          g_mouse_init_tried    = false;
+        bool          g_keyboard_init_tried = false;
+
+        static auto ReadNpad(NpadCombinedState &out, uint port) -> bool {
+            out = {};
+
+            auto consider_stick = [](bool &have, nn::hid::AnalogStickState &dst, const nn::hid::AnalogStickState &src) -> void {
+                const auto mag     = static_cast<u64>(std::abs(src.X)) + static_cast<u64>(std::abs(src.Y));
+                const auto dst_mag = static_cast<u64>(std::abs(dst.X)) + static_cast<u64>(std::abs(dst.Y));
+                if (!have || mag > dst_mag) {
+                    dst  = src;
+                    have = true;
+                }
+            };
+
+            auto accumulate = [&](const nn::hid::NpadBaseState &state) -> void {
+                out.buttons |= state.mButtons.field[0];
+                consider_stick(out.have_stick_l, out.stick_l, state.mAnalogStickL);
+                consider_stick(out.have_stick_r, out.stick_r, state.mAnalogStickR);
+            };
+
+            constexpr uint              kHandheldPort = 0x20;
+            const nn::hid::NpadStyleSet style         = nn::hid::GetNpadStyleSet(port);
+            bool                        read_any      = false;
+
+            if (style.isBitSet(nn::hid::NpadStyleTag::NpadStyleFullKey)) {
+                nn::hid::NpadFullKeyState full {};
+                nn::hid::GetNpadState(&full, port);
+                accumulate(full);
+                read_any = true;
+            }
+            if (style.isBitSet(nn::hid::NpadStyleTag::NpadStyleJoyDual)) {
+                nn::hid::NpadJoyDualState joy_dual {};
+                nn::hid::GetNpadState(&joy_dual, port);
+                accumulate(joy_dual);
+                read_any = true;
+            }
+            if (style.isBitSet(nn::hid::NpadStyleTag::NpadStyleJoyLeft)) {
+                nn::hid::NpadJoyLeftState joy_left {};
+                nn::hid::GetNpadState(&joy_left, port);
+                accumulate(joy_left);
+                read_any = true;
+            }
+            if (style.isBitSet(nn::hid::NpadStyleTag::NpadStyleJoyRight)) {
+                nn::hid::NpadJoyRightState joy_right {};
+                nn::hid::GetNpadState(&joy_right, port);
+                accumulate(joy_right);
+                read_any = true;
+            }
+
+            if (style.isBitSet(nn::hid::NpadStyleTag::NpadStyleHandheld) || !read_any) {
+                nn::hid::NpadHandheldState handheld {};
+                nn::hid::GetNpadState(&handheld, kHandheldPort);
+                accumulate(handheld);
+                read_any = true;
+            }
+
+            return out.buttons != 0 || out.have_stick_l || out.have_stick_r;
+        }
+
+        static void ReadTouch(InputSnapshot &out) {
+            if (!g_touch_init_tried) {
+                g_touch_init_tried = true;
+                nn::hid::InitializeTouchScreen();
+            }
+
+            nn::hid::TouchScreenState<nn::hid::TouchStateCountMax> st {};
+            nn::hid::GetTouchScreenState(&st);
+
+            out.touch_sampled = true;
+            out.touch_count   = st.count;
+            if (st.count > 0) {
+                out.touch_x = st.touches[0].x;
+                out.touch_y = st.touches[0].y;
+            }
+        }
+
+        static void ReadMouse(InputSnapshot &out) {
+            if (!g_mouse_init_tried) {
+                g_mouse_init_tried = true;
+                nn::hid::InitializeMouse();
+            }
+            nn::hid::GetMouseState(&out.mouse);
+            out.mouse_sampled = true;
+        }
+
+        static void ReadKeyboard(InputSnapshot &out) {
+            if (!g_keyboard_init_tried) {
+                g_keyboard_init_tried = true;
+                nn::hid::InitializeKeyboard();
+            }
+            nn::hid::GetKeyboardState(&out.keyboard);
+            out.keyboard_sampled = true;
+        }
+    }  // namespace
+
+    auto Sample(const SampleRequest &request) -> const InputSnapshot & {
+        InputSnapshot next {};
+        next.frame = g_snapshot.frame + 1;
+
+        {
+            // One scope for the whole frame: our own HID hooks let these reads
+            // through even while the game's input is blocked.
+            hid_block::ScopedHidPassthroughForOverlay const passthrough_guard;
+
+            next.npad_valid = ReadNpad(next.npad, 0);
+            if (request.touch) {
+                ReadTouch(next);
+            }
+            if (request.mouse) {
+                ReadMouse(next);
+            }
+            if (request.keyboard) {
+                ReadKeyboard(next);
+            }
+        }
+
+        g_snapshot = next;
+        return g_snapshot;
+    }
+
+    auto Current() -> const InputSnapshot & {
+        return g_snapshot;
+    }
+
+}  // namespace d3::gui2::input
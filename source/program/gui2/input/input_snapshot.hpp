@@ -0,0 +1,54 @@
+#pragma once
+
+#include "nn/hid.hpp"  // IWYU pragma: keep
+#include "types.h"
+
+namespace d3::gui2::input {
+
+    // All npad styles on a port folded together: buttons OR-ed, sticks take the
+    // largest deflection.
+    struct NpadCombinedState {
+        u64                       buttons = 0;
+        nn::hid::AnalogStickState stick_l {};
+        nn::hid::AnalogStickState stick_r {};
+        bool                      have_stick_l = false;
+        bool                      have_stick_r = false;
+    };
+
+    // One present's worth of HID state, read once and shared by the overlay
+    // (ImGui input, toggle chord, swipe) so no consumer re-queries nn::hid.
+    struct InputSnapshot {
+        u32 frame = 0;  // incremented per Sample(); 0 = never sampled
+
+        NpadCombinedState npad {};
+        bool              npad_valid = false;
+
+        bool touch_sampled = false;
+        s32  touch_count   = 0;
+        s32  touch_x       = 0;  // first touch, 1280x720 space
+        s32  touch_y       = 0;
+
+        bool                mouse_sampled = false;
+        nn::hid::MouseState mouse {};
+
+        bool                   keyboard_sampled = false;
+        nn::hid::KeyboardState keyboard {};
+    };
+
+    // Sources beyond the npad that this frame needs; unrequested ones are left
+    // cleared and marked not sampled.
+    struct SampleRequest {
+        bool touch    = false;
+        bool mouse    = false;
+        bool keyboard = false;
+    };
+
+    // Reads every requested source under a single hid_block passthrough scope,
+    // lazily initializing touch/mouse/keyboard on first use. Call once per frame
+    // from the present thread.
+    auto Sample(const SampleRequest &request) -> const InputSnapshot &;
+
+    // Last snapshot taken by Sample().
+    auto Current() -> const InputSnapshot &;
+
+}  // namespace d3::gui2::input
@@ -47,8 +47,9 @@ namespace d3::gui2::memory::imgui_alloc {
                 if (R_SUCCEEDED(rc) && addr != 0) {
                     g_imgui_malloc = reinterpret_cast<ImGuiMallocFn>(addr);
                 } else {
-                    if (d3::log_once::ShouldLog("imgui_alloc.malloc_missing")) {
-                        PRINT("[imgui_alloc] ERROR: nn::ro::LookupSymbol(malloc) failed (rc=0x%x addr=0x%lx)", rc, addr);
+                    // Retried every present until it resolves; sample instead of logging once.
+                    if (const auto verdict = d3::log_once::Check("imgui_alloc.malloc_missing", d3::log_once::kSampled)) {
+                        PRINT("[imgui_alloc] ERROR: nn::ro::LookupSymbol(malloc) failed (rc=0x%x addr=0x%lx, +%u suppressed)", rc, addr, verdict.suppressed);
                     }
                 }
             }
@@ -61,8 +62,8 @@ namespace d3::gui2::memory::imgui_alloc {
                 if (R_SUCCEEDED(rc) && addr != 0) {
                     g_imgui_free = reinterpret_cast<ImGuiFreeFn>(addr);
                 } else {
-                    if (d3::log_once::ShouldLog("imgui_alloc.free_missing")) {
-                        PRINT("[imgui_alloc] ERROR: nn::ro::LookupSymbol(free) failed (rc=0x%x addr=0x%lx)", rc, addr);
+                    if (const auto verdict = d3::log_once::Check("imgui_alloc.free_missing", d3::log_once::kSampled)) {
+                        PRINT("[imgui_alloc] ERROR: nn::ro::LookupSymbol(free) failed (rc=0x%x addr=0x%lx, +%u suppressed)", rc, addr, verdict.suppressed);
                     }
                 }
             }
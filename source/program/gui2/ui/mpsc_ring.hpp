@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "types.h"
+
+namespace d3::gui2::ui {
+
+    // Bounded multi-producer / single-consumer ring with inline storage
+    // (Vyukov-style per-slot sequence numbers). A producer claims a slot with one
+    // CAS on the tail and fills it in place; when the ring is full the push is
+    // rejected and counted instead of blocking or allocating. The consumer side
+    // is not thread-safe and must stay on one thread.
+    template <typename T, size_t N>
+    class MpscRing {
+        static_assert(N >= 2 && (N & (N - 1)) == 0, "MpscRing capacity must be a power of two");
+
+       public:
+        MpscRing() {
+            for (size_t i = 0; i < N; ++i) {
+                slots_[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscRing(const MpscRing &)            = delete;
+        MpscRing &operator=(const MpscRing &) = delete;
+
+        // `fill(T &)` runs at most once, after the slot is owned by this producer.
+        template <typename Fill>
+        auto TryPush(Fill &&fill) -> bool {
+            size_t pos = tail_.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot          &slot = slots_[pos & (N - 1)];
+                const size_t   seq  = slot.seq.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        fill(slot.value);
+                        slot.seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                } else {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Consumer only. `consume(T &)` may move out of the slot.
+        template <typename Consume>
+        auto TryPop(Consume &&consume) -> bool {
+            Slot &slot = slots_[head_ & (N - 1)];
+            if (slot.seq.load(std::memory_order_acquire) != head_ + 1) {
+                return false;
+            }
+            consume(slot.value);
+            slot.seq.store(head_ + N, std::memory_order_release);
+            ++head_;
+            return true;
+        }
+
+        auto dropped() const -> u32 { return dropped_.load(std::memory_order_relaxed); }
+        static constexpr auto capacity() -> size_t { return N; }
+
+       private:
+        struct Slot {
+            std::atomic<size_t> seq {0};
+            T                   value {};
+        };
+
+        std::array<Slot, N>             slots_ {};
+        alignas(64) std::atomic<size_t> tail_ {0};
+        alignas(64) size_t              head_ = 0;
+        std::atomic<u32>                dropped_ {0};
+    };
+
+}  // namespace d3::gui2::ui
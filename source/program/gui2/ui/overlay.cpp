@@ -5,6 +5,7 @@
 #include <cstdio>
 #include <cstring>
 #include <string_view>
+#include <utility>
 
 #include "imgui/imgui.h"
 
@@ -14,13 +15,18 @@
 #include "program/d3/types/common.hpp"
 #include "program/d3/types/enums.hpp"
 #include "program/build_stamp.hpp"
+#include "program/frame_timing.hpp"
 #include "program/fs_util.hpp"
+#include "program/hook_trace.hpp"
+#include "program/sampling_profiler.hpp"
 #include "program/system_allocator.hpp"
 #include "nn/fs.hpp"  // IWYU pragma: keep
 #include "symbols/common.hpp"
 #include "tomlplusplus/toml.hpp"
 
+#include "program/gui2/ui/windows/attribute_inspector_window.hpp"
 #include "program/gui2/ui/windows/config_window.hpp"
+#include "program/gui2/ui/windows/frame_timing_window.hpp"
 #include "program/gui2/ui/windows/notifications_window.hpp"
 
 namespace d3::gui2::ui {
@@ -81,7 +87,7 @@ namespace d3::gui2::ui {
             return NormalizeLocale(locale_str);
         }
 
-        static void FlattenTomlStrings(const toml::node &node, std::string &prefix, std::unordered_map<std::string, std::string> &out) {
+        static void FlattenTomlStrings(const toml::node &node, std::string &prefix, TranslationTable &out) {
             if (node.is_table()) {
                 const auto *tbl = node.as_table();
                 tbl->for_each([&](const toml::key &k, const toml::node &v) -> void {
@@ -101,7 +107,7 @@ namespace d3::gui2::ui {
 
             if (auto s = node.value<std::string>()) {
                 if (!prefix.empty()) {
-                    out[prefix] = *s;
+                    out.Add(prefix, *s);
                 }
                 return;
             }
@@ -372,18 +378,33 @@ namespace d3::gui2::ui {
             return fallback != nullptr ? fallback : "";
         }
 
-        EnsureTranslationsLoaded();
-
+        // UpdateFrame re-checks the language once per frame; only load here for
+        // lookups that happen before the first frame.
         if (!translations_loaded_) {
-            return fallback;
+            EnsureTranslationsLoaded();
+            if (!translations_loaded_) {
+                return fallback;
+            }
         }
 
-        auto it = translations_.find(key);
-        if (it == translations_.end()) {
-            return fallback;
-        }
+        const char *text = translations_.Find(key);
+        return text != nullptr ? text : fallback;
+    }
 
-        return it->second.c_str();
+    void Overlay::DumpMenuItem(const char *key, const char *fallback, const char *path, DumpFn dump) {
+        if (!ImGui::MenuItem(tr(key, fallback))) {
+            return;
+        }
+        std::string error;
+        const bool  ok = dump(path, error);
+        if (notifications_window_ == nullptr) {
+            return;
+        }
+        if (ok) {
+            notifications_window_->AddNotification(ImVec4(0.3f, 1.0f, 0.3f, 1.0f), 4.0f, tr("gui.notify_dump_saved", "Saved %s"), path);
+        } else {
+            notifications_window_->AddNotification(ImVec4(1.0f, 0.4f, 0.3f, 1.0f), 6.0f, tr("gui.notify_dump_failed", "Dump failed: %s"), error.c_str());
+        }
     }
 
     auto Overlay::translations_metadata() -> const std::vector<TranslationLanguage> & {
@@ -395,12 +416,19 @@ namespace d3::gui2::ui {
         if (!translations_loaded_) {
             return;
         }
-        for (auto const &[k, v] : translations_) {
-            (void)k;
-            if (!v.empty()) {
-                builder.AddText(v.c_str());
+        if (const auto glyphs = translations_.glyphs(); !glyphs.empty()) {
+            for (const u32 cp : glyphs) {
+                if (cp <= IM_UNICODE_CODEPOINT_MAX) {
+                    builder.AddChar(static_cast<ImWchar>(cp));
+                }
             }
+            return;
         }
+        translations_.ForEachValue([&](const char *text) -> void {
+            if (text[0] != '\0') {
+                builder.AddText(text);
+            }
+        });
     }
 
     Window *Overlay::RegisterWindow(std::unique_ptr<Window> window, WindowLayer layer) {
@@ -445,6 +473,9 @@ namespace d3::gui2::ui {
             RegisterWindow(std::move(config), WindowLayer::Dock)
         );
 
+        RegisterWindow(std::make_unique<windows::AttributeInspectorWindow>(*this), WindowLayer::Dock);
+        RegisterWindow(std::make_unique<windows::FrameTimingWindow>(*this), WindowLayer::Overlay);
+
         windows_initialized_ = true;
     }
 
@@ -485,20 +516,36 @@ namespace d3::gui2::ui {
             return;
         }
 
-        translations_.clear();
+        translations_.Clear();
         translations_lang_   = desired_lang;
         translations_loaded_ = false;
+        ++translations_revision_;
 
         if (translations_lang_ == "en") {
             translations_loaded_ = true;
             return;
         }
 
+        // Prefer the precompiled bundle (tools/build_translation_bundles.py): one read, used in place.
         std::string path = "romfs:/d3gui/strings_";
         path += translations_lang_;
-        path += ".toml";
+        path += ".d3tr";
 
         std::string text;
+        if (d3::romfs::ReadFileToString(path.c_str(), text, 512 * 1024)) {
+            const size_t bytes = text.size();
+            if (translations_.LoadBundle(std::move(text))) {
+                translations_loaded_ = true;
+                PRINT("[gui] translations loaded: lang=%s keys=%u bundle=%u bytes", translations_lang_.c_str(), static_cast<unsigned>(translations_.size()), static_cast<unsigned>(bytes));
+                return;
+            }
+            PRINT("[gui] translation bundle invalid: %s; falling back to TOML", path.c_str());
+            text.clear();
+        }
+
+        path.resize(path.size() - 5);
+        path += ".toml";
+
         if (!d3::romfs::ReadFileToString(path.c_str(), text, 512 * 1024)) {
             PRINT("[gui] translations missing: %s (lang=%s)", path.c_str(), translations_lang_.c_str());
             translations_loaded_ = true;
@@ -516,6 +563,7 @@ namespace d3::gui2::ui {
 
         std::string prefix;
         FlattenTomlStrings(result.table(), prefix, translations_);
+        translations_.Finalize();
         translations_loaded_ = true;
         PRINT("[gui] translations loaded: lang=%s keys=%u", translations_lang_.c_str(), static_cast<unsigned>(translations_.size()));
     }
@@ -786,6 +834,16 @@ namespace d3::gui2::ui {
                                 notifications_window_->Clear();
                             }
                         }
+                        DumpMenuItem("gui.tool_dump_frame_trace", "Dump frame trace", d3::frame_timing::kTracePath, &d3::frame_timing::DumpCsv);
+                        if (d3::sampling_profiler::Running()) {
+                            DumpMenuItem("gui.tool_dump_profile", "Dump profile", d3::sampling_profiler::kFoldedPath, &d3::sampling_profiler::DumpFolded);
+                            if (ImGui::MenuItem(tr("gui.tool_reset_profile", "Reset profile"))) {
+                                d3::sampling_profiler::Reset();
+                            }
+                        }
+                        if (d3::hook_trace::Active()) {
+                            DumpMenuItem("gui.tool_dump_hook_trace", "Dump hook trace", d3::hook_trace::kTracePath, &d3::hook_trace::DumpTrace);
+                        }
                         ImGui::Separator();
                         if (ImGui::MenuItem(tr("gui.menu_reset_layout", "Reset layout"))) {
                             s_reset_layout_pop = true;
@@ -2,10 +2,10 @@
 
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "program/config.hpp"
+#include "program/gui2/ui/translation_table.hpp"
 #include "program/gui2/ui/window.hpp"
 
 struct ImFontGlyphRangesBuilder;
@@ -80,6 +80,8 @@ namespace d3::gui2::ui {
         // Translation helper: returns a localized string when available, otherwise returns fallback.
         const char                             *tr(const char *key, const char *fallback);
         const std::string                      &translations_lang() const { return translations_lang_; }
+        // Bumped on every translation reload; pointers returned by tr() are stable until it changes.
+        u32                                     translations_revision() const { return translations_revision_; }
         void                                    AppendTranslationGlyphs(ImFontGlyphRangesBuilder &builder) const;
         const std::vector<TranslationLanguage> &translations_metadata();
 
@@ -123,7 +125,12 @@ namespace d3::gui2::ui {
 
        protected:
        private:
+        using DumpFn = bool (*)(const char *path, std::string &error_out);
+
         void           EnsureTranslationsMetadataLoaded();
+        // Tools-menu item that writes a diagnostics dump to `path` and reports the
+        // outcome as a notification.
+        void           DumpMenuItem(const char *key, const char *fallback, const char *path, DumpFn dump);
         FrameDebugInfo frame_debug_ {};
 
         GuiFocusState focus_ {};
@@ -137,11 +144,12 @@ namespace d3::gui2::ui {
         Window *focus_window_                 = nullptr;
         bool    allow_left_stick_passthrough_ = false;
 
-        std::string                                  translations_lang_ {};
-        bool                                         translations_loaded_ = false;
-        std::unordered_map<std::string, std::string> translations_ {};
-        bool                                         translations_metadata_loaded_ = false;
-        std::vector<TranslationLanguage>             translations_metadata_ {};
+        std::string                      translations_lang_ {};
+        bool                             translations_loaded_   = false;
+        u32                              translations_revision_ = 0;
+        TranslationTable                 translations_ {};
+        bool                             translations_metadata_loaded_ = false;
+        std::vector<TranslationLanguage> translations_metadata_ {};
 
         bool                                 windows_initialized_ = false;
         std::vector<std::unique_ptr<Window>> windows_ {};
@@ -0,0 +1,359 @@
+#include "program/gui2/ui/theme_overrides.hpp"
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "nn/fs.hpp"  // IWYU pragma: keep
+#include "nn/os.hpp"  // IWYU pragma: keep
+#include "program/gui2/ui/overlay.hpp"
+#include "program/log_once.hpp"
+#include "program/logging.hpp"
+#include "program/romfs_assets.hpp"
+#include "tomlplusplus/toml.hpp"
+
+#include "imgui/imgui.h"
+
+namespace d3::gui2::ui::theme_overrides {
+    namespace {
+        constexpr size_t kMaxThemeFileBytes = 64 * 1024;
+        constexpr s64    kPollIntervalMs    = 2000;
+        constexpr size_t kPollStackSize     = 0x8000;
+        constexpr size_t kThemeCount        = 2;
+
+        struct ColorKey {
+            const char *name;  // normalized: lowercase, no separators, no "imguicol" prefix
+            ImGuiCol    col;
+        };
+
+        constexpr std::array kColorKeys = {
+            ColorKey {"text", ImGuiCol_Text},
+            ColorKey {"textdisabled", ImGuiCol_TextDisabled},
+            ColorKey {"windowbg", ImGuiCol_WindowBg},
+            ColorKey {"popupbg", ImGuiCol_PopupBg},
+            ColorKey {"border", ImGuiCol_Border},
+            ColorKey {"framebg", ImGuiCol_FrameBg},
+            ColorKey {"framebghovered", ImGuiCol_FrameBgHovered},
+            ColorKey {"framebgactive", ImGuiCol_FrameBgActive},
+            ColorKey {"titlebg", ImGuiCol_TitleBg},
+            ColorKey {"titlebgactive", ImGuiCol_TitleBgActive},
+            ColorKey {"menubarbg", ImGuiCol_MenuBarBg},
+            ColorKey {"checkmark", ImGuiCol_CheckMark},
+            ColorKey {"slidergrab", ImGuiCol_SliderGrab},
+            ColorKey {"slidergrabactive", ImGuiCol_SliderGrabActive},
+            ColorKey {"button", ImGuiCol_Button},
+            ColorKey {"buttonhovered", ImGuiCol_ButtonHovered},
+            ColorKey {"buttonactive", ImGuiCol_ButtonActive},
+            ColorKey {"header", ImGuiCol_Header},
+            ColorKey {"headerhovered", ImGuiCol_HeaderHovered},
+            ColorKey {"headeractive", ImGuiCol_HeaderActive},
+            ColorKey {"separator", ImGuiCol_Separator},
+            ColorKey {"separatorhovered", ImGuiCol_SeparatorHovered},
+            ColorKey {"separatoractive", ImGuiCol_SeparatorActive},
+            ColorKey {"tab", ImGuiCol_Tab},
+            ColorKey {"tabhovered", ImGuiCol_TabHovered},
+            ColorKey {"tabselected", ImGuiCol_TabSelected},
+            ColorKey {"textselectedbg", ImGuiCol_TextSelectedBg},
+            ColorKey {"navcursor", ImGuiCol_NavCursor},
+            ColorKey {"navwindowinghighlight", ImGuiCol_NavWindowingHighlight},
+        };
+
+        struct ParsedTheme {
+            std::bitset<ImGuiCol_COUNT>         mask {};
+            std::array<ImVec4, ImGuiCol_COUNT> colors {};
+        };
+
+        // File identity the cached parse came from; size == -1 means "no file".
+        struct FileKey {
+            s64 size = -1;
+            u64 hash = 0;
+
+            auto operator==(const FileKey &) const -> bool = default;
+        };
+
+        struct CacheEntry {
+            FileKey     key {};
+            ParsedTheme theme {};
+        };
+
+        nn::os::Mutex                       g_mutex {};
+        std::array<CacheEntry, kThemeCount> g_cache {};
+        std::atomic<u32>                    g_generation {0};
+        bool                                g_started = false;
+        nn::os::ThreadType                  g_poll_thread {};
+        nn::os::EventType                   g_poll_wake {};
+        std::atomic<bool>                   g_polling {false};  // overlay visible
+        std::atomic<bool>                   g_reload {false};   // re-read every file on the next pass
+        std::atomic<bool>                   g_poll_running {false};
+
+        alignas(0x1000) std::array<u8, kPollStackSize> g_poll_stack {};
+
+        static auto ThemeIndex(GuiTheme theme) -> size_t {
+            return theme == GuiTheme::Blueish ? 1 : 0;
+        }
+
+        static auto ThemeStem(size_t index) -> const char * {
+            return index == 1 ? "blueish" : "d3";
+        }
+
+        static auto NormalizeThemeKey(std::string_view input) -> std::string {
+            std::string out;
+            out.reserve(input.size());
+            for (const char ch : input) {
+                const unsigned char uch = static_cast<unsigned char>(ch);
+                if (std::isspace(uch) || ch == '_' || ch == '-') {
+                    continue;
+                }
+                out.push_back(static_cast<char>(std::tolower(uch)));
+            }
+            if (out.rfind("imguicol", 0) == 0) {
+                out.erase(0, std::strlen("imguicol"));
+            }
+            return out;
+        }
+
+        static auto ParseHexNibble(char ch, u8 &out) -> bool {
+            if (ch >= '0' && ch <= '9') {
+                out = static_cast<u8>(ch - '0');
+                return true;
+            }
+            if (ch >= 'a' && ch <= 'f') {
+                out = static_cast<u8>(10 + (ch - 'a'));
+                return true;
+            }
+            if (ch >= 'A' && ch <= 'F') {
+                out = static_cast<u8>(10 + (ch - 'A'));
+                return true;
+            }
+            return false;
+        }
+
+        static auto ParseHexColor(std::string_view s, ImVec4 &out) -> bool {
+            if (s.empty()) {
+                return false;
+            }
+            if (s.front() == '#') {
+                s.remove_prefix(1);
+            }
+            if (s.size() != 6 && s.size() != 8) {
+                return false;
+            }
+
+            auto parse_byte = [&](size_t i, u8 &b) -> bool {
+                u8 hi = 0;
+                u8 lo = 0;
+                if (!ParseHexNibble(s[i], hi) || !ParseHexNibble(s[i + 1], lo)) {
+                    return false;
+                }
+                b = static_cast<u8>((hi << 4) | lo);
+                return true;
+            };
+
+            u8 r = 0, g = 0, b = 0, a = 0xFF;
+            if (!parse_byte(0, r) || !parse_byte(2, g) || !parse_byte(4, b)) {
+                return false;
+            }
+            if (s.size() == 8) {
+                if (!parse_byte(6, a)) {
+                    return false;
+                }
+            }
+
+            out = ImVec4(
+                static_cast<float>(r) / 255.0f,
+                static_cast<float>(g) / 255.0f,
+                static_cast<float>(b) / 255.0f,
+                static_cast<float>(a) / 255.0f
+            );
+            return true;
+        }
+
+        // -1 when the file is missing or unreadable (same as FileKey's "no file").
+        static auto FileSize(const char *path) -> s64 {
+            nn::fs::FileHandle fh {};
+            if (R_FAILED(nn::fs::OpenFile(&fh, path, nn::fs::OpenMode_Read))) {
+                return -1;
+            }
+            s64 size = 0;
+            if (R_FAILED(nn::fs::GetFileSize(&size, fh))) {
+                size = -1;
+            }
+            nn::fs::CloseFile(fh);
+            return size;
+        }
+
+        static auto HashText(std::string_view text) -> u64 {
+            u64 hash = 14695981039346656037ull;
+            for (const char c : text) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        static auto ParseTheme(const std::string &text, std::string_view path, ParsedTheme &out) -> bool {
+            out = ParsedTheme {};
+
+            auto result = toml::parse(text, path);
+            if (!result) {
+                if (d3::log_once::ShouldLog("gui.theme_override.parse_failed")) {
+                    const auto &err = result.error();
+                    PRINT("[gui] theme override parse failed: %s", std::string(err.description()).c_str());
+                }
+                return false;
+            }
+
+            const toml::table *colors = nullptr;
+            if (auto node = result.table().get("colors"); node && node->is_table()) {
+                colors = node->as_table();
+            }
+            if (colors == nullptr) {
+                return false;
+            }
+
+            colors->for_each([&](const toml::key &k, const toml::node &node) -> void {
+                auto v = node.value<std::string>();
+                if (!v) {
+                    return;
+                }
+                ImVec4 color {};
+                if (!ParseHexColor(*v, color)) {
+                    return;
+                }
+                const std::string normalized = NormalizeThemeKey(std::string_view {k.str()});
+                for (const ColorKey &entry : kColorKeys) {
+                    if (normalized == entry.name) {
+                        out.mask.set(static_cast<size_t>(entry.col));
+                        out.colors[static_cast<size_t>(entry.col)] = color;
+                        break;
+                    }
+                }
+            });
+            return out.mask.any();
+        }
+
+        // Refreshes one theme's cache entry when the file changed. A poll only
+        // stats the file; the content is read and hashed when the size moved or
+        // `force` is set. Returns true when the cached colors changed.
+        static auto RefreshTheme(size_t index, bool force) -> bool {
+            char path[96] {};
+            snprintf(path, sizeof(path), "sd:/config/d3hack-nx/themes/%s.toml", ThemeStem(index));
+
+            if (!force) {
+                const s64        size = FileSize(path);
+                std::scoped_lock lock(g_mutex);
+                if (g_cache[index].key.size == size) {
+                    return false;
+                }
+            }
+
+            FileKey     key {};
+            std::string text;
+            if (d3::romfs::ReadFileToString(path, text, kMaxThemeFileBytes)) {
+                key.size = static_cast<s64>(text.size());
+                key.hash = HashText(text);
+            }
+
+            {
+                std::scoped_lock lock(g_mutex);
+                if (g_cache[index].key == key) {
+                    return false;
+                }
+            }
+
+            // Parse outside the lock; Apply() on the present thread never waits on toml++.
+            ParsedTheme parsed {};
+            if (key.size >= 0) {
+                ParseTheme(text, path, parsed);
+            }
+
+            std::scoped_lock lock(g_mutex);
+            g_cache[index].key   = key;
+            g_cache[index].theme = parsed;
+            if (parsed.mask.any()) {
+                PRINT("[gui] theme overrides loaded: %s (%u colors)", path, static_cast<unsigned>(parsed.mask.count()))
+            }
+            return true;
+        }
+
+        static auto RefreshAll(bool force) -> bool {
+            bool changed = false;
+            for (size_t i = 0; i < kThemeCount; ++i) {
+                changed |= RefreshTheme(i, force);
+            }
+            return changed;
+        }
+
+        // Polls only while the overlay is visible; hidden, the thread blocks
+        // until SetPolling() wakes it. Showing the overlay forces a full
+        // re-read, which also catches edits that kept the file size.
+        static void PollThreadMain(void *) {
+            for (;;) {
+                const bool force = g_reload.exchange(false, std::memory_order_acq_rel);
+                if ((force || g_polling.load(std::memory_order_acquire)) && RefreshAll(force)) {
+                    g_generation.fetch_add(1, std::memory_order_release);
+                }
+                if (g_polling.load(std::memory_order_acquire)) {
+                    (void)nn::os::TimedWaitEvent(&g_poll_wake, nn::TimeSpan::FromMilliSeconds(kPollIntervalMs));
+                } else {
+                    nn::os::WaitEvent(&g_poll_wake);
+                }
+            }
+        }
+    }  // namespace
+
+    void Start() {
+        if (g_started) {
+            return;
+        }
+        g_started = true;
+        RefreshAll(true);
+
+        nn::os::InitializeEvent(&g_poll_wake, false, nn::os::EventClearMode_AutoClear);
+        const Result rc = nn::os::CreateThread(&g_poll_thread, PollThreadMain, nullptr, g_poll_stack.data(), g_poll_stack.size(), nn::os::LowestThreadPriority);
+        if (R_FAILED(rc)) {
+            PRINT("[gui] theme override poll thread not started (rc=0x%x); overrides load once", rc)
+            return;
+        }
+        nn::os::SetThreadNamePointer(&g_poll_thread, "d3hack.theme_poll");
+        nn::os::StartThread(&g_poll_thread);
+        g_poll_running.store(true, std::memory_order_release);
+    }
+
+    void SetPolling(bool active) {
+        if (g_polling.exchange(active, std::memory_order_acq_rel) == active) {
+            return;
+        }
+        if (active) {
+            g_reload.store(true, std::memory_order_release);
+        }
+        if (g_poll_running.load(std::memory_order_acquire)) {
+            nn::os::SignalEvent(&g_poll_wake);
+        }
+    }
+
+    auto Apply(ImGuiStyle &style, GuiTheme theme) -> bool {
+        std::scoped_lock   lock(g_mutex);
+        const ParsedTheme &parsed = g_cache[ThemeIndex(theme)].theme;
+        if (parsed.mask.none()) {
+            return false;
+        }
+        for (size_t i = 0; i < parsed.colors.size(); ++i) {
+            if (parsed.mask.test(i)) {
+                style.Colors[i] = parsed.colors[i];
+            }
+        }
+        return true;
+    }
+
+    auto Generation() -> u32 {
+        return g_generation.load(std::memory_order_acquire);
+    }
+
+}  // namespace d3::gui2::ui::theme_overrides
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "types.h"
+
+struct ImGuiStyle;
+
+namespace d3::gui2::ui {
+    enum class GuiTheme;
+}  // namespace d3::gui2::ui
+
+namespace d3::gui2::ui::theme_overrides {
+
+    // Color overrides from sd:/config/d3hack-nx/themes/<theme>.toml, parsed once
+    // into a compact per-theme color table. While the overlay is visible a
+    // low-priority thread checks the file sizes every few seconds and re-reads
+    // a file only when its size changed; showing the overlay re-reads them all.
+    // Applying a theme on the present thread is a masked array copy.
+
+    // Loads the current files synchronously (first call only), then starts the poll thread.
+    void Start();
+
+    // Overlay visibility, once per frame. Hidden stops polling; a hidden-to-
+    // visible transition queues a full reload.
+    void SetPolling(bool active);
+
+    // Copies the cached override colors for `theme` into `style`. No file I/O.
+    // Returns true when at least one color was overridden.
+    auto Apply(ImGuiStyle &style, GuiTheme theme) -> bool;
+
+    // Bumped whenever any cached theme changes; callers re-apply styles on change.
+    auto Generation() -> u32;
+
+}  // namespace d3::gui2::ui::theme_overrides
@@ -0,0 +1,157 @@
+#include "program/gui2/ui/translation_table.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace d3::gui2::ui {
+
+    void TranslationTable::ResetViews() {
+        index_       = nullptr;
+        glyphs_      = nullptr;
+        pool_        = nullptr;
+        count_       = 0;
+        glyph_count_ = 0;
+        cache_.fill(CacheEntry {});
+    }
+
+    void TranslationTable::Clear() {
+        ResetViews();
+        blob_.clear();
+        blob_.shrink_to_fit();
+        staged_.clear();
+    }
+
+    void TranslationTable::Add(std::string_view key, std::string_view value) {
+        staged_.emplace_back(std::string(key), std::string(value));
+    }
+
+    void TranslationTable::Finalize() {
+        // Later duplicates win, matching the old map assignment.
+        std::stable_sort(staged_.begin(), staged_.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+        std::vector<std::pair<std::string, std::string>> unique;
+        unique.reserve(staged_.size());
+        for (auto &kv : staged_) {
+            if (!unique.empty() && unique.back().first == kv.first) {
+                unique.back().second = std::move(kv.second);
+            } else {
+                unique.push_back(std::move(kv));
+            }
+        }
+        staged_.clear();
+        staged_.shrink_to_fit();
+
+        std::vector<IndexEntry> index;
+        index.reserve(unique.size());
+        std::string pool;
+        for (const auto &[key, value] : unique) {
+            IndexEntry entry {};
+            entry.hash       = HashKey(key);
+            entry.key_offset = static_cast<uint32_t>(pool.size());
+            pool.append(key);
+            pool.push_back('\0');
+            entry.value_offset = static_cast<uint32_t>(pool.size());
+            pool.append(value);
+            pool.push_back('\0');
+            index.push_back(entry);
+        }
+        std::sort(index.begin(), index.end(), [](const IndexEntry &a, const IndexEntry &b) { return a.hash < b.hash; });
+
+        Header header {};
+        std::memcpy(header.magic, kMagic.data(), sizeof(header.magic));
+        header.version      = kVersion;
+        header.entry_count  = static_cast<uint32_t>(index.size());
+        header.glyph_count  = 0;
+        header.index_offset = sizeof(Header);
+        header.glyph_offset = header.index_offset + static_cast<uint32_t>(index.size() * sizeof(IndexEntry));
+        header.pool_offset  = header.glyph_offset;
+        header.pool_size    = static_cast<uint32_t>(pool.size());
+
+        std::string blob;
+        blob.reserve(header.pool_offset + pool.size());
+        blob.append(reinterpret_cast<const char *>(&header), sizeof(header));
+        blob.append(reinterpret_cast<const char *>(index.data()), index.size() * sizeof(IndexEntry));
+        blob.append(pool);
+        LoadBundle(std::move(blob));
+    }
+
+    auto TranslationTable::LoadBundle(std::string &&blob) -> bool {
+        ResetViews();
+        blob_ = std::move(blob);
+
+        Header header {};
+        const size_t size = blob_.size();
+        if (size < sizeof(Header)) {
+            blob_.clear();
+            return false;
+        }
+        std::memcpy(&header, blob_.data(), sizeof(header));
+
+        const auto in_bounds = [size](uint64_t offset, uint64_t length) -> bool {
+            return offset <= size && length <= size - offset;
+        };
+        const bool valid =
+            std::memcmp(header.magic, kMagic.data(), sizeof(header.magic)) == 0 &&
+            header.version == kVersion &&
+            header.index_offset % alignof(IndexEntry) == 0 &&
+            header.glyph_offset % alignof(uint32_t) == 0 &&
+            in_bounds(header.index_offset, static_cast<uint64_t>(header.entry_count) * sizeof(IndexEntry)) &&
+            in_bounds(header.glyph_offset, static_cast<uint64_t>(header.glyph_count) * sizeof(uint32_t)) &&
+            in_bounds(header.pool_offset, header.pool_size) &&
+            (header.pool_size == 0 || blob_[header.pool_offset + header.pool_size - 1] == '\0');
+        if (!valid) {
+            blob_.clear();
+            return false;
+        }
+
+        const char *base = blob_.data();
+        const auto *index = reinterpret_cast<const IndexEntry *>(base + header.index_offset);
+        for (uint32_t i = 0; i < header.entry_count; ++i) {
+            if (index[i].key_offset >= header.pool_size || index[i].value_offset >= header.pool_size ||
+                (i > 0 && index[i - 1].hash > index[i].hash)) {
+                blob_.clear();
+                return false;
+            }
+        }
+
+        index_       = index;
+        glyphs_      = reinterpret_cast<const uint32_t *>(base + header.glyph_offset);
+        pool_        = base + header.pool_offset;
+        count_       = header.entry_count;
+        glyph_count_ = header.glyph_count;
+        return true;
+    }
+
+    auto TranslationTable::FindEntry(const char *key) const -> const IndexEntry * {
+        const uint64_t hash = HashKey(key);
+        const auto    *end  = index_ + count_;
+        const auto    *it   = std::lower_bound(index_, end, hash, [](const IndexEntry &e, uint64_t h) { return e.hash < h; });
+        for (; it != end && it->hash == hash; ++it) {
+            if (std::strcmp(pool_ + it->key_offset, key) == 0) {
+                return it;
+            }
+        }
+        return nullptr;
+    }
+
+    auto TranslationTable::Find(const char *key) const -> const char * {
+        if (key == nullptr || count_ == 0) {
+            return nullptr;
+        }
+        const auto  bits  = reinterpret_cast<uintptr_t>(key);
+        CacheEntry &entry = cache_[(bits ^ (bits >> 9)) & (kCacheSize - 1)];
+        // The address is only a hint: keys can come from reused buffers (c_str()),
+        // so a hit is confirmed against the interned key before it is trusted.
+        if (entry.key == key && std::strcmp(entry.interned_key, key) == 0) {
+            return entry.value;
+        }
+        const IndexEntry *found = FindEntry(key);
+        if (found == nullptr) {
+            return nullptr;
+        }
+        entry.key          = key;
+        entry.interned_key = pool_ + found->key_offset;
+        entry.value        = pool_ + found->value_offset;
+        return entry.value;
+    }
+
+}  // namespace d3::gui2::ui
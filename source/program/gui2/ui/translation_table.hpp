@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace d3::gui2::ui {
+
+    // Flat, load-once translation table stored in the .d3tr bundle layout
+    // (tools/build_translation_bundles.py): header, index sorted by 64-bit key
+    // hash, glyph set, then a pool of NUL-terminated keys and values. Bundles from
+    // romfs are used in place; the TOML fallback path serializes into the same
+    // layout so lookups have one code path.
+    //
+    // tr() is mostly called with string literals, so lookups first hit a small
+    // direct-mapped cache keyed by the key pointer: the steady-state cost per call
+    // is a pointer hash plus a short strcmp, with no allocation or rehashing.
+    class TranslationTable {
+       public:
+        static constexpr std::array<char, 4> kMagic   = {'D', '3', 'T', 'R'};
+        static constexpr uint32_t            kVersion = 1;
+
+        void Clear();
+
+        // TOML path: stage pairs, then Finalize() once after the last Add().
+        void Add(std::string_view key, std::string_view value);
+        void Finalize();
+
+        // Takes ownership of a .d3tr image and validates it. On failure the table is left empty.
+        auto LoadBundle(std::string &&blob) -> bool;
+
+        // Returns the interned value, or nullptr when the key is not present.
+        auto Find(const char *key) const -> const char *;
+
+        auto size() const -> size_t { return count_; }
+        auto empty() const -> bool { return count_ == 0; }
+        auto bytes() const -> size_t { return blob_.size(); }
+
+        // Codepoints used by the values (bundles only; empty for the TOML path).
+        auto glyphs() const -> std::span<const uint32_t> { return {glyphs_, glyph_count_}; }
+
+        template <typename Fn>
+        void ForEachValue(Fn &&fn) const {
+            for (size_t i = 0; i < count_; ++i) {
+                fn(pool_ + index_[i].value_offset);
+            }
+        }
+
+        static constexpr auto HashKey(std::string_view key) -> uint64_t {
+            uint64_t hash = 14695981039346656037ull;
+            for (const char c : key) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+            return hash != 0 ? hash : 1;
+        }
+
+       private:
+        struct Header {
+            char     magic[4];
+            uint32_t version;
+            uint32_t entry_count;
+            uint32_t glyph_count;
+            uint32_t index_offset;
+            uint32_t glyph_offset;
+            uint32_t pool_offset;
+            uint32_t pool_size;
+        };
+        static_assert(sizeof(Header) == 32);
+
+        struct IndexEntry {
+            uint64_t hash;
+            uint32_t key_offset;
+            uint32_t value_offset;
+        };
+        static_assert(sizeof(IndexEntry) == 16);
+
+        struct CacheEntry {
+            const char *key          = nullptr;
+            const char *interned_key = nullptr;
+            const char *value        = nullptr;
+        };
+
+        static constexpr size_t kCacheSize = 512;  // power of two; > tr() call sites per frame
+
+        void ResetViews();
+        auto FindEntry(const char *key) const -> const IndexEntry *;
+
+        std::string                                      blob_ {};
+        std::vector<std::pair<std::string, std::string>> staged_ {};
+        const IndexEntry                                *index_       = nullptr;
+        const uint32_t                                  *glyphs_      = nullptr;
+        const char                                      *pool_        = nullptr;
+        size_t                                           count_       = 0;
+        size_t                                           glyph_count_ = 0;
+        mutable std::array<CacheEntry, kCacheSize>       cache_ {};
+    };
+
+}  // namespace d3::gui2::ui
@@ -0,0 +1,215 @@
+#include "program/gui2/ui/windows/attribute_inspector_window.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cfloat>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+
+#include "program/d3/attrib_meta.hpp"
+#include "program/d3/util.hpp"
+#include "program/gui2/ui/overlay.hpp"
+#include "symbols/common.hpp"
+
+namespace d3::gui2::ui::windows {
+    namespace {
+
+        static auto ResolveLocalAttribGroup(s32 &acd_out) -> FastAttribGroup * {
+            acd_out = -1;
+            Player const *player = LocalPlayerGet();
+            if (player == nullptr || player->idPlayerACD == ACDID_INVALID) {
+                return nullptr;
+            }
+            ActorCommonData *acd = ACDTryToGet(player->idPlayerACD);
+            if (acd == nullptr) {
+                return nullptr;
+            }
+            acd_out = player->idPlayerACD;
+            return acd->ptFastAttribGroup;
+        }
+
+        static auto IsIntAttrib(s32 id) -> bool {
+            return g_arAttribDefs != nullptr && g_arAttribDefs[id].eAttributeDataType == 1;
+        }
+
+        static auto ContainsIgnoreCase(std::string_view haystack, std::string_view needle) -> bool {
+            if (needle.empty()) {
+                return true;
+            }
+            if (needle.size() > haystack.size()) {
+                return false;
+            }
+            for (size_t i = 0; i + needle.size() <= haystack.size(); ++i) {
+                if (attrib_meta::EqualsIgnoreCase(haystack.substr(i, needle.size()), needle)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    }  // namespace
+
+    AttributeInspectorWindow::AttributeInspectorWindow(ui::Overlay &overlay) :
+        Window("Attributes", false), overlay_(overlay) {
+        entries_.resize(static_cast<size_t>(attrib_meta::kCount));
+        visible_.reserve(entries_.size());
+    }
+
+    void AttributeInspectorWindow::ResetSamples() {
+        std::fill(entries_.begin(), entries_.end(), Entry {});
+        cursor_        = 0;
+        sweeps_        = 0;
+        visible_dirty_ = true;
+    }
+
+    void AttributeInspectorWindow::OnOpen() {
+        ResetSamples();
+    }
+
+    void AttributeInspectorWindow::Update(float dt_s) {
+        if (!IsOpen() || !overlay_.overlay_visible() || entries_.empty()) {
+            return;
+        }
+        now_s_ += dt_s;
+        // Attribute defs are only published once game data has loaded.
+        if (g_arAttribDefs == nullptr) {
+            has_player_ = false;
+            return;
+        }
+
+        s32              acd   = -1;
+        FastAttribGroup *group = ResolveLocalAttribGroup(acd);
+        has_player_            = group != nullptr;
+        if (!has_player_) {
+            return;
+        }
+        if (acd != tracked_acd_) {
+            tracked_acd_ = acd;
+            ResetSamples();
+        }
+
+        // Bounded slice per frame; the cursor wraps so every attribute is revisited.
+        const u32 count = static_cast<u32>(entries_.size());
+        for (u32 n = 0; n < kKeysPerFrame; ++n) {
+            const s32        id  = static_cast<s32>(cursor_);
+            const auto       key = MakeAttribKey(id);
+            const s32        raw = IsIntAttrib(id) ? static_cast<s32>(FastAttribGetValueInt(group, key))
+                                                   : std::bit_cast<s32>(FastAttribGetValueFloat(group, key));
+            const AttribDef &def = g_arAttribDefs[id];
+            Entry           &e   = entries_[cursor_];
+
+            if (e.sampled && e.raw != raw) {
+                e.changed_at = now_s_;
+            }
+            const bool is_default = raw == def.tDefaultValue._anon_0.nValue;
+            if (!e.sampled || e.is_default != is_default) {
+                visible_dirty_ = true;
+            }
+            e.raw        = raw;
+            e.sampled    = true;
+            e.is_default = is_default;
+
+            if (++cursor_ >= count) {
+                cursor_ = 0;
+                ++sweeps_;
+            }
+        }
+    }
+
+    void AttributeInspectorWindow::RebuildVisible() {
+        visible_.clear();
+        const std::string_view filter(filter_);
+        for (s32 id = 0; id < attrib_meta::kCount; ++id) {
+            const Entry &e = entries_[static_cast<size_t>(id)];
+            if (!e.sampled || (non_default_ && e.is_default)) {
+                continue;
+            }
+            if (!ContainsIgnoreCase(attrib_meta::NameOf(id), filter)) {
+                continue;
+            }
+            visible_.push_back(id);
+        }
+        visible_dirty_ = false;
+    }
+
+    void AttributeInspectorWindow::BeforeBegin() {
+        ImGui::SetNextWindowSize(ImVec2(520.0f, 480.0f), ImGuiCond_FirstUseEver);
+        const ImGuiID dockspace_id = overlay_.dockspace_id();
+        if (dockspace_id != 0) {
+            ImGui::SetNextWindowDockID(dockspace_id, ImGuiCond_FirstUseEver);
+        }
+    }
+
+    void AttributeInspectorWindow::RenderContents() {
+        if (!has_player_) {
+            ImGui::TextUnformatted(overlay_.tr("gui.attrib_no_player", "No local player."));
+            return;
+        }
+
+        ImGui::Text(overlay_.tr("gui.attrib_status", "ACD 0x%X | sweep %u | %u/%u shown"), static_cast<unsigned>(tracked_acd_), sweeps_, static_cast<unsigned>(visible_.size()), static_cast<unsigned>(entries_.size()));
+        if (ImGui::Checkbox(overlay_.tr("gui.attrib_non_default", "Non-default only"), &non_default_)) {
+            visible_dirty_ = true;
+        }
+        ImGui::SetNextItemWidth(-FLT_MIN);
+        ImGui::InputTextWithHint("##attrib_filter", overlay_.tr("gui.attrib_filter", "Filter by name"), filter_, sizeof(filter_));
+        if (std::strcmp(filter_, prev_filter_) != 0) {
+            std::memcpy(prev_filter_, filter_, sizeof(prev_filter_));
+            visible_dirty_ = true;
+        }
+
+        if (visible_dirty_) {
+            RebuildVisible();
+        }
+
+        constexpr ImGuiTableFlags kTableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingStretchProp;
+        if (!ImGui::BeginTable("##attribs", 3, kTableFlags)) {
+            return;
+        }
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Id", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn(overlay_.tr("gui.attrib_name", "Name"), ImGuiTableColumnFlags_WidthStretch, 3.0f);
+        ImGui::TableSetupColumn(overlay_.tr("gui.attrib_value", "Value"), ImGuiTableColumnFlags_WidthStretch, 1.0f);
+        ImGui::TableHeadersRow();
+
+        const ImVec4 base_color = ImGui::GetStyleColorVec4(ImGuiCol_Text);
+        const ImVec4 hot_color(1.0f, 0.85f, 0.2f, 1.0f);
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(visible_.size()));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const s32    id = visible_[static_cast<size_t>(row)];
+                const Entry &e  = entries_[static_cast<size_t>(id)];
+
+                ImVec4 color = base_color;
+                if (e.changed_at >= 0.0f) {
+                    const float age = now_s_ - e.changed_at;
+                    if (age < kHighlightTime_s) {
+                        const float t = age / kHighlightTime_s;
+                        color         = ImVec4(
+                            hot_color.x + (base_color.x - hot_color.x) * t,
+                            hot_color.y + (base_color.y - hot_color.y) * t,
+                            hot_color.z + (base_color.z - hot_color.z) * t,
+                            1.0f
+                        );
+                    }
+                }
+
+                char value_buf[32];
+                attrib_meta::FormatValue(id, FastAttribValue(e.raw), value_buf, sizeof(value_buf));
+                const std::string_view name = attrib_meta::NameOf(id);
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::Text("0x%03X", static_cast<unsigned>(id));
+                ImGui::TableSetColumnIndex(1);
+                ImGui::TextColored(color, "%.*s", static_cast<int>(name.size()), name.data());
+                ImGui::TableSetColumnIndex(2);
+                ImGui::TextColored(color, "%s", value_buf);
+            }
+        }
+        ImGui::EndTable();
+    }
+
+}  // namespace d3::gui2::ui::windows
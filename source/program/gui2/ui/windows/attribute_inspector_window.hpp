@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+
+#include "program/gui2/ui/window.hpp"
+#include "types.h"
+
+namespace d3::gui2::ui {
+    class Overlay;
+}
+
+namespace d3::gui2::ui::windows {
+
+    // Live view of the local player's unparameterized FastAttribGroup values.
+    // Polling is incremental: at most kKeysPerFrame attributes are read per frame,
+    // so a full sweep of ~1.5k attributes takes a couple dozen frames.
+    class AttributeInspectorWindow : public ui::Window {
+       public:
+        explicit AttributeInspectorWindow(ui::Overlay &overlay);
+
+        static constexpr u32   kKeysPerFrame    = 64;
+        static constexpr float kHighlightTime_s = 2.0f;
+
+       protected:
+        void Update(float dt_s) override;
+        void BeforeBegin() override;
+        void RenderContents() override;
+        void OnOpen() override;
+
+       private:
+        struct Entry {
+            s32   raw        = 0;
+            float changed_at = -1.0f;
+            bool  sampled    = false;
+            bool  is_default = true;
+        };
+
+        void ResetSamples();
+        void RebuildVisible();
+
+        ui::Overlay       &overlay_;
+        std::vector<Entry> entries_ {};
+        std::vector<s32>   visible_ {};
+        u32                cursor_          = 0;
+        s32                tracked_acd_     = -1;
+        float              now_s_           = 0.0f;
+        bool               visible_dirty_   = true;
+        bool               non_default_     = true;
+        bool               has_player_      = false;
+        u32                sweeps_          = 0;
+        char               filter_[64]      = {};
+        char               prev_filter_[64] = {};
+    };
+
+}  // namespace d3::gui2::ui::windows
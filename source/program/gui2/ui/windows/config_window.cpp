@@ -8,10 +8,14 @@
 #include <cstring>
 #include <cstdlib>
 #include <string>
+#include <utility>
 
+#include "program/boot_report.hpp"
 #include "program/d3/setting.hpp"
+#include "program/d3/dynamic_res.hpp"
 #include "program/d3/resolution_util.hpp"
 #include "program/config_schema.hpp"
+#include "program/log_once.hpp"
 #include "program/gui2/input_util.hpp"
 #include "program/gui2/imgui_overlay.hpp"
 #include "program/gui2/ui/overlay.hpp"
@@ -218,6 +222,216 @@ namespace d3::gui2::ui::windows {
         }
     }
 
+    void ConfigWindow::EnsureSchemaRows() {
+        const auto  entries   = d3::config_schema::Entries();
+        const u32   revision  = overlay_.translations_revision();
+        const float font_size = ImGui::GetFontSize();
+        if (schema_rows_.size() == entries.size() && schema_rows_revision_ == revision && schema_rows_font_size_ == font_size) {
+            return;
+        }
+
+        schema_rows_.resize(entries.size());
+        for (size_t i = 0; i < entries.size(); ++i) {
+            const auto &e   = entries[i];
+            SchemaRow  &row = schema_rows_[i];
+            row.entry       = &e;
+            row.label       = (e.tr_label != nullptr && e.label_fallback != nullptr) ? overlay_.tr(e.tr_label, e.label_fallback) : nullptr;
+            row.help        = (e.tr_help != nullptr && e.help_fallback != nullptr) ? overlay_.tr(e.tr_help, e.help_fallback) : nullptr;
+            row.label_w     = row.label != nullptr ? ImGui::CalcTextSize(row.label, nullptr, true).x : 0.0f;
+            row.id.assign("##");
+            row.id.append(e.section);
+            row.id.push_back('_');
+            row.id.append(e.key);
+        }
+        schema_rows_revision_  = revision;
+        schema_rows_font_size_ = font_size;
+    }
+
+    auto ConfigWindow::SchemaRowsFor(std::string_view section) const -> std::span<const SchemaRow> {
+        const auto all    = d3::config_schema::Entries();
+        const auto subset = d3::config_schema::EntriesForSection(section);
+        if (subset.empty() || schema_rows_.size() != all.size()) {
+            return {};
+        }
+        const auto offset = static_cast<size_t>(subset.data() - all.data());
+        return std::span<const SchemaRow>(schema_rows_).subspan(offset, subset.size());
+    }
+
+    auto ConfigWindow::SchemaMaxLabelWidth(std::string_view section) const -> float {
+        float max_w = 0.0f;
+        for (const SchemaRow &row : SchemaRowsFor(section)) {
+            max_w = std::max(max_w, row.label_w);
+        }
+        return max_w;
+    }
+
+    void ConfigWindow::RenderBootTiming() {
+        const auto stages  = d3::boot_report::Stages();
+        const auto history = d3::boot_report::History();
+        if (stages.empty()) {
+            ImGui::TextDisabled("%s", overlay_.tr("gui.debug_boot_timing_none", "No boot timings recorded."));
+            return;
+        }
+
+        // Baseline is the mean of the previous build's boots, so the delta shows
+        // what the new build changed; until there is one it is this build's
+        // earlier boots. The current boot is the last history record. Stages are
+        // matched by name so older layouts still compare.
+        const auto prior         = history.first(history.empty() ? 0 : history.size() - 1);
+        const u32  current_build = history.empty() ? 0u : history.back().build_hash;
+        u32        base_build    = current_build;
+        for (auto it = prior.rbegin(); it != prior.rend(); ++it) {
+            if (it->build_hash != current_build) {
+                base_build = it->build_hash;
+                break;
+            }
+        }
+        const auto base_boots = static_cast<unsigned>(std::count_if(prior.begin(), prior.end(), [&](const auto &rec) { return rec.build_hash == base_build; }));
+
+        auto mean_of = [&](auto &&value_of) -> std::pair<u32, u32> {
+            u64 sum = 0;
+            u32 n   = 0;
+            for (const auto &rec : prior) {
+                u32 us = 0;
+                if (rec.build_hash == base_build && value_of(rec, us)) {
+                    sum += us;
+                    ++n;
+                }
+            }
+            return {n != 0 ? static_cast<u32>(sum / n) : 0u, n};
+        };
+
+        constexpr float kRegressFrac = 0.10f;
+        constexpr u32   kRegressUs   = 2000;
+
+        auto row = [&](const char *name, u32 now_us, std::pair<u32, u32> base) -> void {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", static_cast<float>(now_us) / 1000.0f);
+            ImGui::TableNextColumn();
+            if (base.second == 0) {
+                ImGui::TextDisabled("-");
+                ImGui::TableNextColumn();
+                return;
+            }
+            ImGui::Text("%.1f", static_cast<float>(base.first) / 1000.0f);
+            ImGui::TableNextColumn();
+            const s64   delta_us = static_cast<s64>(now_us) - static_cast<s64>(base.first);
+            const u64   abs_us   = static_cast<u64>(delta_us < 0 ? -delta_us : delta_us);
+            const bool  notable  = abs_us > kRegressUs && static_cast<float>(abs_us) > static_cast<float>(base.first) * kRegressFrac;
+            const float delta_ms = static_cast<float>(delta_us) / 1000.0f;
+            if (notable) {
+                const ImVec4 color = delta_us > 0 ? ImVec4(1.0f, 0.45f, 0.35f, 1.0f) : ImVec4(0.45f, 1.0f, 0.45f, 1.0f);
+                ImGui::TextColored(color, "%+.1f", delta_ms);
+            } else {
+                ImGui::TextDisabled("%+.1f", delta_ms);
+            }
+        };
+
+        constexpr ImGuiTableFlags kFlags = ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH;
+        if (ImGui::BeginTable("boot_timing", 4, kFlags)) {
+            ImGui::TableSetupColumn(overlay_.tr("gui.debug_boot_stage", "Stage"), ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn(overlay_.tr("gui.debug_boot_now_ms", "ms"));
+            ImGui::TableSetupColumn(overlay_.tr("gui.debug_boot_avg_ms", "avg ms"));
+            ImGui::TableSetupColumn(overlay_.tr("gui.debug_boot_delta_ms", "delta"));
+            ImGui::TableHeadersRow();
+
+            for (const auto &stage : stages) {
+                row(stage.name, stage.us, mean_of([&](const d3::boot_report::HistoryRecord &rec, u32 &out) -> bool {
+                        for (u32 i = 0; i < std::min<u32>(rec.stage_count, d3::boot_report::kMaxStages); ++i) {
+                            if (std::strncmp(rec.stages[i].name, stage.name, d3::boot_report::kStageNameSize) == 0) {
+                                out = rec.stages[i].us;
+                                return true;
+                            }
+                        }
+                        return false;
+                    }));
+            }
+
+            u32 hooks_us = 0;
+            for (const auto &t : d3::boot_report::Hooks()) {
+                hooks_us += t.us;
+            }
+            u32 patches_us = 0;
+            for (const auto &t : d3::boot_report::Patches()) {
+                patches_us += t.us;
+            }
+            row(overlay_.tr("gui.debug_boot_hooks_total", "(all hooks)"), hooks_us, mean_of([](const d3::boot_report::HistoryRecord &rec, u32 &out) -> bool {
+                    out = rec.hooks_us;
+                    return true;
+                }));
+            row(overlay_.tr("gui.debug_boot_patches_total", "(all patches)"), patches_us, mean_of([](const d3::boot_report::HistoryRecord &rec, u32 &out) -> bool {
+                    out = rec.patches_us;
+                    return true;
+                }));
+            ImGui::EndTable();
+        }
+        if (base_build != current_build) {
+            ImGui::TextDisabled(overlay_.tr("gui.debug_boot_history_build", "Compared against %u boot(s) of the previous build (%08X)."), base_boots, static_cast<unsigned>(base_build));
+        } else {
+            ImGui::TextDisabled(overlay_.tr("gui.debug_boot_history", "Compared against %u previous boot(s)."), base_boots);
+        }
+
+        // Slowest individual hook groups/patches of this boot.
+        constexpr size_t                          kTop = 6;
+        std::array<d3::boot_report::Timing, kTop> top {};
+        size_t                                    top_count = 0;
+
+        auto consider = [&](const d3::boot_report::Timing &t) -> void {
+            if (top_count < kTop) {
+                top[top_count++] = t;
+            } else if (t.us > top[kTop - 1].us) {
+                top[kTop - 1] = t;
+            } else {
+                return;
+            }
+            std::sort(top.begin(), top.begin() + static_cast<std::ptrdiff_t>(top_count), [](const auto &a, const auto &b) -> bool { return a.us > b.us; });
+        };
+        for (const auto &t : d3::boot_report::Hooks()) {
+            consider(t);
+        }
+        for (const auto &t : d3::boot_report::Patches()) {
+            consider(t);
+        }
+        for (size_t i = 0; i < top_count; ++i) {
+            ImGui::BulletText("%s: %.2f ms", top[i].name, static_cast<float>(top[i].us) / 1000.0f);
+        }
+    }
+
+    void ConfigWindow::RenderLogSites() {
+        constexpr ImGuiTableFlags kFlags = ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH;
+        if (!ImGui::BeginTable("log_sites", 4, kFlags)) {
+            return;
+        }
+        ImGui::TableSetupColumn(overlay_.tr("gui.debug_log_site_key", "Key"), ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn(overlay_.tr("gui.debug_log_site_hits", "hits"));
+        ImGui::TableSetupColumn(overlay_.tr("gui.debug_log_site_logged", "logged"));
+        ImGui::TableSetupColumn(overlay_.tr("gui.debug_log_site_pending", "suppressed"));
+        ImGui::TableHeadersRow();
+        for (size_t i = 0; i < d3::log_once::kKeyCount; ++i) {
+            const auto site = d3::log_once::GetSiteStats(i);
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            if (site.hits == 0) {
+                ImGui::TextDisabled("%.*s", static_cast<int>(site.name.size()), site.name.data());
+            } else {
+                ImGui::Text("%.*s", static_cast<int>(site.name.size()), site.name.data());
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("0x%016llx", static_cast<unsigned long long>(site.hash));
+            }
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", site.hits);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", site.logged);
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", site.pending);
+        }
+        ImGui::EndTable();
+    }
+
     void ConfigWindow::RenderContents() {
         const ImVec2 window_pos  = ImGui::GetWindowPos();
         const ImVec2 window_size = ImGui::GetWindowSize();
@@ -230,6 +444,7 @@ namespace d3::gui2::ui::windows {
         }
 
         PatchConfig &cfg = overlay_.ui_config();
+        EnsureSchemaRows();
 
         const char *config_source = global_config.defaults_only ? overlay_.tr("gui.config_source_defaults", "built-in defaults") : "sd:/config/d3hack-nx/config.toml";
         ImGui::Text(overlay_.tr("gui.config_source", "Config source: %s"), config_source);
@@ -344,6 +559,47 @@ namespace d3::gui2::ui::windows {
             return changed;
         };
 
+        // Schema-backed bool rows (optionally skipping one key). In table mode every
+        // row has the same height, so the clipper only runs widget code for rows
+        // inside the panel's scroll region.
+        auto schema_bool_rows = [&](FormLayout &layout, std::string_view section, std::string_view skip_key) -> void {
+            schema_visible_.clear();
+            for (const SchemaRow &row : SchemaRowsFor(section)) {
+                const auto &e = *row.entry;
+                if (e.key == skip_key || e.kind != d3::config_schema::ValueKind::Bool || e.get_bool == nullptr || e.set_bool == nullptr || row.label == nullptr) {
+                    continue;
+                }
+                schema_visible_.push_back(&row);
+            }
+
+            auto draw_row = [&](const SchemaRow &row) -> void {
+                const auto &e = *row.entry;
+                bool        v = e.get_bool(cfg);
+                if (checkbox_row(layout, row.label, row.id.c_str(), &v, e.restart == d3::config_schema::RestartPolicy::RestartRequired)) {
+                    e.set_bool(cfg, v);
+                    overlay_.set_ui_dirty(true);
+                }
+                if (row.help != nullptr && ImGui::IsItemHovered(ImGuiHoveredFlags_ForTooltip)) {
+                    ImGui::SetTooltip("%s", row.help);
+                }
+            };
+
+            if (!layout.table_open) {
+                // Wrapped labels have variable height; draw everything.
+                for (const SchemaRow *row : schema_visible_) {
+                    draw_row(*row);
+                }
+                return;
+            }
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(schema_visible_.size()));
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                    draw_row(*schema_visible_[static_cast<size_t>(i)]);
+                }
+            }
+        };
+
         auto slider_int_row = [&](FormLayout &layout, const char *label, const char *id, int *value, int min_value, int max_value, const char *fmt, ImGuiSliderFlags flags, bool restart_required) -> bool {
             begin_form_row(layout, label, restart_required);
             const bool changed = ImGui::SliderInt(id, value, min_value, max_value, fmt, flags);
@@ -391,6 +647,13 @@ namespace d3::gui2::ui::windows {
             ImGui::SeparatorText(overlay_.tr(label_key, fallback));
         };
 
+        // Collapsible variant for long toggle clusters: a closed cluster skips label
+        // measurement and all of its row widgets.
+        auto render_cluster_header = [&](const char *label_key, const char *fallback) -> bool {
+            ImGui::Spacing();
+            return ImGui::CollapsingHeader(overlay_.tr(label_key, fallback), ImGuiTreeNodeFlags_DefaultOpen);
+        };
+
         auto label_passes_filter = [&](const ImGuiTextFilter &filter, const char *label) -> bool {
             return filter.IsActive() ? filter.PassFilter(label) : true;
         };
@@ -468,13 +731,8 @@ namespace d3::gui2::ui::windows {
         };
 
         auto render_overlays = [&]() -> void {
-            float max_label = ImGui::CalcTextSize(overlay_.tr("gui.overlays_enabled", "Enabled")).x;
-            for (const auto &e : d3::config_schema::EntriesForSection("overlays")) {
-                if (e.tr_label != nullptr && e.label_fallback != nullptr) {
-                    max_label = std::max(max_label, ImGui::CalcTextSize(overlay_.tr(e.tr_label, e.label_fallback)).x);
-                }
-            }
-            FormLayout layout = begin_form_layout("cfg_overlays_form", max_label);
+            const float max_label = std::max(ImGui::CalcTextSize(overlay_.tr("gui.overlays_enabled", "Enabled")).x, SchemaMaxLabelWidth("overlays"));
+            FormLayout  layout    = begin_form_layout("cfg_overlays_form", max_label);
 
             const auto *enabled_entry = d3::config_schema::FindEntry("overlays", "SectionEnabled");
             if (enabled_entry == nullptr || enabled_entry->get_bool == nullptr || enabled_entry->set_bool == nullptr) {
@@ -498,47 +756,17 @@ namespace d3::gui2::ui::windows {
             }
 
             ImGui::BeginDisabled(!enabled);
-            for (const auto &e : d3::config_schema::EntriesForSection("overlays")) {
-                if (e.key == "SectionEnabled") {
-                    continue;
-                }
-                if (e.kind != d3::config_schema::ValueKind::Bool || e.get_bool == nullptr || e.set_bool == nullptr) {
-                    continue;
-                }
-                bool        v  = e.get_bool(cfg);
-                std::string id = "##overlays_";
-                id += e.key;
-                if (checkbox_row(layout, overlay_.tr(e.tr_label, e.label_fallback), id.c_str(), &v, e.restart == d3::config_schema::RestartPolicy::RestartRequired)) {
-                    e.set_bool(cfg, v);
-                    overlay_.set_ui_dirty(true);
-                }
-            }
+            schema_bool_rows(layout, "overlays", "SectionEnabled");
             ImGui::EndDisabled();
             end_form_layout(layout);
             render_restart_legend();
         };
 
         auto render_gui = [&]() -> void {
-            float max_label = 0.0f;
-            for (const auto &e : d3::config_schema::EntriesForSection("gui")) {
-                if (e.kind == d3::config_schema::ValueKind::Bool && e.tr_label != nullptr && e.label_fallback != nullptr) {
-                    max_label = std::max(max_label, ImGui::CalcTextSize(overlay_.tr(e.tr_label, e.label_fallback)).x);
-                }
-            }
-            max_label         = std::max(max_label, ImGui::CalcTextSize(overlay_.tr("gui.language", "Language")).x);
-            FormLayout layout = begin_form_layout("cfg_gui_form", max_label);
-            for (const auto &e : d3::config_schema::EntriesForSection("gui")) {
-                if (e.kind != d3::config_schema::ValueKind::Bool || e.get_bool == nullptr || e.set_bool == nullptr) {
-                    continue;
-                }
-                bool        v  = e.get_bool(cfg);
-                std::string id = "##gui_";
-                id += e.key;
-                if (checkbox_row(layout, overlay_.tr(e.tr_label, e.label_fallback), id.c_str(), &v, e.restart == d3::config_schema::RestartPolicy::RestartRequired)) {
-                    e.set_bool(cfg, v);
-                    overlay_.set_ui_dirty(true);
-                }
-            }
+            // Includes the Language string entry, which is drawn as a combo below.
+            const float max_label = SchemaMaxLabelWidth("gui");
+            FormLayout  layout    = begin_form_layout("cfg_gui_form", max_label);
+            schema_bool_rows(layout, "gui", {});
 
             const auto &langs         = overlay_.translations_metadata();
             const auto *selected_lang = [&]() -> const d3::gui2::ui::TranslationLanguage * {
@@ -629,10 +857,11 @@ namespace d3::gui2::ui::windows {
                 ImGui::CalcTextSize(overlay_.tr("gui.resolution_output_target_handheld", "Handheld output target (vertical)")).x,
                 ImGui::CalcTextSize(overlay_.tr("gui.resolution_output_handheld_auto", "Handheld output scale: auto (stock)")).x
             );
-            const float scale_max_label = std::max(
+            const float scale_max_label = std::max({
                 ImGui::CalcTextSize(overlay_.tr("gui.resolution_min_scale", "Minimum resolution scale")).x,
-                ImGui::CalcTextSize(overlay_.tr("gui.resolution_max_scale", "Maximum resolution scale")).x
-            );
+                ImGui::CalcTextSize(overlay_.tr("gui.resolution_max_scale", "Maximum resolution scale")).x,
+                ImGui::CalcTextSize(overlay_.tr("gui.resolution_adaptive_handheld_ms", "Adaptive target (handheld, ms)")).x,
+            });
             const float clamp_max_label = ImGui::CalcTextSize(overlay_.tr("gui.resolution_clamp_texture", "Clamp texture height (0=off, 100-9999)")).x;
 
             render_subgroup_header("gui.resolution_group_general", "General", true);
@@ -703,6 +932,16 @@ namespace d3::gui2::ui::windows {
                 cfg.resolution_hack.max_res_scale = max_scale;
                 overlay_.set_ui_dirty(true);
             }
+            mark_dirty(checkbox_row(scale_layout, overlay_.tr("gui.resolution_adaptive", "Adaptive resolution"), "##res_adaptive", &cfg.resolution_hack.adaptive_res, false));
+            ImGui::BeginDisabled(!cfg.resolution_hack.adaptive_res);
+            constexpr float kTargetMin = PatchConfig::ResolutionHackConfig::kAdaptiveTargetMsMin;
+            constexpr float kTargetMax = PatchConfig::ResolutionHackConfig::kAdaptiveTargetMsMax;
+            mark_dirty(slider_float_row(scale_layout, overlay_.tr("gui.resolution_adaptive_docked_ms", "Adaptive target (docked, ms)"), "##res_adaptive_docked", &cfg.resolution_hack.adaptive_target_ms_docked, kTargetMin, kTargetMax, "%.1f ms", ImGuiSliderFlags_AlwaysClamp, false));
+            mark_dirty(slider_float_row(scale_layout, overlay_.tr("gui.resolution_adaptive_handheld_ms", "Adaptive target (handheld, ms)"), "##res_adaptive_handheld", &cfg.resolution_hack.adaptive_target_ms_handheld, kTargetMin, kTargetMax, "%.1f ms", ImGuiSliderFlags_AlwaysClamp, false));
+            if (float adaptive = 0.0f; d3::dynamic_res::CurrentScale(adaptive)) {
+                ImGui::TextDisabled(overlay_.tr("gui.resolution_adaptive_current", "Adaptive scale: %.0f%%"), adaptive * 100.0f);
+            }
+            ImGui::EndDisabled();
             end_form_layout(scale_layout);
 
             render_subgroup_header("gui.resolution_group_texture", "Texture Clamp", false);
@@ -851,21 +1090,26 @@ namespace d3::gui2::ui::windows {
             ImGui::BeginDisabled(!cfg.events.active);
             mark_dirty(render_filter_and_bulk(overlay_.tr("gui.filter_events", "Filter"), "##events_filter", events_filter, rows, false));
             const auto render_events_cluster = [&](const char *title_key, const char *title_fallback, const auto &indices, const char *table_id) -> bool {
+                const bool any_visible = std::any_of(indices.begin(), indices.end(), [&](int index) -> bool {
+                    EXL_ASSERT(index >= 0 && index < static_cast<int>(rows.size()), "events cluster index out of range");
+                    const BoolRowSpec &row = rows[static_cast<size_t>(index)];
+                    return label_passes_filter(events_filter, overlay_.tr(row.tr_key, row.fallback));
+                });
+                if (!any_visible) {
+                    return false;
+                }
+                if (!render_cluster_header(title_key, title_fallback)) {
+                    return true;
+                }
+
                 float max_label = 0.0f;
                 for (int index : indices) {
-                    EXL_ASSERT(index >= 0 && index < static_cast<int>(rows.size()), "events cluster index out of range");
                     const BoolRowSpec &row   = rows[static_cast<size_t>(index)];
                     const char        *label = overlay_.tr(row.tr_key, row.fallback);
-                    if (!label_passes_filter(events_filter, label)) {
-                        continue;
+                    if (label_passes_filter(events_filter, label)) {
+                        max_label = std::max(max_label, ImGui::CalcTextSize(label).x);
                     }
-                    max_label = std::max(max_label, ImGui::CalcTextSize(label).x);
                 }
-                if (max_label <= 0.0f) {
-                    return false;
-                }
-
-                render_subgroup_header(title_key, title_fallback, false);
                 FormLayout toggles_layout = begin_form_layout(table_id, max_label);
                 for (int index : indices) {
                     EXL_ASSERT(index >= 0 && index < static_cast<int>(rows.size()), "events cluster index out of range");
@@ -965,22 +1209,20 @@ namespace d3::gui2::ui::windows {
                 const auto  render_cheats_cluster = [&](const char *title_key, const char *title_fallback, const auto &indices, const char *grid_id, const char *table_id) -> bool {
                     std::array<const BoolRowSpec *, rows.size()> visible_rows {};
                     int                                          visible_len = 0;
-                    float                                        max_label   = 0.0f;
                     for (int index : indices) {
                         EXL_ASSERT(index >= 0 && index < static_cast<int>(rows.size()), "cheats cluster index out of range");
-                        const BoolRowSpec &row   = rows[static_cast<size_t>(index)];
-                        const char        *label = overlay_.tr(row.tr_key, row.fallback);
-                        if (!label_passes_filter(cheats_filter, label)) {
+                        const BoolRowSpec &row = rows[static_cast<size_t>(index)];
+                        if (!label_passes_filter(cheats_filter, overlay_.tr(row.tr_key, row.fallback))) {
                             continue;
                         }
                         visible_rows[static_cast<size_t>(visible_len++)] = &row;
-                        max_label                                        = std::max(max_label, ImGui::CalcTextSize(label).x);
                     }
                     if (visible_len == 0) {
                         return false;
                     }
-
-                    render_subgroup_header(title_key, title_fallback, false);
+                    if (!render_cluster_header(title_key, title_fallback)) {
+                        return true;
+                    }
                     if (use_checkbox_grid && ImGui::BeginTable(grid_id, 2, ImGuiTableFlags_SizingStretchSame | ImGuiTableFlags_NoSavedSettings)) {
                         for (int i = 0; i < visible_len; i += 2) {
                             ImGui::TableNextRow();
@@ -1000,6 +1242,11 @@ namespace d3::gui2::ui::windows {
                         }
                         ImGui::EndTable();
                     } else {
+                        float max_label = 0.0f;
+                        for (int i = 0; i < visible_len; ++i) {
+                            const BoolRowSpec *row = visible_rows[static_cast<size_t>(i)];
+                            max_label              = std::max(max_label, ImGui::CalcTextSize(overlay_.tr(row->tr_key, row->fallback)).x);
+                        }
                         FormLayout toggles_layout = begin_form_layout(table_id, max_label);
                         for (int i = 0; i < visible_len; ++i) {
                             const BoolRowSpec *row = visible_rows[static_cast<size_t>(i)];
@@ -1138,12 +1385,7 @@ namespace d3::gui2::ui::windows {
         };
 
         auto render_debug = [&]() -> void {
-            float max_label = ImGui::CalcTextSize(overlay_.tr("gui.debug_show_metrics", "Show ImGui metrics")).x;
-            for (const auto &e : d3::config_schema::EntriesForSection("debug")) {
-                if (e.tr_label != nullptr && e.label_fallback != nullptr) {
-                    max_label = std::max(max_label, ImGui::CalcTextSize(overlay_.tr(e.tr_label, e.label_fallback)).x);
-                }
-            }
+            const float max_label     = std::max(ImGui::CalcTextSize(overlay_.tr("gui.debug_show_metrics", "Show ImGui metrics")).x, SchemaMaxLabelWidth("debug"));
             FormLayout  layout        = begin_form_layout("cfg_debug_form", max_label);
             const auto *enabled_entry = d3::config_schema::FindEntry("debug", "SectionEnabled");
             if (enabled_entry == nullptr || enabled_entry->get_bool == nullptr || enabled_entry->set_bool == nullptr) {
@@ -1163,21 +1405,7 @@ namespace d3::gui2::ui::windows {
                 }
 
                 ImGui::BeginDisabled(!enabled);
-                for (const auto &e : d3::config_schema::EntriesForSection("debug")) {
-                    if (e.key == "SectionEnabled") {
-                        continue;
-                    }
-                    if (e.kind != d3::config_schema::ValueKind::Bool || e.get_bool == nullptr || e.set_bool == nullptr) {
-                        continue;
-                    }
-                    bool        v  = e.get_bool(cfg);
-                    std::string id = "##debug_";
-                    id += e.key;
-                    if (checkbox_row(layout, overlay_.tr(e.tr_label, e.label_fallback), id.c_str(), &v, e.restart == d3::config_schema::RestartPolicy::RestartRequired)) {
-                        e.set_bool(cfg, v);
-                        overlay_.set_ui_dirty(true);
-                    }
-                }
+                schema_bool_rows(layout, "debug", "SectionEnabled");
                 ImGui::EndDisabled();
             }
             end_form_layout(layout);
@@ -1189,6 +1417,13 @@ namespace d3::gui2::ui::windows {
             ImGui::Checkbox(overlay_.tr("gui.debug_show_demo", "Show ImGui demo window (not linked)"), &show_demo);
             ImGui::EndDisabled();
             ImGui::Checkbox(overlay_.tr("gui.debug_show_metrics", "Show ImGui metrics"), &show_metrics_);
+
+            if (ImGui::CollapsingHeader(overlay_.tr("gui.debug_boot_timing", "Boot timing"))) {
+                RenderBootTiming();
+            }
+            if (ImGui::CollapsingHeader(overlay_.tr("gui.debug_log_sites", "Log suppression"))) {
+                RenderLogSites();
+            }
         };
 
         const ImGuiStyle &style              = ImGui::GetStyle();
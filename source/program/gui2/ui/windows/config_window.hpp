@@ -1,6 +1,16 @@
 #pragma once
 
 #include "program/gui2/ui/window.hpp"
+#include "types.h"
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace d3::config_schema {
+    struct Entry;
+}
 
 namespace d3::gui2::ui {
     class Overlay;
@@ -25,7 +35,27 @@ namespace d3::gui2::ui::windows {
             Bottom,
         };
 
+        // Resolved label/help/id for one config_schema entry. Rows index 1:1 with
+        // config_schema::Entries(); rebuilt only when translations or font size change.
+        struct SchemaRow {
+            const d3::config_schema::Entry *entry   = nullptr;
+            const char                     *label   = nullptr;
+            const char                     *help    = nullptr;
+            std::string                     id {};
+            float                           label_w = 0.0f;
+        };
+
         void UpdateDockSwipe(ImVec2 window_pos, ImVec2 window_size);
+        void EnsureSchemaRows();
+        auto SchemaRowsFor(std::string_view section) const -> std::span<const SchemaRow>;
+        auto SchemaMaxLabelWidth(std::string_view section) const -> float;
+        void RenderBootTiming();
+        void RenderLogSites();
+
+        std::vector<SchemaRow>         schema_rows_ {};
+        std::vector<const SchemaRow *> schema_visible_ {};
+        u32                            schema_rows_revision_  = ~0u;
+        float                          schema_rows_font_size_ = 0.0f;
 
         bool         show_metrics_         = false;
         bool         restart_required_     = false;
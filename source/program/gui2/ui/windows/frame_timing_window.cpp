@@ -0,0 +1,75 @@
+#include "program/gui2/ui/windows/frame_timing_window.hpp"
+
+#include <algorithm>
+
+#include "program/config.hpp"
+#include "program/gui2/ui/overlay.hpp"
+
+namespace d3::gui2::ui::windows {
+
+    FrameTimingWindow::FrameTimingWindow(ui::Overlay &overlay) :
+        Window("Frame timing", false), overlay_(overlay) {
+        SetFlags(ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoDocking | ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoNavFocus | ImGuiWindowFlags_NoBringToFrontOnFocus | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoInputs);
+    }
+
+    void FrameTimingWindow::Update(float dt_s) {
+        const auto &cfg  = global_config;
+        const bool  want = cfg.initialized && cfg.overlays.active && cfg.overlays.frame_timing_hud;
+        if (want != IsOpen()) {
+            SetOpen(want);
+            refresh_in_s_ = 0.0f;
+        }
+        if (!want) {
+            return;
+        }
+
+        refresh_in_s_ -= dt_s;
+        if (refresh_in_s_ <= 0.0f) {
+            refresh_in_s_ = kRefreshInterval_s;
+            Refresh();
+        }
+    }
+
+    void FrameTimingWindow::Refresh() {
+        std::array<frame_timing::Sample, frame_timing::kCapacity> samples {};
+        const size_t count = frame_timing::CopyRecent(samples.data(), samples.size());
+        for (size_t i = 0; i < count; ++i) {
+            frame_ms_[i] = static_cast<float>(samples[i].frame_us) * 0.001f;
+            res_pct_[i]  = samples[i].res_scale * 100.0f;
+        }
+        history_count_ = static_cast<int>(count);
+        frame_timing::ComputeStats(stats_);
+    }
+
+    void FrameTimingWindow::BeforeBegin() {
+        if (const ImGuiViewport *viewport = ImGui::GetMainViewport()) {
+            ImGui::SetNextWindowPos(
+                ImVec2(viewport->Pos.x + 20.0f, viewport->Pos.y + viewport->Size.y - 20.0f),
+                ImGuiCond_Always,
+                ImVec2(0.0f, 1.0f)
+            );
+        }
+        ImGui::SetNextWindowBgAlpha(0.35f);
+    }
+
+    void FrameTimingWindow::RenderContents() {
+        if (stats_.samples == 0) {
+            ImGui::TextUnformatted(overlay_.tr("gui.frame_hud_waiting", "Waiting for frames..."));
+            return;
+        }
+
+        ImGui::Text("%.2f ms avg | p50 %.2f | p90 %.2f | p99 %.2f | max %.2f", stats_.avg_ms, stats_.p50_ms, stats_.p90_ms, stats_.p99_ms, stats_.max_ms);
+        ImGui::Text(overlay_.tr("gui.frame_hud_overlay", "Overlay CPU %.2f ms avg / %.2f ms max"), stats_.overlay_avg_ms, stats_.overlay_max_ms);
+
+        const float plot_w   = 320.0f;
+        const float plot_h   = 48.0f;
+        const float frame_hi = std::max(stats_.max_ms, 34.0f);
+        ImGui::PlotLines("##frame_ms", frame_ms_.data(), history_count_, 0, nullptr, 0.0f, frame_hi, ImVec2(plot_w, plot_h));
+
+        if (stats_.res_scale > 0.0f) {
+            ImGui::Text(overlay_.tr("gui.frame_hud_res", "Dynamic res %.0f%%"), stats_.res_scale * 100.0f);
+            ImGui::PlotLines("##res_pct", res_pct_.data(), history_count_, 0, nullptr, 0.0f, 100.0f, ImVec2(plot_w, plot_h * 0.5f));
+        }
+    }
+
+}  // namespace d3::gui2::ui::windows
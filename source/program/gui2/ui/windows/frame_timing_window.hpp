@@ -0,0 +1,39 @@
+#pragma once
+
+#include <array>
+
+#include "program/frame_timing.hpp"
+#include "program/gui2/ui/window.hpp"
+
+namespace d3::gui2::ui {
+    class Overlay;
+}
+
+namespace d3::gui2::ui::windows {
+
+    // Non-interactive HUD for the frame_timing ring: percentiles, dynamic-res
+    // history and overlay CPU cost. Stats are refreshed at a fixed cadence rather
+    // than every frame, and nothing is aggregated while the HUD is hidden.
+    class FrameTimingWindow : public ui::Window {
+       public:
+        explicit FrameTimingWindow(ui::Overlay &overlay);
+
+        static constexpr float kRefreshInterval_s = 0.25f;
+
+       protected:
+        void Update(float dt_s) override;
+        void BeforeBegin() override;
+        void RenderContents() override;
+
+       private:
+        void Refresh();
+
+        ui::Overlay                               &overlay_;
+        frame_timing::Stats                        stats_ {};
+        std::array<float, frame_timing::kCapacity> frame_ms_ {};
+        std::array<float, frame_timing::kCapacity> res_pct_ {};
+        int                                        history_count_ = 0;
+        float                                      refresh_in_s_  = 0.0f;
+    };
+
+}  // namespace d3::gui2::ui::windows
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cstdarg>
 #include <cstdio>
+#include <cstring>
 
 #include "program/logging.hpp"
 
@@ -35,6 +36,23 @@ namespace d3::gui2::ui::windows {
             }
         }
 
+        static auto HashText(const char *text, size_t len) -> u32 {
+            u32 hash = 2166136261u;
+            for (size_t i = 0; i < len; ++i) {
+                hash ^= static_cast<unsigned char>(text[i]);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        static void FillMeta(Notification &n, const ImVec4 &color, float ttl_s) {
+            n.hash          = HashText(n.text.data(), n.len);
+            n.repeat        = 1;
+            n.color         = color;
+            n.ttl_s         = ttl_s;
+            n.ttl_initial_s = ttl_s;
+        }
+
         void HandleKeyEvent(exl::log::KeyEventLevel level, std::string_view message) {
             if (g_key_event_window == nullptr || message.empty()) {
                 return;
@@ -62,59 +80,82 @@ namespace d3::gui2::ui::windows {
         viewport_size_ = viewport_size;
     }
 
+    void NotificationsWindow::Admit(const Notification &n) {
+        for (size_t i = 0; i < visible_count_; ++i) {
+            Notification &v = visible_[i];
+            if (v.hash == n.hash && v.len == n.len && std::memcmp(v.text.data(), n.text.data(), n.len) == 0) {
+                if (v.repeat < UINT16_MAX) {
+                    ++v.repeat;
+                }
+                v.color         = n.color;
+                v.ttl_s         = std::max(v.ttl_s, n.ttl_s);
+                v.ttl_initial_s = std::max(v.ttl_initial_s, n.ttl_initial_s);
+                return;
+            }
+        }
+        if (visible_count_ == visible_.size()) {
+            // Drop the oldest toast; entries stay in arrival order.
+            std::move(visible_.begin() + 1, visible_.end(), visible_.begin());
+            --visible_count_;
+        }
+        visible_[visible_count_++] = n;
+    }
+
     void NotificationsWindow::Update(float dt_s) {
-        if (notifications_.empty()) {
-            SetOpen(pinned_open_);
-            return;
+        while (pending_.TryPop([this](Notification &n) -> void { Admit(n); })) {
         }
 
-        for (auto &n : notifications_) {
+        size_t kept = 0;
+        for (size_t i = 0; i < visible_count_; ++i) {
+            Notification &n = visible_[i];
             n.ttl_s -= dt_s;
+            if (n.ttl_s > 0.0f) {
+                if (kept != i) {
+                    visible_[kept] = n;
+                }
+                ++kept;
+            }
         }
+        visible_count_ = kept;
 
-        auto removed = std::ranges::remove_if(notifications_, [](const Notification &n) -> bool { return n.ttl_s <= 0.0f; });
-        notifications_.erase(removed.begin(), removed.end());
-
-        SetOpen(pinned_open_ || !notifications_.empty());
+        SetOpen(pinned_open_ || visible_count_ != 0);
     }
 
     void NotificationsWindow::Clear() {
-        notifications_.clear();
+        while (pending_.TryPop([](Notification &) -> void {})) {
+        }
+        visible_count_ = 0;
         SetOpen(pinned_open_);
     }
 
     void NotificationsWindow::AddNotification(const ImVec4 &color, float ttl_s, const char *fmt, ...) {
-        std::array<char, 512> buf {};
-
         va_list vl;
         va_start(vl, fmt);
-        vsnprintf(buf.data(), buf.size(), fmt, vl);
+        AddNotificationV(color, ttl_s, fmt, vl);
         va_end(vl);
+    }
 
-        buf.back() = '\0';
-
-        Notification n {};
-        n.text          = buf.data();
-        n.color         = color;
-        n.ttl_s         = ttl_s;
-        n.ttl_initial_s = ttl_s;
-        notifications_.push_back(std::move(n));
-        SetOpen(true);
+    void NotificationsWindow::AddNotificationV(const ImVec4 &color, float ttl_s, const char *fmt, va_list args) {
+        pending_.TryPush([&](Notification &n) -> void {
+            const int written = vsnprintf(n.text.data(), n.text.size(), fmt, args);
+            n.len             = static_cast<u16>(std::clamp(written, 0, static_cast<int>(n.text.size()) - 1));
+            FillMeta(n, color, ttl_s);
+        });
     }
 
     void NotificationsWindow::AddNotificationText(const ImVec4 &color, float ttl_s, std::string_view text) {
-        Notification n {};
-        n.text          = std::string(text);
-        n.color         = color;
-        n.ttl_s         = ttl_s;
-        n.ttl_initial_s = ttl_s;
-        notifications_.push_back(std::move(n));
-        SetOpen(true);
+        pending_.TryPush([&](Notification &n) -> void {
+            const size_t len = std::min(text.size(), n.text.size() - 1);
+            std::memcpy(n.text.data(), text.data(), len);
+            n.text[len] = '\0';
+            n.len       = static_cast<u16>(len);
+            FillMeta(n, color, ttl_s);
+        });
     }
 
     void NotificationsWindow::SetPinnedOpen(bool pinned) {
         pinned_open_ = pinned;
-        SetOpen(pinned_open_ || !notifications_.empty());
+        SetOpen(pinned_open_ || visible_count_ != 0);
     }
 
     void NotificationsWindow::BeforeBegin() {
@@ -127,7 +168,7 @@ namespace d3::gui2::ui::windows {
     }
 
     void NotificationsWindow::RenderContents() {
-        if (notifications_.empty()) {
+        if (visible_count_ == 0) {
             if (pinned_open_) {
                 ImGui::TextUnformatted("No notifications.");
             }
@@ -136,15 +177,20 @@ namespace d3::gui2::ui::windows {
 
         ImGui::PushTextWrapPos(ImGui::GetCursorPos().x + 340.0f);
 
-        for (const auto &n : notifications_) {
-            float fade = 1.0f;
+        for (size_t i = 0; i < visible_count_; ++i) {
+            const Notification &n    = visible_[i];
+            float               fade = 1.0f;
             if (n.ttl_s < 0.5f) {
                 fade = std::max(0.0f, n.ttl_s / 0.5f);
             }
 
             ImVec4 c = n.color;
             c.w *= fade;
-            ImGui::TextColored(c, "%s", n.text.c_str());
+            if (n.repeat > 1) {
+                ImGui::TextColored(c, "%s (x%u)", n.text.data(), static_cast<unsigned>(n.repeat));
+            } else {
+                ImGui::TextColored(c, "%s", n.text.data());
+            }
         }
 
         ImGui::PopTextWrapPos();
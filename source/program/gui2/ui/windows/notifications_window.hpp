@@ -1,22 +1,36 @@
 #pragma once
 
-#include <string>
+#include <array>
+#include <cstdarg>
 #include <string_view>
-#include <vector>
 
+#include "program/gui2/ui/mpsc_ring.hpp"
 #include "program/gui2/ui/window.hpp"
+#include "types.h"
 
 namespace d3::gui2::ui::windows {
 
     struct Notification {
-        std::string text;
-        ImVec4      color         = ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
-        float       ttl_s         = 0.0f;
-        float       ttl_initial_s = 0.0f;
+        static constexpr size_t kTextCapacity = 256;
+
+        std::array<char, kTextCapacity> text {};
+        u16                             len           = 0;
+        u16                             repeat        = 1;  // coalesced duplicates
+        u32                             hash          = 0;
+        ImVec4                          color         = ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
+        float                           ttl_s         = 0.0f;
+        float                           ttl_initial_s = 0.0f;
     };
 
+    // Producers (any thread, including the exl::log key-event sink) format straight
+    // into a slot of a fixed MPSC ring and never allocate or touch window state.
+    // Update() drains the ring on the UI thread into a small visible set, folding
+    // repeats of an on-screen message into a counter.
     class NotificationsWindow : public ui::Window {
        public:
+        static constexpr size_t kQueueCapacity = 32;
+        static constexpr size_t kMaxVisible    = 8;
+
         NotificationsWindow();
         ~NotificationsWindow() override;
 
@@ -25,19 +39,26 @@ namespace d3::gui2::ui::windows {
         void Clear();
 
         void AddNotification(const ImVec4 &color, float ttl_s, const char *fmt, ...);
+        void AddNotificationV(const ImVec4 &color, float ttl_s, const char *fmt, va_list args);
         void AddNotificationText(const ImVec4 &color, float ttl_s, std::string_view text);
         void SetPinnedOpen(bool pinned);
         bool IsPinnedOpen() const { return pinned_open_; }
 
+        auto dropped_count() const -> u32 { return pending_.dropped(); }
+
        protected:
         void Update(float dt_s) override;
         void BeforeBegin() override;
         void RenderContents() override;
 
        private:
-        ImVec2                    viewport_size_ {};
-        std::vector<Notification> notifications_ {};
-        bool                      pinned_open_ = false;
+        void Admit(const Notification &n);
+
+        ImVec2                                 viewport_size_ {};
+        MpscRing<Notification, kQueueCapacity> pending_ {};
+        std::array<Notification, kMaxVisible>  visible_ {};
+        size_t                                 visible_count_ = 0;
+        bool                                   pinned_open_   = false;
     };
 
 }  // namespace d3::gui2::ui::windows
@@ -0,0 +1,315 @@
+#include "program/hook_trace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include "lib/nx/result.h"
+#include "nn/os.hpp"  // IWYU pragma: keep
+#include "program/d3/setting.hpp"
+#include "program/fs_util.hpp"
+
+namespace d3::hook_trace {
+    namespace detail {
+        constinit std::atomic<bool> g_active {false};
+    }  // namespace detail
+
+    namespace {
+        constexpr char      kMagic[4] {'D', '3', 'T', 'R'};
+        constexpr u32       kVersion       = 1;
+        constexpr size_t    kThreadNameLen = 32;
+        constexpr uintptr_t kNoRing        = 1;  // TLS value once the pool is exhausted for this thread
+        static_assert((kRingRecords & (kRingRecords - 1)) == 0);
+
+        struct Record {
+            u64 tick;
+            u16 site;
+            u8  phase;
+            u8  reserved0;
+            u32 reserved1;
+            u64 arg0;
+            u64 arg1;
+        };
+        static_assert(sizeof(Record) == 32);
+
+        struct FileHeader {
+            char magic[4];
+            u32  version;
+            u64  tick_frequency;
+            u32  site_count;
+            u32  ring_count;
+        };
+        static_assert(sizeof(FileHeader) == 24);
+
+        struct SiteRecord {
+            u16  id;
+            u16  reserved;
+            char group[kSiteGroupLen];
+            char name[kSiteNameLen];
+        };
+        static_assert(sizeof(SiteRecord) == 92);
+
+        struct RingHeader {
+            u64  thread_id;
+            char thread_name[kThreadNameLen];
+            u32  record_count;
+            u32  lost;
+        };
+        static_assert(sizeof(RingHeader) == 48);
+
+        // One writer (the owning thread); the exporter reads head before and
+        // after copying and discards anything the writer may have overwritten.
+        struct Ring {
+            std::atomic<bool>                ready {false};
+            u64                              thread_id = 0;
+            char                             thread_name[kThreadNameLen] {};
+            std::atomic<u64>                 head {0};
+            std::array<Record, kRingRecords> records {};
+        };
+
+        Ring                         *g_rings = nullptr;
+        std::atomic<u32>              g_ring_count {0};
+        std::atomic<u64>              g_no_ring_events {0};
+        nn::os::TlsSlot               g_ring_slot {};
+        std::string                   g_selection;
+        nn::os::Mutex                 g_mutex {};
+        std::array<Site *, kMaxSites> g_sites {};
+        u32                           g_site_count = 0;
+
+        static inline auto ReadTick() -> u64 {
+            u64 tick = 0;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(tick));
+            return tick;
+        }
+
+        static auto Trim(std::string_view text) -> std::string_view {
+            while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+                text.remove_prefix(1);
+            }
+            while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+                text.remove_suffix(1);
+            }
+            return text;
+        }
+
+        static auto EqualsNoCase(std::string_view a, std::string_view b) -> bool {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+                       const auto lower = [](char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; };
+                       return lower(x) == lower(y);
+                   });
+        }
+
+        static auto Selected(const Site &site) -> bool {
+            std::string_view rest = g_selection;
+            while (!rest.empty()) {
+                const size_t           comma = rest.find(',');
+                const std::string_view token = Trim(rest.substr(0, comma));
+                rest                         = comma == std::string_view::npos ? std::string_view {} : rest.substr(comma + 1);
+
+                std::string_view name = token;
+                if (name.size() > 4 && EqualsNoCase(name.substr(0, 4), "sym_")) {
+                    name.remove_prefix(4);
+                }
+                if (token == "*" || EqualsNoCase(name, site.name) || EqualsNoCase(token, site.group)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static auto CurrentRing() -> Ring * {
+            const uintptr_t value = nn::os::GetTlsValue(g_ring_slot);
+            if (value > kNoRing) {
+                return reinterpret_cast<Ring *>(value);
+            }
+            if (value == kNoRing) {
+                return nullptr;
+            }
+
+            const u32 index = g_ring_count.fetch_add(1, std::memory_order_relaxed);
+            if (index >= kMaxThreads) {
+                nn::os::SetTlsValue(g_ring_slot, kNoRing);
+                return nullptr;
+            }
+            Ring &ring = g_rings[index];
+            if (const auto *self = nn::os::GetCurrentThread(); self != nullptr) {
+                ring.thread_id = self->thread_id;
+                if (self->name_pointer != nullptr) {
+                    std::strncpy(ring.thread_name, self->name_pointer, sizeof(ring.thread_name) - 1);
+                }
+            }
+            ring.ready.store(true, std::memory_order_release);
+            nn::os::SetTlsValue(g_ring_slot, reinterpret_cast<uintptr_t>(&ring));
+            return &ring;
+        }
+
+        static void CopyName(char *out, size_t size, const char *name) {
+            std::memset(out, 0, size);
+            if (name != nullptr) {
+                std::strncpy(out, name, size - 1);
+            }
+        }
+
+        static void Append(std::string &out, const void *data, size_t size) {
+            out.append(static_cast<const char *>(data), size);
+        }
+    }  // namespace
+
+    auto Configure(std::string_view selection) -> bool {
+        selection = Trim(selection);
+        if (selection.empty() || detail::g_active.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        if (R_FAILED(nn::os::AllocateTlsSlot(&g_ring_slot, nullptr))) {
+            PRINT_LINE("[hook_trace] TLS slot allocation failed; tracing disabled");
+            return false;
+        }
+        auto *rings = static_cast<Ring *>(std::malloc(sizeof(Ring) * kMaxThreads));
+        if (rings == nullptr) {
+            PRINT("[hook_trace] %zu bytes for rings unavailable; tracing disabled", sizeof(Ring) * kMaxThreads)
+            nn::os::FreeTlsSlot(g_ring_slot);
+            return false;
+        }
+        for (size_t i = 0; i < kMaxThreads; ++i) {
+            new (&rings[i]) Ring();
+        }
+        g_rings     = rings;
+        g_selection = std::string(selection);
+        detail::g_active.store(true, std::memory_order_release);
+        PRINT("[hook_trace] tracing '%s' (%zu threads x %zu events)", g_selection.c_str(), kMaxThreads, kRingRecords)
+        return true;
+    }
+
+    auto Active() -> bool {
+        return detail::g_active.load(std::memory_order_acquire);
+    }
+
+    auto detail::Resolve(Site &site) -> bool {
+        std::scoped_lock lock(g_mutex);
+        const u8         state = site.state.load(std::memory_order_relaxed);
+        if (state != Site::State_Unresolved) {
+            return state == Site::State_On;
+        }
+        if (!Selected(site) || g_site_count >= kMaxSites) {
+            site.state.store(Site::State_Off, std::memory_order_relaxed);
+            return false;
+        }
+        site.id               = static_cast<u16>(g_site_count);
+        g_sites[g_site_count] = &site;
+        ++g_site_count;
+        site.state.store(Site::State_On, std::memory_order_release);
+        PRINT("[hook_trace] site %u: %s (%s)", site.id, site.name, site.group)
+        return true;
+    }
+
+    void detail::Emit(Site &site, u8 phase, u64 arg0, u64 arg1) {
+        const u64 tick = ReadTick();
+        Ring     *ring = CurrentRing();
+        if (ring == nullptr) {
+            g_no_ring_events.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const u64 head   = ring->head.load(std::memory_order_relaxed);
+        Record   &record = ring->records[head & (kRingRecords - 1)];
+        record           = {.tick = tick, .site = site.id, .phase = phase, .reserved0 = 0, .reserved1 = 0, .arg0 = arg0, .arg1 = arg1};
+        ring->head.store(head + 1, std::memory_order_release);
+    }
+
+    auto GetStats() -> Stats {
+        Stats stats {};
+        if (!Active()) {
+            return stats;
+        }
+        {
+            std::scoped_lock lock(g_mutex);
+            stats.sites = g_site_count;
+        }
+        stats.threads = std::min<u32>(g_ring_count.load(std::memory_order_relaxed), kMaxThreads);
+        stats.lost    = g_no_ring_events.load(std::memory_order_relaxed);
+        for (u32 i = 0; i < stats.threads; ++i) {
+            const u64 head = g_rings[i].head.load(std::memory_order_relaxed);
+            stats.events += head;
+            stats.lost += head > kRingRecords ? head - kRingRecords : 0;
+        }
+        return stats;
+    }
+
+    auto DumpTrace(const char *path, std::string &error_out) -> bool {
+        if (!Active()) {
+            error_out = "hook tracing is off ([debug] TraceHooks)";
+            return false;
+        }
+        const u32 ring_count = std::min<u32>(g_ring_count.load(std::memory_order_acquire), kMaxThreads);
+
+        std::string out;
+        out.reserve(sizeof(FileHeader) + kMaxSites * sizeof(SiteRecord) + ring_count * (sizeof(RingHeader) + sizeof(Record) * kRingRecords));
+        out.resize(sizeof(FileHeader));
+
+        u32 site_count = 0;
+        {
+            std::scoped_lock lock(g_mutex);
+            site_count = g_site_count;
+            for (u32 i = 0; i < g_site_count; ++i) {
+                SiteRecord record {};
+                record.id = g_sites[i]->id;
+                CopyName(record.group, sizeof(record.group), g_sites[i]->group);
+                CopyName(record.name, sizeof(record.name), g_sites[i]->name);
+                Append(out, &record, sizeof(record));
+            }
+        }
+
+        u32 rings_written = 0;
+        u64 events        = 0;
+        for (u32 i = 0; i < ring_count; ++i) {
+            const Ring &ring = g_rings[i];
+            if (!ring.ready.load(std::memory_order_acquire)) {
+                continue;
+            }
+            const u64 before = ring.head.load(std::memory_order_acquire);
+            u64       first  = before > kRingRecords ? before - kRingRecords : 0;
+
+            RingHeader header {};
+            header.thread_id = ring.thread_id;
+            std::memcpy(header.thread_name, ring.thread_name, sizeof(header.thread_name));
+            const size_t header_offset = out.size();
+            Append(out, &header, sizeof(header));
+            const size_t records_offset = out.size();
+            for (u64 n = first; n < before; ++n) {
+                Append(out, &ring.records[n & (kRingRecords - 1)], sizeof(Record));
+            }
+
+            // The owner kept writing while we copied: slots it reached since
+            // `before` (plus the one it may be halfway through) are suspect.
+            const u64 after = ring.head.load(std::memory_order_acquire);
+            const u64 safe  = after + 1 > kRingRecords ? after + 1 - kRingRecords : 0;
+            if (safe > first) {
+                const u64 drop = std::min(safe, before) - first;
+                out.erase(records_offset, static_cast<size_t>(drop) * sizeof(Record));
+                first += drop;
+            }
+            header.record_count = static_cast<u32>(before - first);
+            header.lost         = static_cast<u32>(std::min<u64>(first, ~0u));
+            std::memcpy(out.data() + header_offset, &header, sizeof(header));
+            events += header.record_count;
+            ++rings_written;
+        }
+
+        FileHeader header {};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version        = kVersion;
+        header.tick_frequency = static_cast<u64>(nn::os::GetSystemTickFrequency());
+        header.site_count     = site_count;
+        header.ring_count     = rings_written;
+        std::memcpy(out.data(), &header, sizeof(header));
+
+        if (events == 0) {
+            error_out = "no traced calls recorded yet";
+            return false;
+        }
+        return fs_util::WriteAllAtomic(path, out, "hook trace", error_out);
+    }
+
+}  // namespace d3::hook_trace
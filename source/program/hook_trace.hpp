@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "types.h"
+
+namespace d3::hook_trace {
+
+    // Opt-in tracing of the original game function behind selected trampoline
+    // hooks. A hook opts in with HOOK_TRACE(group, name); its Orig() then
+    // records an enter and an exit event (cntvct_el0 timestamp plus the first
+    // two arguments as raw words) into a ring owned by the calling thread.
+    // [debug] TraceHooks selects sites by name ("OpenChallengeRift" or
+    // "sym_OpenChallengeRift"), by hook_registry group ("DebuggingHooks") or
+    // "*" for all. Tools > Dump hook trace writes the rings to kTracePath;
+    // tools/trace_to_chrome.py turns that into Chrome trace-event JSON.
+    //
+    // File layout (little-endian):
+    //   header  "D3TR", u32 version, u64 tick frequency, u32 site count,
+    //           u32 ring count
+    //   sites   site count x {u16 id, u16 reserved, char group[28], char name[60]}
+    //   rings   ring count x {u64 thread id, char thread name[32], u32 record
+    //           count, u32 lost, records}
+    //   record  u64 tick, u16 site id, u8 phase (0 = enter, 1 = exit),
+    //           u8 reserved, u32 reserved, u64 arg0, u64 arg1
+    constexpr const char *kTracePath    = "sd:/config/d3hack-nx/hook_trace.bin";
+    constexpr size_t      kMaxThreads   = 8;
+    constexpr size_t      kRingRecords  = 4096;  // per thread, power of two
+    constexpr size_t      kMaxSites     = 64;
+    constexpr size_t      kSiteGroupLen = 28;
+    constexpr size_t      kSiteNameLen  = 60;
+
+    struct Site {
+        enum State : u8 {
+            State_Unresolved = 0,
+            State_Off        = 1,
+            State_On         = 2,
+        };
+
+        const char     *group;
+        const char     *name;
+        std::atomic<u8> state {State_Unresolved};
+        u16             id = 0;
+    };
+
+    // Parses the [debug] TraceHooks list and allocates the rings. Call once at
+    // boot, before hooks are installed; returns false (tracing stays off) for
+    // an empty list or when allocation fails.
+    auto Configure(std::string_view selection) -> bool;
+    auto Active() -> bool;
+
+    namespace detail {
+        extern std::atomic<bool> g_active;
+
+        auto Resolve(Site &site) -> bool;
+        void Emit(Site &site, u8 phase, u64 arg0, u64 arg1);
+
+        template<typename T>
+        inline auto ArgWord(const T &value) -> u64 {
+            using U = std::remove_cvref_t<T>;
+            if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>) {
+                return reinterpret_cast<uintptr_t>(value);
+            } else if constexpr (std::is_enum_v<U> || std::is_integral_v<U>) {
+                return static_cast<u64>(value);
+            } else if constexpr (std::is_same_v<U, float>) {
+                return std::bit_cast<u32>(value);
+            } else if constexpr (std::is_same_v<U, double>) {
+                return std::bit_cast<u64>(value);
+            } else {
+                return 0;
+            }
+        }
+
+        template<typename... Args>
+        inline auto ArgAt(size_t index, const Args &...args) -> u64 {
+            u64    out = 0;
+            size_t i   = 0;
+            ((out = (i++ == index) ? ArgWord(args) : out), ...);
+            return out;
+        }
+    }  // namespace detail
+
+    // Enter on construction, exit on destruction. Costs one relaxed load when
+    // tracing is off, and one acquire load more when the site is not selected.
+    class Scope {
+       public:
+        template<typename... Args>
+        explicit Scope(Site &site, const Args &...args) {
+            if (!detail::g_active.load(std::memory_order_relaxed)) {
+                return;
+            }
+            // Acquire pairs with Resolve()'s release so site.id is published.
+            const u8 state = site.state.load(std::memory_order_acquire);
+            if (state == Site::State_Off || (state == Site::State_Unresolved && !detail::Resolve(site))) {
+                return;
+            }
+            site_ = &site;
+            detail::Emit(site, 0, detail::ArgAt(0, args...), detail::ArgAt(1, args...));
+        }
+
+        ~Scope() {
+            if (site_ != nullptr) {
+                detail::Emit(*site_, 1, 0, 0);
+            }
+        }
+
+        Scope(const Scope &)            = delete;
+        Scope &operator=(const Scope &) = delete;
+
+       private:
+        Site *site_ = nullptr;
+    };
+
+    struct Stats {
+        u32 sites   = 0;  // selected sites hit so far
+        u32 threads = 0;  // rings in use
+        u64 events  = 0;
+        u64 lost    = 0;  // overwritten by ring wrap, or no ring left for the thread
+    };
+    auto GetStats() -> Stats;
+
+    auto DumpTrace(const char *path, std::string &error_out) -> bool;
+
+}  // namespace d3::hook_trace
+
+#define _HOOK_TRACE_SITE(group, name)                                               \
+    static auto TraceSite() -> ::d3::hook_trace::Site & {                           \
+        static constinit ::d3::hook_trace::Site s_site {group, name};               \
+        return s_site;                                                              \
+    }
+
+// Inside a HOOK_DEFINE_TRAMPOLINE body: trace every Orig() call of this hook.
+// `group` is the hook_registry entry that installs it, `name` the traced game
+// function (its offsets.hpp symbol without the "sym_" prefix).
+#define HOOK_TRACE(group, name)                                                     \
+    _HOOK_TRACE_SITE(group, name)                                                   \
+    struct TraceScope : ::d3::hook_trace::Scope {                                   \
+        template<typename... Args>                                                  \
+        explicit TraceScope(const Args &...args) : Scope(TraceSite(), args...) {}   \
+    }
+
+// Like HOOK_TRACE, but the span covers the whole Callback (our own work, such
+// as SD caching, plus Orig()) rather than the original alone. Declare it in the
+// hook body and open the span with HOOK_TRACE_CALLBACK_SCOPE(args...) as the
+// first statement of Callback.
+#define HOOK_TRACE_CALLBACK(group, name) _HOOK_TRACE_SITE(group, name) static_assert(true)
+#define HOOK_TRACE_CALLBACK_SCOPE(...)   const ::d3::hook_trace::Scope hook_trace_callback_scope(TraceSite() __VA_OPT__(, ) __VA_ARGS__)
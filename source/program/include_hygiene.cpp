@@ -1,6 +1,8 @@
 // Compile-only TU to catch missing includes and brittle include ordering.
 
 #include "d3/_util.hpp"
+#include "d3/attrib_meta.hpp"
+#include "d3/gamebalance_index.hpp"
 #include "d3/hooks/debug.hpp"
 #include "d3/hooks/resolution.hpp"
 #include "d3/hooks/util.hpp"
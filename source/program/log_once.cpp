@@ -1,53 +1,136 @@
 #include "program/log_once.hpp"
 
-#include "types.h"
+#include "nn/os.hpp"  // IWYU pragma: keep
+#include "program/d3/setting.hpp"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cstddef>
 
 namespace d3::log_once {
     namespace {
-        constexpr size_t kMaxKeys = 128;
+        constexpr u64 kTokenMask  = 0xFFFF;
+        constexpr u32 kTokenShift = 16;
 
-        alignas(8) std::array<std::atomic<u64>, kMaxKeys> g_keys {};
+        struct Site {
+            std::atomic<bool> summarize {false};
+            std::atomic<u32>  hits {0};
+            std::atomic<u32>  logged {0};
+            std::atomic<u32>  pending {0};  // suppressed since the last log line or summary
+            std::atomic<u64>  bucket {0};   // (refill ms << 16) | tokens; 0 = not started
+        };
 
-        static auto Fnv1a64(const char *s) -> u64 {
-            // 64-bit FNV-1a.
-            u64 hash = 14695981039346656037ull;
-            for (const char *p = s; p != nullptr && *p != '\0'; ++p) {
-                hash ^= static_cast<unsigned char>(*p);
-                hash *= 1099511628211ull;
+        std::array<Site, kKeyCount> g_sites {};
+        std::atomic<u64>            g_next_summary_ms {0};
+
+        static auto NowMs() -> u64 {
+            const u64 freq = static_cast<u64>(nn::os::GetSystemTickFrequency());
+            return static_cast<u64>(nn::os::GetSystemTick().GetInt64Value()) / (freq / 1000);
+        }
+
+        // Token bucket packed into one atomic so concurrent callers never lock.
+        // Refill time only advances by whole tokens, so partial credit carries over.
+        static auto TakeToken(std::atomic<u64> &bucket, const Policy &policy) -> bool {
+            const u64 burst = std::min<u64>(policy.burst, kTokenMask);
+            const u64 now   = NowMs();
+            u64       cur   = bucket.load(std::memory_order_relaxed);
+            for (;;) {
+                u64 last   = cur >> kTokenShift;
+                u64 tokens = cur & kTokenMask;
+                if (cur == 0) {
+                    last   = now;
+                    tokens = burst;
+                } else if (policy.per_sec != 0 && now > last) {
+                    const u64 added = (now - last) * policy.per_sec / 1000;
+                    if (added != 0) {
+                        tokens = std::min(burst, tokens + added);
+                        last   = (tokens == burst) ? now : last + (added * 1000 / policy.per_sec);
+                    }
+                }
+                if (tokens == 0) {
+                    return false;
+                }
+                const u64 next = (last << kTokenShift) | (tokens - 1);
+                if (bucket.compare_exchange_weak(cur, next, std::memory_order_relaxed)) {
+                    return true;
+                }
             }
-            return hash;
         }
     }  // namespace
 
-    auto ShouldLog(const char *key) -> bool {
-        if (key == nullptr || key[0] == '\0') {
-            return true;
+    auto Check(Key key, const Policy &policy) -> Verdict {
+        Site     &site = g_sites[key.index()];
+        const u32 hit  = site.hits.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (hit == 1) {
+            site.summarize.store(policy.summarize, std::memory_order_relaxed);
         }
 
-        u64 hash = Fnv1a64(key);
-        if (hash == 0) {
-            hash = 1;
+        bool sampled = hit <= policy.first_n;
+        if (!sampled && policy.every_m != 0) {
+            sampled = (hit - policy.first_n) % policy.every_m == 0;
+        }
+        if (sampled && policy.burst != 0) {
+            sampled = TakeToken(site.bucket, policy);
         }
 
-        const size_t start = static_cast<size_t>(hash % kMaxKeys);
-        for (size_t step = 0; step < kMaxKeys; ++step) {
-            const size_t idx = (start + step) % kMaxKeys;
+        if (!sampled) {
+            site.pending.fetch_add(1, std::memory_order_relaxed);
+            return {};
+        }
+        site.logged.fetch_add(1, std::memory_order_relaxed);
+        return {.log = true, .suppressed = site.pending.exchange(0, std::memory_order_relaxed)};
+    }
+
+    auto ShouldLog(Key key) -> bool {
+        return Check(key, kOnce).log;
+    }
 
-            u64 expected = 0;
-            if (g_keys[idx].compare_exchange_strong(expected, hash, std::memory_order_acq_rel)) {
-                return true;
+    void PumpSummaries() {
+        const u64 now  = NowMs();
+        u64       next = g_next_summary_ms.load(std::memory_order_relaxed);
+        if (now < next) {
+            return;
+        }
+        if (!g_next_summary_ms.compare_exchange_strong(next, now + kSummaryIntervalMs, std::memory_order_relaxed)) {
+            return;  // another thread took this interval
+        }
+        if (next == 0) {
+            return;  // first call only arms the timer
+        }
+
+        for (size_t i = 0; i < kKeyCount; ++i) {
+            Site &site = g_sites[i];
+            if (!site.summarize.load(std::memory_order_relaxed)) {
+                continue;
             }
-            if (expected == hash) {
-                return false;
+            const u32 suppressed = site.pending.exchange(0, std::memory_order_relaxed);
+            if (suppressed == 0) {
+                continue;
             }
+            PRINT(
+                "[log_once] %.*s: %u suppressed since last report (hits=%u logged=%u)",
+                static_cast<int>(kKeyNames[i].size()),
+                kKeyNames[i].data(),
+                suppressed,
+                site.hits.load(std::memory_order_relaxed),
+                site.logged.load(std::memory_order_relaxed)
+            )
         }
+    }
 
-        // Table full; best-effort behavior is to allow the log.
-        return true;
+    auto GetSiteStats(size_t index) -> SiteStats {
+        if (index >= kKeyCount) {
+            return {};
+        }
+        const Site &site = g_sites[index];
+        return {
+            .name    = kKeyNames[index],
+            .hash    = detail::Fnv1a64(kKeyNames[index]),
+            .hits    = site.hits.load(std::memory_order_relaxed),
+            .logged  = site.logged.load(std::memory_order_relaxed),
+            .pending = site.pending.load(std::memory_order_relaxed),
+        };
     }
 
 }  // namespace d3::log_once
@@ -1,9 +1,120 @@
 #pragma once
 
+#include <cstddef>
+#include <string_view>
+
+#include "program/log_once_keys.hpp"
+#include "types.h"
+
 namespace d3::log_once {
 
-    // Returns true the first time a key is seen (best-effort). Intended for
-    // "log once" gates without heap allocation.
-    auto ShouldLog(const char *key) -> bool;
+    constexpr size_t kKeyCount = kKeyNames.size();
+
+    namespace detail {
+        constexpr auto Fnv1a64(std::string_view s) -> u64 {
+            // 64-bit FNV-1a.
+            u64 hash = 14695981039346656037ull;
+            for (const char c : s) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        consteval auto IndexOf(std::string_view name) -> size_t {
+            for (size_t i = 0; i < kKeyCount; ++i) {
+                if (kKeyNames[i] == name) {
+                    return i;
+                }
+            }
+            return kKeyCount;
+        }
+
+        consteval auto KeysDistinct() -> bool {
+            for (size_t i = 0; i < kKeyCount; ++i) {
+                for (size_t j = i + 1; j < kKeyCount; ++j) {
+                    if (kKeyNames[i] == kKeyNames[j] || Fnv1a64(kKeyNames[i]) == Fnv1a64(kKeyNames[j])) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Deliberately not constexpr: reaching it during constant evaluation
+        // turns an unregistered key into a compile error at the call site.
+        void KeyNotRegisteredInLogOnceKeys();
+    }  // namespace detail
+
+    static_assert(detail::KeysDistinct(), "duplicate or colliding log_once key in log_once_keys.hpp");
+
+    // A call-site key, resolved entirely at compile time. String literals
+    // convert implicitly, so `ShouldLog("gb_index.alloc_failed")` costs one
+    // indexed atomic update at runtime.
+    class Key {
+       public:
+        consteval Key(const char *name) : name_(name), hash_(detail::Fnv1a64(name)), index_(detail::IndexOf(name)) {  // NOLINT(google-explicit-constructor)
+            if (index_ == kKeyCount) {
+                detail::KeyNotRegisteredInLogOnceKeys();
+            }
+        }
+
+        [[nodiscard]] constexpr auto name() const -> const char * { return name_; }
+        [[nodiscard]] constexpr auto hash() const -> u64 { return hash_; }
+        [[nodiscard]] constexpr auto index() const -> size_t { return index_; }
+
+       private:
+        const char *name_;
+        u64         hash_;
+        size_t      index_;
+    };
+
+    // Per-call-site suppression. A hit is eligible when it is one of the first
+    // `first_n`, or every `every_m`th hit after that; an eligible hit is logged
+    // if the site's token bucket (`burst` tokens, refilled at `per_sec`) has a
+    // token left. Everything else is counted as suppressed.
+    struct Policy {
+        u32  first_n   = 1;
+        u32  every_m   = 0;  // 0: nothing after the first N
+        u32  burst     = 0;  // 0: no rate limit (max 0xFFFF)
+        u32  per_sec   = 0;
+        bool summarize = false;  // report suppressed counts from PumpSummaries()
+    };
+
+    // Log the first hit only (the classic "log once").
+    inline constexpr Policy kOnce {};
+    // First 3 hits, then every 100th, with periodic suppressed-count summaries.
+    inline constexpr Policy kSampled {.first_n = 3, .every_m = 100, .summarize = true};
+    // Every hit is eligible, at most 5 back-to-back and 1/s sustained.
+    inline constexpr Policy kRateLimited {.first_n = ~0u, .burst = 5, .per_sec = 1, .summarize = true};
+
+    struct Verdict {
+        bool log        = false;
+        u32  suppressed = 0;  // hits dropped since this site last logged or was summarized
+
+        explicit operator bool() const { return log; }
+    };
+
+    // Lock-free; no heap allocation.
+    auto Check(Key key, const Policy &policy) -> Verdict;
+
+    // Returns true the first time a key is seen.
+    auto ShouldLog(Key key) -> bool;
+
+    // Prints one line per summarizing site that suppressed hits since the last
+    // summary. Cheap to call every frame; does work at most every
+    // kSummaryIntervalMs.
+    constexpr s64 kSummaryIntervalMs = 10000;
+    void          PumpSummaries();
+
+    // Diagnostics view over every registered key, in kKeyNames order.
+    struct SiteStats {
+        std::string_view name;
+        u64              hash    = 0;
+        u32              hits    = 0;
+        u32              logged  = 0;
+        u32              pending = 0;  // suppressed, not yet reported
+    };
+    auto GetSiteStats(size_t index) -> SiteStats;
 
 }  // namespace d3::log_once
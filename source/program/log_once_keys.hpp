@@ -0,0 +1,19 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+
+namespace d3::log_once {
+
+    // Every log_once call site key. log_once::Key only accepts names listed
+    // here, which makes hash collisions a compile error and lets the overlay
+    // enumerate sites. Keep sorted.
+    inline constexpr std::array<std::string_view, 5> kKeyNames = {
+        "config_snapshot.publish_deferred",
+        "gb_index.alloc_failed",
+        "gui.theme_override.parse_failed",
+        "imgui_alloc.free_missing",
+        "imgui_alloc.malloc_missing",
+    };
+
+}  // namespace d3::log_once
@@ -2,6 +2,7 @@
 
 #include "lib/log/svc_logger.hpp"
 #include <string_view>
+#include "program/crash_capture.hpp"
 #include "program/logging.hpp"
 #include "d3/types/enums.hpp"
 
@@ -24,8 +25,15 @@ namespace exl::log {
             GameLogMaybeBuffered(string);
         }
     };
+
+    // Keeps the last few KiB of output for the binary crash capture.
+    struct CrashTailLogger : public ILogger {
+        void LogRaw(std::string_view string) final {
+            d3::crash_capture::RecordLogLine(string);
+        }
+    };
 }  // namespace exl::log
 
-inline exl::log::LoggerMgr<exl::log::SvcLogger> Logging;
+inline exl::log::LoggerMgr<exl::log::SvcLogger, exl::log::CrashTailLogger> Logging;
 
 inline exl::log::LoggerMgr<exl::log::GameLogger> GameLogging;
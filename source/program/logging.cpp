@@ -6,6 +6,8 @@
 #include <cstdio>
 #include <cstring>
 #include "d3/_util.hpp"
+#include "program/async_writer.hpp"
+#include "program/binlog.hpp"
 #include "program/loggers.hpp"
 #include "program/system_allocator.hpp"
 
@@ -78,11 +80,22 @@ namespace exl::log {
         }
 
         auto FlushGameLogBufferIfReady() -> void {
-            if (!IsGameLogReady() || s_game_log_buffer == nullptr || s_game_log_buffer->size() == 0) {
+            if (s_game_log_buffer == nullptr || s_game_log_buffer->size() == 0) {
+                return;
+            }
+
+            auto view = s_game_log_buffer->view();
+            if (d3::async_writer::Running()) {
+                // Already ": line\n" formatted; queue it as one record.
+                if (d3::async_writer::Append(d3::async_writer::kGameLogPath, view.data(), view.size())) {
+                    ReleaseGameLogBuffer();
+                    return;
+                }
+            }
+            if (!IsGameLogReady()) {
                 return;
             }
 
-            auto        view   = s_game_log_buffer->view();
             const char *cursor = view.data();
             const char *end    = cursor + view.size();
 
@@ -114,6 +127,12 @@ namespace exl::log {
     }
 
     void PrintV(const char *fmt, std::va_list vl) {
+        // Binary mode: one id + raw-args record replaces both text sinks. Formats
+        // the encoder cannot represent fall through to the text path.
+        if (d3::binlog::WriteV(fmt, vl)) {
+            return;
+        }
+
         // NOTE: Printing to the game's log streams can recurse into ErrorManager.
         // When we're already handling an internal error or exception, that can
         // cascade into further faults. Keep OutputDebugString alive, but avoid
@@ -183,6 +202,11 @@ namespace exl::log {
         if (string.empty()) {
             return;
         }
+        // Writing through the game's ErrorManager opens the stream file on the
+        // calling thread; hand our lines to the background writer instead.
+        if (d3::async_writer::Append(d3::async_writer::kGameLogPath, {kGameLogPrefix, string, "\n"})) {
+            return;
+        }
         if (IsGameLogReady()) {
             TraceInternal_Log(
                 SLVL_INFO,
@@ -6,8 +6,12 @@
 #include "lib/util/sys/mem_layout.hpp"
 #include "lib/util/sys/modules.hpp"
 #include "program/build_info.hpp"
+#include "program/async_writer.hpp"
+#include "program/binlog.hpp"
 #include "program/boot_report.hpp"
+#include "program/frame_arena.hpp"
 #include "program/hook_registry.hpp"
+#include "program/hook_trace.hpp"
 #include "nn/fs/fs_mount.hpp"
 #include "d3/_util.hpp"
 #include "d3/patches.hpp"
@@ -20,6 +24,7 @@
 #include "d3/types/gfx.hpp"
 #include "program/gui2/imgui_overlay.hpp"
 #include "program/runtime_apply.hpp"
+#include "program/symbolizer.hpp"
 #include "program/logging.hpp"
 #include "program/fs_util.hpp"
 #include "idadefs.h"
@@ -107,6 +112,7 @@ namespace d3 {
 
         static void PrintBootStage(BootStage stage) {
             PRINT("[boot] stage=%s", BootStageName(stage))
+            d3::boot_report::BeginStage(BootStageName(stage));
         }
 
     }  // namespace
@@ -239,11 +245,26 @@ namespace d3 {
             LoadPatchConfig();
 
             PrintBootStage(BootStage::ConfigureLogging);
+            if (global_config.debug.active && global_config.debug.async_writer) {
+                d3::async_writer::Start();
+            }
             exl::log::ConfigureGameFileLogging();
+            if (global_config.debug.active && global_config.debug.binary_log) {
+                d3::binlog::SetEnabled(true);
+                PRINT("Binary log enabled: %s", d3::binlog::kLogPath)
+            }
             if (global_config.debug.enable_exception_handler) {
                 InstallExceptionHandler();
                 PRINT_LINE("User exception handler enabled");
             }
+            if (global_config.debug.active) {
+                // Loaded up front: the crash paths only binary-search it.
+                d3::symbolizer::Load();
+            }
+            d3::frame_arena::Initialize();
+            if (global_config.debug.active && !global_config.debug.trace_hooks.empty()) {
+                d3::hook_trace::Configure(global_config.debug.trace_hooks);
+            }
 
             if (global_config.resolution_hack.active) {
                 const u32 outW   = global_config.resolution_hack.OutputWidthPx();
@@ -275,31 +296,39 @@ namespace d3 {
                         continue;
                     }
                     EXL_ABORT_UNLESS(entry.install != nullptr, "Hook entry missing install: %s", entry.name);
+                    const u64 t0 = d3::boot_report::Tick();
                     entry.install();
-                    d3::boot_report::RecordHook(entry.name);
+                    d3::boot_report::RecordHook(entry.name, t0);
                 }
                 g_configHooksInstalled = true;
             }
 
             PrintBootStage(BootStage::ApplyPatches);
             if (global_config.events.active) {
-                d3::boot_report::RecordPatch("DynamicEvents");
+                const u64 t0 = d3::boot_report::Tick();
                 PatchDynamicEvents();
+                d3::boot_report::RecordPatch("DynamicEvents", t0);
             }
             if (global_config.seasons.active) {
-                d3::boot_report::RecordPatch("DynamicSeasonal");
+                const u64 t0 = d3::boot_report::Tick();
                 PatchDynamicSeasonal();
+                d3::boot_report::RecordPatch("DynamicSeasonal", t0);
             }
             if (global_config.overlays.active && global_config.overlays.buildlocker_watermark) {
-                d3::boot_report::RecordPatch("BuildLocker");
+                const u64 t0 = d3::boot_report::Tick();
                 PatchBuildlocker();
+                d3::boot_report::RecordPatch("BuildLocker", t0);
             }
             if (global_config.resolution_hack.active) {
-                d3::boot_report::RecordPatch("ResolutionTargets");
+                const u64 t0 = d3::boot_report::Tick();
                 PatchResolutionTargets();
+                d3::boot_report::RecordPatch("ResolutionTargets", t0);
+            }
+            {
+                const u64 t0 = d3::boot_report::Tick();
+                PatchBase();
+                d3::boot_report::RecordPatch("Base", t0);
             }
-            d3::boot_report::RecordPatch("Base");
-            PatchBase();
 
             // GUI bringup
             PrintBootStage(BootStage::InitGui);
@@ -307,6 +336,7 @@ namespace d3 {
 
             // Allow game loop to start
             PrintBootStage(BootStage::StartGameLoop);
+            d3::boot_report::SaveHistory();
             Orig();
         }
     };
@@ -336,22 +366,32 @@ namespace d3 {
         }
 
         PrintBootStage(BootStage::EarlyPatches);
+        u64 t0 = d3::boot_report::Tick();
         PatchGraphicsPersistentHeapEarly();
-        d3::boot_report::RecordPatch("GraphicsPersistentHeapEarly");
+        d3::boot_report::RecordPatch("GraphicsPersistentHeapEarly", t0);
 
         PrintBootStage(BootStage::InstallBootHooks);
+        t0 = d3::boot_report::Tick();
         MainInit::InstallAtFuncPtr(main_init);
-        d3::boot_report::RecordHook("boot:MainInit");
+        d3::boot_report::RecordHook("boot:MainInit", t0);
+        t0 = d3::boot_report::Tick();
         GfxInit::InstallAtFuncPtr(gfx_init);
-        d3::boot_report::RecordHook("boot:GfxInit");
+        d3::boot_report::RecordHook("boot:GfxInit", t0);
+        t0 = d3::boot_report::Tick();
         ShellInitialize::InstallAtFuncPtr(shell_initialize);
-        d3::boot_report::RecordHook("boot:ShellInitialize");
+        d3::boot_report::RecordHook("boot:ShellInitialize", t0);
+        t0 = d3::boot_report::Tick();
         GameCommonDataInit::InstallAtFuncPtr(game_common_data_init);
-        d3::boot_report::RecordHook("boot:GameCommonDataInit");
+        d3::boot_report::RecordHook("boot:GameCommonDataInit", t0);
+        t0 = d3::boot_report::Tick();
         SetGameParamsForHero::InstallAtFuncPtr(set_game_params_for_hero);
-        d3::boot_report::RecordHook("boot:SetGameParamsForHero");
+        d3::boot_report::RecordHook("boot:SetGameParamsForHero", t0);
+        t0 = d3::boot_report::Tick();
         sInitializeWorld::InstallAtFuncPtr(sinitialize_world);
-        d3::boot_report::RecordHook("boot:sInitializeWorld");
+        d3::boot_report::RecordHook("boot:sInitializeWorld", t0);
+
+        // The game runs its own startup before MainInit; keep that out of our stages.
+        d3::boot_report::EndStage();
     }
 
 }  // namespace d3
@@ -400,7 +440,12 @@ extern "C" NORETURN void exl_exception_entry() {
             Write("%s: 0x%016llx (", label, static_cast<unsigned long long>(address));
             FileWrite(ref, name.data(), this->offset, static_cast<u32>(name.size()), ERROR_FILE_WRITE);
             this->offset += static_cast<u32>(name.size());
-            Write("+0x%llx)\n", static_cast<unsigned long long>(offset));
+            char symbol[192];
+            if (d3::symbolizer::Format(address, symbol, sizeof(symbol)) != 0) {
+                Write("+0x%llx) %s\n", static_cast<unsigned long long>(offset), symbol);
+            } else {
+                Write("+0x%llx)\n", static_cast<unsigned long long>(offset));
+            }
         }
     };
 
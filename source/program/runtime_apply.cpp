@@ -2,6 +2,7 @@
 
 #include "d3/_util.hpp"
 #include "d3/patches.hpp"
+#include "program/config_snapshot.hpp"
 
 #include <cstdio>
 #include <cstring>
@@ -64,10 +65,14 @@ namespace d3 {
     void ApplyPatchConfigRuntime(const PatchConfig &config, RuntimeApplyResult *out) {
         RuntimeApplyResult result {};
 
-        const PatchConfig prev      = global_config;
+        // Pinning the previous snapshot keeps it intact across Publish, so diff
+        // against it instead of copying global_config first.
+        const auto         prev_pin = config_snapshot::Current();
+        const PatchConfig &prev     = *prev_pin;
         global_config               = config;
         global_config.initialized   = true;
         global_config.defaults_only = false;
+        config_snapshot::Publish(global_config);
 
         // Safe, per-frame-gated features should apply immediately just by updating global_config.
         // For enable-only static patches, re-run patch entrypoints when turning them on.
@@ -0,0 +1,260 @@
+#include "program/sampling_profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string_view>
+
+#include "lib/nx/result.h"
+#include "lib/util/stack_trace.hpp"
+#include "lib/util/sys/mem_layout.hpp"
+#include "lib/util/sys/modules.hpp"
+#include "nn/os.hpp"  // IWYU pragma: keep
+#include "program/config.hpp"
+#include "program/d3/setting.hpp"
+#include "program/fs_util.hpp"
+
+namespace d3::sampling_profiler {
+    namespace {
+        constexpr size_t kStackSize   = 0x4000;
+        constexpr size_t kMaxProbes   = 16;
+        constexpr s64    kIdlePollMs  = 250;
+        constexpr s32    kCoreCount   = 3;  // application cores (npdm lowest_cpu_id..highest_cpu_id)
+        constexpr u32    kModuleShift = 28;  // frame = module index << 28 | offset
+        constexpr u32    kOffsetMask  = (1u << kModuleShift) - 1;
+        constexpr u32    kNoFrame     = ~0u;
+
+        struct Entry {
+            u64                        hash  = 0;
+            u32                        count = 0;
+            u32                        depth = 0;  // 0 = empty slot
+            std::array<u32, kMaxDepth> frames {};  // leaf first
+        };
+
+        std::array<Entry, kMaxStacks> g_table {};
+        nn::os::Mutex                 g_mutex {};
+        Stats                         g_stats {};
+
+        nn::os::ThreadType                         g_thread {};
+        alignas(0x1000) std::array<u8, kStackSize> g_stack {};
+        Handle                                     g_target = INVALID_HANDLE;
+        exl::util::Range                           g_target_stack {};
+        bool                                       g_started = false;
+        std::atomic<bool>                          g_running {false};
+
+        static auto Enabled() -> bool {
+            return global_config.debug.active && global_config.debug.sampling_profiler;
+        }
+
+        static auto EncodeFrame(uintptr_t address) -> u32 {
+            for (int i = static_cast<int>(exl::util::ModuleIndex::Start); i < static_cast<int>(exl::util::ModuleIndex::End); ++i) {
+                const auto index = static_cast<exl::util::ModuleIndex>(i);
+                if (!exl::util::HasModule(index)) {
+                    continue;
+                }
+                const auto &module = exl::util::GetModuleInfo(index);
+                if (address >= module.m_Total.m_Start && address < module.m_Total.GetEnd()) {
+                    const uintptr_t offset = address - module.m_Total.m_Start;
+                    return offset <= kOffsetMask ? (static_cast<u32>(i) << kModuleShift) | static_cast<u32>(offset) : kNoFrame;
+                }
+            }
+            return kNoFrame;
+        }
+
+        static auto HashFrames(const u32 *frames, u32 depth) -> u64 {
+            // 64-bit FNV-1a over the frame words.
+            u64 hash = 14695981039346656037ull;
+            for (u32 i = 0; i < depth; ++i) {
+                hash ^= frames[i];
+                hash *= 1099511628211ull;
+            }
+            return hash | 1;  // never 0
+        }
+
+        // Pauses the target, copies pc, lr and the frame-pointer chain, and
+        // resumes it. Nothing here may allocate or lock: the paused thread could
+        // be holding the heap or our mutex.
+        static auto Capture(std::array<u32, kMaxDepth> &frames) -> u32 {
+            if (R_FAILED(svcSetThreadActivity(g_target, true))) {
+                return 0;
+            }
+            ThreadContext ctx {};
+            const Result  rc    = svcGetThreadContext3(&ctx, g_target);
+            u32           depth = 0;
+            if (R_SUCCEEDED(rc)) {
+                frames[depth++] = EncodeFrame(ctx.pc.x);
+                // In a leaf, lr is the caller that the fp chain skips; otherwise
+                // it is stale and lands in the pc function (merged on the host).
+                const u32 lr = EncodeFrame(ctx.lr);
+                auto      it = exl::util::stack_trace::Iterator(ctx.fp, g_target_stack);
+                if (it.Step()) {
+                    const u32 first = EncodeFrame(it.GetReturnAddress());
+                    if (lr != first && lr != kNoFrame) {
+                        frames[depth++] = lr;
+                    }
+                    frames[depth++] = first;
+                    while (depth < kMaxDepth && it.Step()) {
+                        frames[depth++] = EncodeFrame(it.GetReturnAddress());
+                    }
+                } else if (lr != kNoFrame) {
+                    frames[depth++] = lr;
+                }
+            }
+            (void)svcSetThreadActivity(g_target, false);
+            return depth;
+        }
+
+        static void Record(const std::array<u32, kMaxDepth> &frames, u32 depth) {
+            const u64        hash = HashFrames(frames.data(), depth);
+            std::scoped_lock lock(g_mutex);
+            for (size_t probe = 0; probe < kMaxProbes; ++probe) {
+                Entry &entry = g_table[(hash + probe) & (kMaxStacks - 1)];
+                if (entry.depth == 0) {
+                    entry.hash  = hash;
+                    entry.count = 1;
+                    entry.depth = depth;
+                    std::copy_n(frames.begin(), depth, entry.frames.begin());
+                    ++g_stats.stacks;
+                    ++g_stats.samples;
+                    return;
+                }
+                if (entry.hash == hash && entry.depth == depth && std::equal(frames.begin(), frames.begin() + depth, entry.frames.begin())) {
+                    ++entry.count;
+                    ++g_stats.samples;
+                    return;
+                }
+            }
+            ++g_stats.dropped;
+        }
+
+        static void SamplerMain(void *) {
+            std::array<u32, kMaxDepth> frames {};
+            while (true) {
+                if (!Enabled()) {
+                    nn::os::SleepThread(nn::TimeSpan::FromMilliSeconds(kIdlePollMs));
+                    continue;
+                }
+                const u32 depth = Capture(frames);
+                if (depth != 0) {
+                    Record(frames, depth);
+                } else {
+                    std::scoped_lock lock(g_mutex);
+                    ++g_stats.failed;
+                }
+                nn::os::SleepThread(nn::TimeSpan::FromMicroSeconds(kSampleIntervalUs));
+            }
+        }
+
+        static void AppendFrame(std::string &out, u32 frame) {
+            if (frame == kNoFrame) {
+                out += "??";
+                return;
+            }
+            const auto index = static_cast<exl::util::ModuleIndex>(frame >> kModuleShift);
+            const auto name  = exl::util::HasModule(index) ? exl::util::GetModuleInfo(index).GetModuleName() : std::string_view("??");
+            char       buf[24];
+            const int  n = std::snprintf(buf, sizeof(buf), "+0x%x", frame & kOffsetMask);
+            out.append(name.data(), name.size());
+            if (n > 0) {
+                out.append(buf, static_cast<size_t>(std::min<int>(n, sizeof(buf) - 1)));
+            }
+        }
+    }  // namespace
+
+    void OnPresent() {
+        if (g_started || !Enabled()) {
+            return;
+        }
+        g_started = true;
+
+        auto *self = nn::os::GetCurrentThread();
+        if (self == nullptr) {
+            PRINT_LINE("[profiler] no current thread; sampler not started");
+            return;
+        }
+        g_target       = self->handle;
+        g_target_stack = exl::util::mem_layout::s_Stack;
+        if (self->user_stack != nullptr && self->stack_size != 0) {
+            g_target_stack = {reinterpret_cast<uintptr_t>(self->user_stack), self->stack_size};
+        }
+
+        // Another core: sharing the game thread's core would only ever wake the
+        // sampler while the game thread is blocked. Highest priority because
+        // Capture() runs with the game thread suspended; at a low priority any
+        // thread on the sampler's core could preempt it mid-capture and stall
+        // the game. It sleeps between samples, so the cost is one short burst
+        // per interval.
+        const s32    core = (nn::os::GetCurrentCoreNumber() + 1) % kCoreCount;
+        const Result rc   = nn::os::CreateThread(&g_thread, SamplerMain, nullptr, g_stack.data(), g_stack.size(), nn::os::HighestThreadPriority, core);
+        if (R_FAILED(rc)) {
+            PRINT("[profiler] sampler thread not started (rc=0x%x)", rc)
+            return;
+        }
+        nn::os::SetThreadNamePointer(&g_thread, "d3hack.profiler");
+        nn::os::StartThread(&g_thread);
+        g_running.store(true, std::memory_order_release);
+        PRINT("[profiler] sampling thread '%s' every %lld us from core %d", self->name_pointer != nullptr ? self->name_pointer : "?", static_cast<long long>(kSampleIntervalUs), core)
+    }
+
+    auto Running() -> bool {
+        return g_running.load(std::memory_order_acquire);
+    }
+
+    auto GetStats() -> Stats {
+        std::scoped_lock lock(g_mutex);
+        return g_stats;
+    }
+
+    void Reset() {
+        std::scoped_lock lock(g_mutex);
+        for (auto &entry : g_table) {
+            entry.depth = 0;
+            entry.count = 0;
+        }
+        g_stats = {};
+    }
+
+    auto DumpFolded(const char *path, std::string &error_out) -> bool {
+        std::string text;
+        {
+            std::scoped_lock lock(g_mutex);
+            if (g_stats.stacks == 0) {
+                error_out = "no samples recorded";
+                return false;
+            }
+            text.reserve(256 + static_cast<size_t>(g_stats.stacks) * 160);
+
+            char line[160];
+            int  n = std::snprintf(
+                line,
+                sizeof(line),
+                "# d3hack folded stacks: samples=%llu dropped=%llu failed=%llu interval_us=%lld\n",
+                static_cast<unsigned long long>(g_stats.samples),
+                static_cast<unsigned long long>(g_stats.dropped),
+                static_cast<unsigned long long>(g_stats.failed),
+                static_cast<long long>(kSampleIntervalUs)
+            );
+            text.append(line, static_cast<size_t>(std::clamp<int>(n, 0, sizeof(line) - 1)));
+            const auto main_name = exl::util::GetMainModuleInfo().GetModuleName();
+            const auto self_name = exl::util::GetSelfModuleInfo().GetModuleName();
+            text.append("# module main ").append(main_name.data(), main_name.size()).append("\n");
+            text.append("# module self ").append(self_name.data(), self_name.size()).append("\n");
+
+            for (const auto &entry : g_table) {
+                if (entry.depth == 0) {
+                    continue;
+                }
+                for (u32 i = entry.depth; i-- > 0;) {
+                    AppendFrame(text, entry.frames[i]);
+                    text += i != 0 ? ';' : ' ';
+                }
+                n = std::snprintf(line, sizeof(line), "%u\n", entry.count);
+                text.append(line, static_cast<size_t>(std::clamp<int>(n, 0, sizeof(line) - 1)));
+            }
+        }
+        return fs_util::WriteAllAtomic(path, text, "profile", error_out);
+    }
+
+}  // namespace d3::sampling_profiler
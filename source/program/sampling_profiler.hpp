@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "types.h"
+
+namespace d3::sampling_profiler {
+
+    // Statistical profiler for the game thread (the thread that presents). A
+    // highest-priority thread on another core wakes every kSampleIntervalUs,
+    // pauses the game thread with svcSetThreadActivity, reads pc/lr/fp with
+    // svcGetThreadContext3, walks the frame-pointer chain and resumes it. It
+    // runs high because Capture() holds the game thread suspended; nothing on
+    // its core may preempt it mid-capture. The stack is stored as module+offset
+    // frames in a fixed open-addressed table (identical stacks share one
+    // counter), so memory use is bounded and no allocation happens while
+    // sampling. tools/profile_fold.py symbolizes the exported folded stacks for
+    // flamegraph.pl.
+    constexpr const char *kFoldedPath       = "sd:/config/d3hack-nx/profile.folded";
+    constexpr s64         kSampleIntervalUs = 5000;  // 200 Hz
+    constexpr size_t      kMaxStacks        = 1024;  // power of two
+    constexpr size_t      kMaxDepth         = 24;
+
+    struct Stats {
+        u64 samples = 0;  // stacks recorded
+        u64 dropped = 0;  // table full
+        u64 failed  = 0;  // pause or context read failed
+        u32 stacks  = 0;  // distinct stacks in the table
+    };
+
+    // Present thread only. Attaches to the calling thread and starts the
+    // sampler the first time [debug] SamplingProfiler is on; later toggles
+    // just pause or resume sampling.
+    void OnPresent();
+
+    auto Running() -> bool;
+    auto GetStats() -> Stats;
+
+    // Drops every recorded stack.
+    void Reset();
+
+    // Writes "module+0xoffset;...;module+0xoffset count" lines (root first)
+    // plus "# module" header lines naming the main and self modules.
+    auto DumpFolded(const char *path, std::string &error_out) -> bool;
+
+}  // namespace d3::sampling_profiler
@@ -0,0 +1,188 @@
+#include "program/symbolizer.hpp"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "lib/util/sys/modules.hpp"
+#include "program/d3/setting.hpp"
+#include "program/romfs_assets.hpp"
+#include "types.h"
+
+namespace d3::symbolizer {
+    namespace {
+        constexpr std::array<char, 4> kMagic {'D', '3', 'S', 'Y'};
+        constexpr u32                 kVersion       = 1;
+        constexpr size_t              kMaxIndexBytes = 2 * 1024 * 1024;
+        // Main-module entries have no size; beyond this we are more likely in
+        // an unindexed function than deep inside a known one.
+        constexpr u32 kMaxUnsizedDelta = 0x4000;
+
+        enum ModuleKind : u32 {
+            ModuleKind_Main = 0,
+            ModuleKind_Self = 1,
+        };
+
+        struct Header {
+            char magic[4];
+            u32  version;
+            u32  module_count;
+            u32  pool_offset;
+            u32  pool_size;
+        };
+
+        struct ModuleTable {
+            u32 kind;
+            u32 entry_count;
+            u32 entry_offset;
+            u32 reserved;
+        };
+
+        struct Entry {
+            u32 offset;
+            u32 size;  // 0 = unknown
+            u32 name_offset;
+        };
+
+        struct View {
+            const Entry *entries = nullptr;
+            u32          count   = 0;
+        };
+
+        std::vector<unsigned char> g_blob;
+        const char                *g_pool      = nullptr;
+        u32                        g_pool_size = 0;
+        View                       g_main {};
+        View                       g_self {};
+        bool                       g_loaded = false;
+
+        static auto Validate(const std::vector<unsigned char> &blob) -> bool {
+            if (blob.size() < sizeof(Header)) {
+                return false;
+            }
+            Header header {};
+            std::memcpy(&header, blob.data(), sizeof(header));
+            if (std::memcmp(header.magic, kMagic.data(), kMagic.size()) != 0 || header.version != kVersion) {
+                return false;
+            }
+            const u64 size = blob.size();
+            if (static_cast<u64>(header.pool_offset) + header.pool_size > size || header.pool_size == 0 ||
+                blob[header.pool_offset + header.pool_size - 1] != '\0') {
+                return false;
+            }
+            const u64 tables_end = sizeof(Header) + static_cast<u64>(header.module_count) * sizeof(ModuleTable);
+            if (tables_end > size) {
+                return false;
+            }
+            for (u32 i = 0; i < header.module_count; ++i) {
+                ModuleTable table {};
+                std::memcpy(&table, blob.data() + sizeof(Header) + i * sizeof(ModuleTable), sizeof(table));
+                if (table.entry_offset % alignof(Entry) != 0 ||
+                    static_cast<u64>(table.entry_offset) + static_cast<u64>(table.entry_count) * sizeof(Entry) > size) {
+                    return false;
+                }
+                const auto *entries = reinterpret_cast<const Entry *>(blob.data() + table.entry_offset);
+                for (u32 e = 0; e < table.entry_count; ++e) {
+                    if (entries[e].name_offset >= header.pool_size || (e != 0 && entries[e].offset <= entries[e - 1].offset)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Last entry whose start is <= offset.
+        static auto Find(const View &view, u32 offset) -> const Entry * {
+            u32 lo = 0;
+            u32 hi = view.count;
+            while (lo < hi) {
+                const u32 mid = lo + ((hi - lo) / 2);
+                if (view.entries[mid].offset <= offset) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            return lo == 0 ? nullptr : &view.entries[lo - 1];
+        }
+    }  // namespace
+
+    auto Load() -> bool {
+        if (g_loaded) {
+            return true;
+        }
+        std::vector<unsigned char> blob;
+        if (!d3::romfs::ReadFileToBytes(kIndexPath, blob, kMaxIndexBytes)) {
+            PRINT("[symbolizer] %s not found; crash dumps keep raw offsets", kIndexPath)
+            return false;
+        }
+        if (!Validate(blob)) {
+            PRINT("[symbolizer] %s is malformed (%lu bytes); ignored", kIndexPath, static_cast<unsigned long>(blob.size()))
+            return false;
+        }
+
+        g_blob = std::move(blob);
+        Header header {};
+        std::memcpy(&header, g_blob.data(), sizeof(header));
+        g_pool      = reinterpret_cast<const char *>(g_blob.data() + header.pool_offset);
+        g_pool_size = header.pool_size;
+        for (u32 i = 0; i < header.module_count; ++i) {
+            ModuleTable table {};
+            std::memcpy(&table, g_blob.data() + sizeof(Header) + i * sizeof(ModuleTable), sizeof(table));
+            const View view {reinterpret_cast<const Entry *>(g_blob.data() + table.entry_offset), table.entry_count};
+            if (table.kind == ModuleKind_Main) {
+                g_main = view;
+            } else if (table.kind == ModuleKind_Self) {
+                g_self = view;
+            }
+        }
+        g_loaded = true;
+        PRINT("[symbolizer] loaded %u main + %u self symbols (%lu bytes)", g_main.count, g_self.count, static_cast<unsigned long>(g_blob.size()))
+        return true;
+    }
+
+    auto Loaded() -> bool {
+        return g_loaded;
+    }
+
+    auto Format(uintptr_t address, char *out, size_t out_size) -> size_t {
+        if (!g_loaded || out == nullptr || out_size == 0) {
+            return 0;
+        }
+        const auto *module = exl::util::TryGetModule(address);
+        if (module == nullptr) {
+            return 0;
+        }
+
+        const View *view = nullptr;
+        if (module == &exl::util::GetMainModuleInfo()) {
+            view = &g_main;
+        } else if (module == &exl::util::GetSelfModuleInfo()) {
+            view = &g_self;
+        }
+        if (view == nullptr || view->count == 0) {
+            return 0;
+        }
+
+        const u64 rel = address - module->m_Total.m_Start;
+        if (rel > 0xFFFFFFFFull) {
+            return 0;
+        }
+        const Entry *entry = Find(*view, static_cast<u32>(rel));
+        if (entry == nullptr) {
+            return 0;
+        }
+        const u32 delta = static_cast<u32>(rel) - entry->offset;
+        if ((entry->size != 0 && delta >= entry->size) || (entry->size == 0 && delta > kMaxUnsizedDelta)) {
+            return 0;
+        }
+
+        const int n = std::snprintf(out, out_size, "%s+0x%x", g_pool + entry->name_offset, delta);
+        if (n <= 0) {
+            return 0;
+        }
+        return static_cast<size_t>(n) < out_size ? static_cast<size_t>(n) : out_size - 1;
+    }
+
+}  // namespace d3::symbolizer
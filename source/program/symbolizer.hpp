@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace d3::symbolizer {
+
+    // Built by tools/build_symbol_index.py at post-build: function starts for
+    // the main module (offsets.hpp) and for our own module (ELF .symtab).
+    constexpr const char *kIndexPath = "romfs:/d3gui/symbols.d3sy";
+
+    // Reads and validates the index. Call once at boot; allocates.
+    auto Load() -> bool;
+    auto Loaded() -> bool;
+
+    // Writes "name+0xdelta" for `address` into `out` and returns its length,
+    // or 0 when the address is outside an indexed module or too far past the
+    // nearest known symbol. No allocation or locking: safe from exception
+    // handlers once Load() has returned.
+    auto Format(uintptr_t address, char *out, size_t out_size) -> size_t;
+
+}  // namespace d3::symbolizer
@@ -334,7 +334,15 @@ namespace {
             return false;
         }
 
-        if (!UploadTextureRegion(tex, backend, tex->UpdateRect)) {
+        // Upload each dirty region separately: newly baked glyphs land in small,
+        // scattered rects, and their bounding box can cover most of the atlas.
+        if (tex->Updates.Size > 0) {
+            for (const ImTextureRect &rect : tex->Updates) {
+                if (!UploadTextureRegion(tex, backend, rect)) {
+                    return false;
+                }
+            }
+        } else if (!UploadTextureRegion(tex, backend, tex->UpdateRect)) {
             return false;
         }
 
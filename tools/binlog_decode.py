@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""Decode the binary log stream written by source/program/binlog.cpp.
+
+Usage:
+  binlog_decode.py d3hack_log.bin [-o out.txt] [--no-time]
+
+The device writes sd:/config/d3hack-nx/d3hack_log.bin when [debug] BinaryLog
+is enabled. The file is self-describing: each format string is stored once in
+a definition record, later messages only carry the format id and raw argument
+bytes. This tool re-applies the printf formats on the host.
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+import struct
+import sys
+from dataclasses import dataclass
+
+MAGIC = b"D3BL"
+VERSION = 1
+
+REC_FORMAT_DEF = 1
+REC_MESSAGE = 2
+REC_TICK_BASE = 3
+
+KIND_I32, KIND_I64, KIND_F64, KIND_STR, KIND_PTR = range(5)
+NULL_STRING = 0xFFFF
+
+HEADER = struct.Struct("<4sIQ")
+RECORD = struct.Struct("<BBHHHI")
+
+SPEC_RE = re.compile(r"%([-+ #0']*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|z|j|t)?([diouxXcfFeEgGaAsp%])")
+
+
+@dataclass
+class Format:
+    text: str
+    kinds: list[int]
+
+
+def read_args(kinds: list[int], payload: bytes) -> list:
+    args = []
+    pos = 0
+    for kind in kinds:
+        if kind == KIND_I32:
+            args.append(struct.unpack_from("<i", payload, pos)[0])
+            pos += 4
+        elif kind == KIND_I64:
+            args.append(struct.unpack_from("<q", payload, pos)[0])
+            pos += 8
+        elif kind == KIND_F64:
+            args.append(struct.unpack_from("<d", payload, pos)[0])
+            pos += 8
+        elif kind == KIND_PTR:
+            args.append(struct.unpack_from("<Q", payload, pos)[0])
+            pos += 8
+        elif kind == KIND_STR:
+            (length,) = struct.unpack_from("<H", payload, pos)
+            pos += 2
+            if length == NULL_STRING:
+                args.append(None)
+            else:
+                args.append(payload[pos : pos + length].decode("utf-8", errors="replace"))
+                pos += length
+        else:
+            raise ValueError(f"unknown argument kind {kind}")
+    return args
+
+
+def apply_format(fmt: str, args: list) -> str:
+    out = []
+    it = iter(args)
+    last = 0
+    for m in SPEC_RE.finditer(fmt):
+        out.append(fmt[last : m.start()])
+        last = m.end()
+        flags, width, precision, length, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        flags = (flags or "").replace("'", "")
+        if width == "*":
+            width = str(next(it))
+        if precision == "*":
+            precision = str(next(it))
+        value = next(it)
+        spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+        bits = 64 if length in ("l", "ll", "z", "j", "t") else 32
+        if conv in "uoxX":
+            value &= (1 << bits) - 1
+            out.append((spec + ("d" if conv == "u" else conv)) % value)
+        elif conv in "di":
+            out.append((spec + "d") % value)
+        elif conv == "c":
+            out.append((spec + "c") % chr(value & 0xFF))
+        elif conv in "aA":
+            text = float.hex(value)
+            out.append((spec + "s") % (text.upper() if conv == "A" else text))
+        elif conv in "fFeEgG":
+            out.append((spec + conv) % value)
+        elif conv == "s":
+            out.append((spec + "s") % ("(null)" if value is None else value))
+        elif conv == "p":
+            out.append((spec + "s") % ("(nil)" if value == 0 else f"0x{value:x}"))
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def decode(data: bytes, show_time: bool, write) -> int:
+    if len(data) < HEADER.size:
+        raise ValueError("file too small")
+    magic, version, freq = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError(f"not a binlog v{VERSION} file")
+    freq = freq or 19_200_000
+
+    formats: dict[int, Format] = {}
+    tick = 0
+    first_tick = None
+    pos = HEADER.size
+    count = 0
+    while pos + RECORD.size <= len(data):
+        rtype, argc, fmt_id, size, _reserved, delta = RECORD.unpack_from(data, pos)
+        pos += RECORD.size
+        payload = data[pos : pos + size]
+        pos += size
+        if len(payload) < size:
+            print("warning: truncated trailing record", file=sys.stderr)
+            break
+        tick += delta
+        if rtype == REC_TICK_BASE:
+            (tick,) = struct.unpack_from("<Q", payload, 0)
+        elif rtype == REC_FORMAT_DEF:
+            kinds = list(payload[:argc])
+            formats[fmt_id] = Format(payload[argc:].decode("utf-8", errors="replace"), kinds)
+        elif rtype == REC_MESSAGE:
+            fmt = formats.get(fmt_id)
+            if fmt is None:
+                text = f"<undefined format {fmt_id}>"
+            else:
+                text = apply_format(fmt.text, read_args(fmt.kinds, payload))
+            if first_tick is None:
+                first_tick = tick
+            prefix = f"[{(tick - first_tick) / freq:12.6f}] " if show_time else ""
+            write(prefix + text.rstrip("\n") + "\n")
+            count += 1
+        else:
+            print(f"warning: unknown record type {rtype} at 0x{pos:x}", file=sys.stderr)
+    return count
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input")
+    parser.add_argument("-o", "--output")
+    parser.add_argument("--no-time", action="store_true", help="omit the relative timestamp column")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+    out = open(args.output, "w", encoding="utf-8") if args.output else sys.stdout
+    try:
+        count = decode(data, not args.no_time, out.write)
+    finally:
+        if out is not sys.stdout:
+            out.close()
+    print(f"{count} messages, {len(data)} bytes", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
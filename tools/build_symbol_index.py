@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""
+Build the crash-time symbol index (symbols.d3sy) shipped in romfs.
+
+Usage:
+  python3 tools/build_symbol_index.py \
+      [--offsets source/program/offsets.hpp] [--symbols source/program/symbols] \
+      [--elf d3hack-nx.elf] [--out build/romfs/d3gui/symbols.d3sy] [--dump FILE]
+
+Sources:
+- main module: "sym_<name>" entries of the DEFAULT table in offsets.hpp. Inline
+  hook sites (FUNC_PTR lines marked "Inline hook site" in symbols/*.inc) are
+  skipped because they are not function starts. Sizes are unknown (0).
+- self module: STT_FUNC symbols from our ELF's .symtab, demangled with
+  c++filt when available.
+
+Layout (little-endian), consumed in place by program/symbolizer.cpp:
+    header  : magic "D3SY", u32 version, u32 module_count, u32 pool_offset,
+              u32 pool_size
+    modules : module_count x {u32 kind (0 = main, 1 = self), u32 entry_count,
+              u32 entry_offset, u32 reserved}
+    entries : per module, entry_count x {u32 offset, u32 size, u32 name_offset}
+              sorted by offset (size 0 = unknown)
+    pool    : NUL-terminated names
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+import shutil
+import struct
+import subprocess
+import sys
+from pathlib import Path
+
+MAGIC = b"D3SY"
+VERSION = 1
+HEADER = struct.Struct("<4s4I")
+MODULE = struct.Struct("<4I")
+ENTRY = struct.Struct("<3I")
+
+KIND_MAIN = 0
+KIND_SELF = 1
+MAX_NAME = 120
+
+TABLE_START = re.compile(r"UserTableType<VersionType::(\w+),")
+OFFSET_ENTRY = re.compile(r'\{\s*util::ModuleIndex::Main,\s*(0x[0-9A-Fa-f]+),\s*"sym_(\w+)"\s*\}')
+INLINE_SITE = re.compile(r"FUNC_PTR\((\w+),.*Inline hook site")
+
+
+def read_main_symbols(offsets_path: Path, symbols_dir: Path) -> list[tuple[int, int, str]]:
+    inline_sites: set[str] = set()
+    for inc in sorted(symbols_dir.glob("*.inc")):
+        for line in inc.read_text(encoding="utf-8").splitlines():
+            m = INLINE_SITE.search(line)
+            if m:
+                inline_sites.add(m.group(1))
+
+    out: list[tuple[int, int, str]] = []
+    table = None
+    for line in offsets_path.read_text(encoding="utf-8").splitlines():
+        m = TABLE_START.search(line)
+        if m:
+            table = m.group(1)
+            continue
+        if table != "DEFAULT":
+            continue
+        m = OFFSET_ENTRY.search(line)
+        if m and m.group(2) not in inline_sites:
+            out.append((int(m.group(1), 16), 0, m.group(2)))
+    return out
+
+
+def demangle(names: list[str]) -> list[str]:
+    tool = shutil.which("c++filt") or shutil.which("aarch64-none-elf-c++filt")
+    if tool is None or not names:
+        return names
+    try:
+        res = subprocess.run([tool], input="\n".join(names), capture_output=True, text=True, check=True)
+    except (OSError, subprocess.CalledProcessError):
+        return names
+    lines = res.stdout.splitlines()
+    return lines if len(lines) == len(names) else names
+
+
+def read_elf_symbols(elf_path: Path) -> list[tuple[int, int, str]]:
+    data = elf_path.read_bytes()
+    if data[:4] != b"\x7fELF" or data[4] != 2 or data[5] != 1:
+        raise ValueError("not a little-endian ELF64 file")
+    shoff, = struct.unpack_from("<Q", data, 0x28)
+    shentsize, shnum = struct.unpack_from("<HH", data, 0x3A)
+
+    sections = [struct.unpack_from("<IIQQQQIIQQ", data, shoff + i * shentsize) for i in range(shnum)]
+    symtab = next((s for s in sections if s[1] == 2), None)  # SHT_SYMTAB
+    if symtab is None:
+        raise ValueError("no .symtab (stripped ELF?)")
+    strtab = sections[symtab[6]]
+    str_off = strtab[4]
+
+    raw: list[tuple[int, int, str]] = []
+    sym_off, sym_size, sym_ent = symtab[4], symtab[5], symtab[9] or 24
+    for pos in range(sym_off, sym_off + sym_size, sym_ent):
+        name_idx, info, _other, shndx, value, size = struct.unpack_from("<IBBHQQ", data, pos)
+        if (info & 0xF) != 2 or shndx == 0 or value == 0:  # STT_FUNC, defined
+            continue
+        end = data.index(b"\0", str_off + name_idx)
+        raw.append((value, size, data[str_off + name_idx : end].decode("utf-8", "replace")))
+
+    names = demangle([r[2] for r in raw])
+    return [(off, size, name) for (off, size, _), name in zip(raw, names)]
+
+
+def sort_unique(entries: list[tuple[int, int, str]]) -> list[tuple[int, int, str]]:
+    # One name per start offset; prefer entries that know their size (aliases
+    # such as C1/C2 constructors share an address).
+    best: dict[int, tuple[int, int, str]] = {}
+    for e in entries:
+        cur = best.get(e[0])
+        if cur is None or (cur[1] == 0 and e[1] != 0):
+            best[e[0]] = e
+    return [best[k] for k in sorted(best)]
+
+
+def build_index(modules: list[tuple[int, list[tuple[int, int, str]]]]) -> bytes:
+    pool = bytearray()
+    pool_index: dict[str, int] = {}
+    tables: list[tuple[int, list[tuple[int, int, int]]]] = []
+    for kind, entries in modules:
+        rows = []
+        for off, size, name in sort_unique(entries):
+            name = name[:MAX_NAME]
+            if name not in pool_index:
+                pool_index[name] = len(pool)
+                pool += name.encode("utf-8") + b"\0"
+            rows.append((off, min(size, 0xFFFFFFFF), pool_index[name]))
+        tables.append((kind, rows))
+
+    entry_offset = HEADER.size + MODULE.size * len(tables)
+    module_rows = []
+    for kind, rows in tables:
+        module_rows.append(MODULE.pack(kind, len(rows), entry_offset, 0))
+        entry_offset += ENTRY.size * len(rows)
+
+    out = bytearray(HEADER.pack(MAGIC, VERSION, len(tables), entry_offset, len(pool)))
+    for row in module_rows:
+        out += row
+    for _, rows in tables:
+        for row in rows:
+            out += ENTRY.pack(*row)
+    out += pool
+    return bytes(out)
+
+
+def dump_index(path: Path) -> int:
+    data = path.read_bytes()
+    magic, version, count, pool_off, pool_size = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION:
+        print(f"{path}: not a v{VERSION} D3SY index", file=sys.stderr)
+        return 1
+    print(f"{path}: modules={count} pool={pool_size} bytes total={len(data)} bytes")
+    for i in range(count):
+        kind, n, off, _ = MODULE.unpack_from(data, HEADER.size + i * MODULE.size)
+        print(f"[{'main' if kind == KIND_MAIN else 'self'}] {n} entries")
+        for j in range(n):
+            start, size, name_off = ENTRY.unpack_from(data, off + j * ENTRY.size)
+            end = data.index(b"\0", pool_off + name_off)
+            print(f"  {start:08x} {size:6x} {data[pool_off + name_off : end].decode('utf-8')}")
+    return 0
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--offsets", type=Path, default=Path("source/program/offsets.hpp"))
+    ap.add_argument("--symbols", type=Path, default=Path("source/program/symbols"))
+    ap.add_argument("--elf", type=Path, default=None)
+    ap.add_argument("--out", type=Path, default=Path("symbols.d3sy"))
+    ap.add_argument("--dump", type=Path, default=None)
+    args = ap.parse_args()
+
+    if args.dump is not None:
+        return dump_index(args.dump)
+
+    modules = [(KIND_MAIN, read_main_symbols(args.offsets, args.symbols))]
+    if args.elf is not None:
+        try:
+            modules.append((KIND_SELF, read_elf_symbols(args.elf)))
+        except (OSError, ValueError) as exc:
+            print(f"[symbols] {args.elf}: {exc}; main module only", file=sys.stderr)
+
+    blob = build_index(modules)
+    args.out.parent.mkdir(parents=True, exist_ok=True)
+    args.out.write_bytes(blob)
+    counts = " ".join(f"{'main' if k == KIND_MAIN else 'self'}={len(e)}" for k, e in modules)
+    print(f"[symbols] {args.out}: {counts} bytes={len(blob)}")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+Compile data/strings_<lang>.toml into binary translation bundles (.d3tr).
+
+Usage:
+  python3 tools/build_translation_bundles.py \
+      [--src data] [--dst build/romfs/d3gui] [--lang de --lang fr ...] [--dump FILE]
+
+Notes:
+- One bundle per language: strings_<lang>.d3tr next to the TOML in --dst.
+  English is skipped (the C++ fallbacks are the English strings).
+- strings_meta.toml is not a translation file and is ignored.
+- Layout (little-endian), consumed in place by gui2/ui/translation_table.cpp:
+    header   : magic "D3TR", u32 version, u32 entry_count, u32 glyph_count,
+               u32 index_offset, u32 glyph_offset, u32 pool_offset, u32 pool_size
+    index    : entry_count x {u64 key_hash, u32 key_offset, u32 value_offset},
+               sorted by key_hash (FNV-1a 64 of the dotted key, 0 remapped to 1)
+    glyphs   : glyph_count x u32 codepoints (sorted, unique, from all values)
+    pool     : NUL-terminated UTF-8 keys and values
+- --dump prints a bundle's entries (for checking a build output).
+"""
+
+from __future__ import annotations
+
+import argparse
+import struct
+import sys
+from pathlib import Path
+
+try:
+    import tomllib  # Python 3.11+
+except ModuleNotFoundError:
+    try:
+        import tomli as tomllib  # same API, pip install tomli
+    except ModuleNotFoundError:
+        sys.exit("build_translation_bundles: needs Python 3.11+ (tomllib) or the tomli package")
+
+MAGIC = b"D3TR"
+VERSION = 1
+HEADER = struct.Struct("<4s7I")
+ENTRY = struct.Struct("<QII")
+
+FNV_OFFSET = 14695981039346656037
+FNV_PRIME = 1099511628211
+
+
+def fnv1a64(data: bytes) -> int:
+    h = FNV_OFFSET
+    for b in data:
+        h ^= b
+        h = (h * FNV_PRIME) & 0xFFFFFFFFFFFFFFFF
+    return h if h != 0 else 1
+
+
+def flatten(table: dict, prefix: str, out: dict[str, str]) -> None:
+    for key, value in table.items():
+        full = f"{prefix}.{key}" if prefix else key
+        if isinstance(value, dict):
+            flatten(value, full, out)
+        elif isinstance(value, str):
+            out[full] = value
+
+
+def build_bundle(strings: dict[str, str]) -> bytes:
+    pool = bytearray()
+    entries: list[tuple[int, int, int]] = []
+    glyphs: set[int] = set()
+    for key, value in strings.items():
+        key_bytes = key.encode("utf-8")
+        key_off = len(pool)
+        pool += key_bytes + b"\0"
+        value_off = len(pool)
+        pool += value.encode("utf-8") + b"\0"
+        entries.append((fnv1a64(key_bytes), key_off, value_off))
+        glyphs.update(ord(ch) for ch in value)
+
+    entries.sort(key=lambda e: e[0])
+    for a, b in zip(entries, entries[1:]):
+        if a[0] == b[0]:
+            raise ValueError("key hash collision; the runtime lookup would be ambiguous")
+
+    glyph_list = sorted(g for g in glyphs if g >= 0x20)
+    index_offset = HEADER.size
+    glyph_offset = index_offset + len(entries) * ENTRY.size
+    pool_offset = glyph_offset + len(glyph_list) * 4
+
+    out = bytearray()
+    out += HEADER.pack(
+        MAGIC, VERSION, len(entries), len(glyph_list), index_offset, glyph_offset, pool_offset, len(pool)
+    )
+    for entry in entries:
+        out += ENTRY.pack(*entry)
+    for glyph in glyph_list:
+        out += struct.pack("<I", glyph)
+    out += pool
+    return bytes(out)
+
+
+def dump_bundle(path: Path) -> int:
+    data = path.read_bytes()
+    magic, version, count, glyph_count, index_off, glyph_off, pool_off, pool_size = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION:
+        print(f"{path}: not a v{VERSION} D3TR bundle", file=sys.stderr)
+        return 1
+    pool = data[pool_off : pool_off + pool_size]
+
+    def cstr(off: int) -> str:
+        end = pool.index(b"\0", off)
+        return pool[off:end].decode("utf-8")
+
+    print(f"{path}: entries={count} glyphs={glyph_count} pool={pool_size} bytes total={len(data)} bytes")
+    for i in range(count):
+        h, key_off, value_off = ENTRY.unpack_from(data, index_off + i * ENTRY.size)
+        print(f"{h:016x} {cstr(key_off)} = {cstr(value_off)!r}")
+    return 0
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--src", type=Path, default=Path("data"))
+    ap.add_argument("--dst", type=Path, default=None)
+    ap.add_argument("--lang", action="append", default=[])
+    ap.add_argument("--dump", type=Path, default=None)
+    args = ap.parse_args()
+
+    if args.dump is not None:
+        return dump_bundle(args.dump)
+
+    dst = args.dst or args.src
+    dst.mkdir(parents=True, exist_ok=True)
+
+    built = 0
+    for toml_path in sorted(args.src.glob("strings_*.toml")):
+        lang = toml_path.stem.removeprefix("strings_")
+        if lang in ("en", "meta") or (args.lang and lang not in args.lang):
+            continue
+        with toml_path.open("rb") as f:
+            table = tomllib.load(f)
+        strings: dict[str, str] = {}
+        flatten(table, "", strings)
+        try:
+            blob = build_bundle(strings)
+        except ValueError as exc:
+            print(f"{toml_path}: {exc}", file=sys.stderr)
+            return 1
+        out_path = dst / f"strings_{lang}.d3tr"
+        out_path.write_bytes(blob)
+        print(f"[translations] {out_path}: keys={len(strings)} bytes={len(blob)}")
+        built += 1
+
+    if built == 0:
+        print("[translations] no bundles built", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,376 @@
+#!/usr/bin/env python3
+"""Pretty-print a binary crash capture written by source/program/crash_capture.cpp.
+
+Usage:
+  crash_analyze.py crash.d3cr [--symbols symbols.d3sy] [--offsets source/program/offsets.hpp]
+                   [--no-log] [--stack-words N]
+
+The device writes sd:/config/d3hack-nx/crash.d3cr from the user exception
+handler: registers, the stack window above sp, code bytes around pc/lr, the
+module list, installed hooks/patches and the last few KiB of log output.
+
+Addresses are symbolized with the crash-time index (symbols.d3sy, found in the
+build's romfs/d3gui directory) when given; otherwise main-module addresses fall
+back to the offsets.hpp DEFAULT table. The backtrace is rebuilt on the host by
+walking the frame-pointer chain through the captured stack bytes, followed by a
+scan for stack words that point into module text.
+"""
+
+from __future__ import annotations
+
+import argparse
+import bisect
+import struct
+import sys
+from dataclasses import dataclass, field
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent))
+import build_symbol_index as symidx  # noqa: E402
+
+MAGIC = b"D3CR"
+VERSION = 1
+HEADER = struct.Struct("<4s3IQQIi")
+SECTION = struct.Struct("<II")
+MEMORY = struct.Struct("<QII")
+MODULE = struct.Struct("<IIQQQQ64s")
+
+SEC_REGISTERS = 1
+SEC_MEMORY = 2
+SEC_MODULES = 3
+SEC_HOOKS = 4
+SEC_LOG_TAIL = 5
+SEC_BUILD = 6
+
+MEM_STACK, MEM_CODE_PC, MEM_CODE_LR, MEM_FAR = range(4)
+MEM_NAMES = {MEM_STACK: "stack", MEM_CODE_PC: "code@pc", MEM_CODE_LR: "code@lr", MEM_FAR: "far"}
+
+MODULE_FLAG_MAIN = 1
+MODULE_FLAG_SELF = 2
+
+# nn::os::UserExceptionInfoDetail (816 bytes, static_assert'ed on the device side).
+DETAIL_SIZE = 816
+OFF_SP, OFF_PSTATE = 248, 784  # sp, pc follow r[31]; pstate follows v[32]
+
+EXCEPTION_TYPES = {
+    0x0000: "None",
+    0x0100: "InvalidInstructionAccess",
+    0x0101: "InvalidDataAccess",
+    0x0102: "UnalignedInstructionAccess",
+    0x0103: "UnalignedDataAccess",
+    0x0104: "UndefinedInstruction",
+    0x0105: "ExceptionalInstruction",
+    0x0106: "MemorySystemError",
+    0x0200: "FloatingPointException",
+    0x0301: "InvalidSystemCall",
+}
+
+MAX_FRAMES = 64
+LOG_TAIL_BYTES = 8 * 1024  # crash_capture::kLogTailBytes
+MAX_UNSIZED_DELTA = 0x4000  # matches symbolizer.cpp
+
+
+@dataclass
+class Module:
+    index: int
+    flags: int
+    start: int
+    end: int
+    text_start: int
+    text_end: int
+    name: str
+
+
+@dataclass
+class Registers:
+    x: list[int]
+    sp: int
+    pc: int
+    pstate: int
+    fpcr: int
+    fpsr: int
+    afsr0: int
+    afsr1: int
+    esr: int
+    far: int
+
+    @property
+    def fp(self) -> int:
+        return self.x[29]
+
+    @property
+    def lr(self) -> int:
+        return self.x[30]
+
+
+@dataclass
+class Capture:
+    exception_type: int = 0
+    core: int = 0
+    tick: int = 0
+    tick_frequency: int = 0
+    build: str = ""
+    registers: Registers | None = None
+    memory: list[tuple[int, int, bytes]] = field(default_factory=list)
+    modules: list[Module] = field(default_factory=list)
+    hooks: list[list[str]] = field(default_factory=list)
+    log_tail: str = ""
+
+
+class Symbols:
+    """Function starts per module kind, as in symbols.d3sy."""
+
+    def __init__(self) -> None:
+        self.tables: dict[int, tuple[list[int], list[tuple[int, str]]]] = {}
+
+    def add(self, kind: int, entries: list[tuple[int, int, str]]) -> None:
+        rows = symidx.sort_unique(entries)
+        self.tables[kind] = ([r[0] for r in rows], [(r[1], r[2]) for r in rows])
+
+    def lookup(self, kind: int, offset: int) -> str | None:
+        table = self.tables.get(kind)
+        if table is None:
+            return None
+        starts, rows = table
+        i = bisect.bisect_right(starts, offset) - 1
+        if i < 0:
+            return None
+        size, name = rows[i]
+        delta = offset - starts[i]
+        if (size != 0 and delta >= size) or (size == 0 and delta > MAX_UNSIZED_DELTA):
+            return None
+        return f"{name}+0x{delta:x}"
+
+    @classmethod
+    def from_index(cls, path: Path) -> Symbols:
+        data = path.read_bytes()
+        magic, version, count, pool_off, _pool_size = symidx.HEADER.unpack_from(data, 0)
+        if magic != symidx.MAGIC or version != symidx.VERSION:
+            raise ValueError(f"{path}: not a v{symidx.VERSION} D3SY index")
+        out = cls()
+        for i in range(count):
+            kind, n, off, _ = symidx.MODULE.unpack_from(data, symidx.HEADER.size + i * symidx.MODULE.size)
+            entries = []
+            for j in range(n):
+                start, size, name_off = symidx.ENTRY.unpack_from(data, off + j * symidx.ENTRY.size)
+                end = data.index(b"\0", pool_off + name_off)
+                entries.append((start, size, data[pool_off + name_off : end].decode("utf-8", "replace")))
+            out.add(kind, entries)
+        return out
+
+
+def parse(data: bytes) -> Capture:
+    if len(data) < HEADER.size:
+        raise ValueError("file too small")
+    magic, version, section_count, total, tick, freq, etype, core = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError(f"not a v{VERSION} D3CR capture")
+    if total > len(data):
+        print(f"warning: capture truncated ({len(data)} of {total} bytes)", file=sys.stderr)
+        total = len(data)
+
+    cap = Capture(exception_type=etype, core=core, tick=tick, tick_frequency=freq)
+    pos = HEADER.size
+    for _ in range(section_count):
+        if pos + SECTION.size > total:
+            break
+        kind, size = SECTION.unpack_from(data, pos)
+        payload = data[pos + SECTION.size : pos + SECTION.size + size]
+        pos += SECTION.size + ((size + 7) & ~7)
+
+        if kind == SEC_REGISTERS and len(payload) >= DETAIL_SIZE:
+            x = list(struct.unpack_from("<31Q", payload, 0))
+            sp, pc = struct.unpack_from("<QQ", payload, OFF_SP)
+            pstate, fpcr, fpsr, afsr0, afsr1, esr, far = struct.unpack_from("<6IQ", payload, OFF_PSTATE)
+            cap.registers = Registers(x, sp, pc, pstate, fpcr, fpsr, afsr0, afsr1, esr, far)
+        elif kind == SEC_MEMORY and len(payload) >= MEMORY.size:
+            address, mkind, _ = MEMORY.unpack_from(payload, 0)
+            cap.memory.append((mkind, address, payload[MEMORY.size :]))
+        elif kind == SEC_MODULES and len(payload) >= 8:
+            count, _ = struct.unpack_from("<II", payload, 0)
+            count = min(count, (len(payload) - 8) // MODULE.size)
+            for i in range(count):
+                index, flags, start, end, ts, te, name = MODULE.unpack_from(payload, 8 + i * MODULE.size)
+                cap.modules.append(Module(index, flags, start, end, ts, te, name.split(b"\0", 1)[0].decode("utf-8", "replace")))
+        elif kind == SEC_HOOKS:
+            cap.hooks = [line.split("\t") for line in payload.decode("utf-8", "replace").splitlines() if line]
+        elif kind == SEC_LOG_TAIL:
+            cap.log_tail = payload.decode("utf-8", "replace")
+        elif kind == SEC_BUILD:
+            cap.build = payload.decode("utf-8", "replace")
+    return cap
+
+
+class Analyzer:
+    def __init__(self, cap: Capture, symbols: Symbols | None) -> None:
+        self.cap = cap
+        self.symbols = symbols
+        self.stack = next(((a, b) for k, a, b in cap.memory if k == MEM_STACK), None)
+
+    def module_for(self, address: int) -> Module | None:
+        for m in self.cap.modules:
+            if m.start <= address < m.end:
+                return m
+        return None
+
+    def in_text(self, address: int) -> bool:
+        return any(m.text_start <= address < m.text_end for m in self.cap.modules)
+
+    def describe(self, address: int) -> str:
+        m = self.module_for(address)
+        if m is None:
+            return f"0x{address:016x}"
+        out = f"0x{address:016x} ({m.name}+0x{address - m.start:x})"
+        if self.symbols is not None:
+            kind = symidx.KIND_MAIN if m.flags & MODULE_FLAG_MAIN else symidx.KIND_SELF if m.flags & MODULE_FLAG_SELF else None
+            sym = self.symbols.lookup(kind, address - m.start) if kind is not None else None
+            if sym:
+                out += f" {sym}"
+        return out
+
+    def read_stack_u64(self, address: int) -> int | None:
+        if self.stack is None:
+            return None
+        base, data = self.stack
+        off = address - base
+        if off < 0 or off + 8 > len(data):
+            return None
+        return struct.unpack_from("<Q", data, off)[0]
+
+    def backtrace(self) -> list[int]:
+        regs = self.cap.registers
+        frames: list[int] = []
+        fp = regs.fp
+        while fp and len(frames) < MAX_FRAMES:
+            next_fp = self.read_stack_u64(fp)
+            ret = self.read_stack_u64(fp + 8)
+            if next_fp is None or ret is None or ret == 0:
+                break
+            frames.append(ret)
+            if next_fp <= fp:
+                break
+            fp = next_fp
+        return frames
+
+    def stack_scan(self, limit: int) -> list[tuple[int, int]]:
+        if self.stack is None:
+            return []
+        base, data = self.stack
+        hits = []
+        for off in range(0, len(data) - 7, 8):
+            value = struct.unpack_from("<Q", data, off)[0]
+            if self.in_text(value):
+                hits.append((base + off, value))
+                if len(hits) >= limit:
+                    break
+        return hits
+
+    def print_report(self, show_log: bool, stack_words: int) -> None:
+        cap = self.cap
+        print("--- d3hack crash capture ---")
+        if cap.build:
+            print(f"build: {cap.build}")
+        uptime = cap.tick / cap.tick_frequency if cap.tick_frequency else 0.0
+        print(f"type=0x{cap.exception_type:x} ({EXCEPTION_TYPES.get(cap.exception_type, 'Unknown')}) core={cap.core} uptime={uptime:.3f}s")
+
+        regs = cap.registers
+        if regs is not None:
+            print("\nRegisters:")
+            for i in range(0, 29, 2):
+                cols = [f"x{j:02d}=0x{regs.x[j]:016x}" for j in range(i, min(i + 2, 29))]
+                print("  " + "  ".join(cols))
+            print(f"  fp=0x{regs.fp:016x}  sp=0x{regs.sp:016x}")
+            print(f"  pstate=0x{regs.pstate:08x} fpcr=0x{regs.fpcr:08x} fpsr=0x{regs.fpsr:08x}")
+            print(f"  afsr0=0x{regs.afsr0:08x} afsr1=0x{regs.afsr1:08x} esr=0x{regs.esr:08x} far=0x{regs.far:016x}")
+
+            print("\nBacktrace:")
+            print(f"  PC  {self.describe(regs.pc)}")
+            print(f"  LR  {self.describe(regs.lr)}")
+            for depth, ret in enumerate(self.backtrace()):
+                print(f"  #{depth:<2} {self.describe(ret)}")
+
+            pointers = [(i, v) for i, v in enumerate(regs.x) if i < 29 and self.module_for(v) is not None]
+            if pointers:
+                print("\nRegisters pointing into modules:")
+                for i, v in pointers:
+                    print(f"  x{i:02d} {self.describe(v)}")
+
+        for kind, address, data in cap.memory:
+            if kind in (MEM_CODE_PC, MEM_CODE_LR, MEM_FAR):
+                target = None
+                if regs is not None:
+                    target = {MEM_CODE_PC: regs.pc, MEM_CODE_LR: regs.lr, MEM_FAR: regs.far}[kind]
+                print(f"\nMemory [{MEM_NAMES[kind]}] 0x{address:016x} ({len(data)} bytes):")
+                hexdump(address, data, target)
+
+        if stack_words > 0:
+            hits = self.stack_scan(stack_words)
+            if hits:
+                print(f"\nStack words pointing into module text (first {len(hits)}):")
+                for slot, value in hits:
+                    print(f"  [0x{slot:016x}] {self.describe(value)}")
+
+        if cap.modules:
+            print("\nModules:")
+            for m in cap.modules:
+                tag = " [main]" if m.flags & MODULE_FLAG_MAIN else " [self]" if m.flags & MODULE_FLAG_SELF else ""
+                print(f"  {m.index:02d}: 0x{m.start:016x}-0x{m.end:016x} {m.name}{tag}")
+
+        if cap.hooks:
+            print(f"\nInstalled hooks/patches ({len(cap.hooks)}):")
+            for row in cap.hooks:
+                kind, name, owner, feature = (row + ["-"] * 4)[:4]
+                print(f"  {kind:<5} {name:<32} {owner:<24} {feature}")
+
+        if show_log and cap.log_tail:
+            text = cap.log_tail
+            # The ring wraps mid-line; drop the partial first line.
+            if len(text.encode("utf-8")) >= LOG_TAIL_BYTES and "\n" in text:
+                text = text.split("\n", 1)[1]
+            print("\nLog tail:")
+            for line in text.rstrip("\n").split("\n"):
+                print(f"  {line}")
+
+
+def hexdump(address: int, data: bytes, mark: int | None) -> None:
+    for off in range(0, len(data), 16):
+        row = data[off : off + 16]
+        line_addr = address + off
+        words = " ".join(row[i : i + 4].hex() for i in range(0, len(row), 4))
+        pointer = "=>" if mark is not None and line_addr <= mark < line_addr + 16 else "  "
+        print(f"  {pointer} 0x{line_addr:016x}: {words}")
+
+
+def load_symbols(args: argparse.Namespace) -> Symbols | None:
+    if args.symbols is not None:
+        return Symbols.from_index(args.symbols)
+    if args.offsets is not None and args.offsets.exists():
+        out = Symbols()
+        out.add(symidx.KIND_MAIN, symidx.read_main_symbols(args.offsets, args.offsets.parent / "symbols"))
+        return out
+    return None
+
+
+def main() -> int:
+    default_offsets = Path(__file__).resolve().parent.parent / "source" / "program" / "offsets.hpp"
+    ap = argparse.ArgumentParser()
+    ap.add_argument("capture", type=Path)
+    ap.add_argument("--symbols", type=Path, default=None, help="symbols.d3sy from the matching build")
+    ap.add_argument("--offsets", type=Path, default=default_offsets, help="fallback for main-module names")
+    ap.add_argument("--no-log", action="store_true", help="omit the log tail")
+    ap.add_argument("--stack-words", type=int, default=32, help="max stack words to list from the text scan (0 = off)")
+    args = ap.parse_args()
+
+    try:
+        cap = parse(args.capture.read_bytes())
+        symbols = load_symbols(args)
+    except (OSError, ValueError) as exc:
+        print(f"{args.capture}: {exc}", file=sys.stderr)
+        return 1
+
+    Analyzer(cap, symbols).print_report(not args.no_log, args.stack_words)
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
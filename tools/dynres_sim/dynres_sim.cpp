@@ -0,0 +1,207 @@
+// Host-side replay harness for the adaptive dynamic-resolution controller.
+//
+// Build:
+//   g++ -std=c++23 -O2 -Wall -Wextra -o dynres_sim tools/dynres_sim/dynres_sim.cpp
+//
+// Usage:
+//   dynres_sim [--trace frame_trace.csv] [--target-ms 33.3] [--gpu-frac 0.7]
+//              [--min 0.7] [--max 1.0] [--frames 1800] [--vsync-ms 0]
+//              [--feed work|present] [--verbose]
+//
+// The trace is the CSV written by Tools -> "Dump frame trace"
+// (sd:/config/d3hack-nx/frame_trace.csv: frame_us,overlay_us,res_scale,work_us).
+// Without --trace a synthetic load (calm / spike / heavy / calm) is generated.
+//
+// Each recorded frame's cost is its work_us (submit to GPU fence) when present,
+// else its present interval, rescaled to the simulated scale with a simple GPU
+// model:
+//   cost_ms = rec_ms * ((1 - gpu_frac) + gpu_frac * (scale / rec_scale)^2)
+// With --vsync-ms the presented interval is the cost rounded up to whole vsync
+// periods, as on device. The controller is fed the p90 of every
+// kWindowFrames-frame window of either the cost (--feed work, what
+// d3/dynamic_res.cpp uses) or the presented interval (--feed present, the old
+// behaviour, which never sees headroom below a vsync multiple).
+
+#include "../../source/program/d3/dynamic_res_controller.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    constexpr size_t kWindowFrames = 30;  // keep in sync with d3::dynamic_res::kWindowFrames
+
+    struct Frame {
+        float ms;  // cost at the recorded scale
+        float scale;
+    };
+
+    auto LoadTrace(const char *path, std::vector<Frame> &out) -> bool {
+        std::ifstream in(path);
+        if (!in) {
+            std::fprintf(stderr, "cannot open %s\n", path);
+            return false;
+        }
+        std::string line;
+        while (std::getline(in, line)) {
+            unsigned frame_us = 0, overlay_us = 0, work_us = 0;
+            float    scale    = 0.0f;
+            if (std::sscanf(line.c_str(), "%u,%u,%f,%u", &frame_us, &overlay_us, &scale, &work_us) < 1 || frame_us == 0) {
+                continue;  // header or junk
+            }
+            const unsigned cost_us = work_us != 0 ? work_us : frame_us;
+            out.push_back(Frame {static_cast<float>(cost_us) * 0.001f, scale > 0.0f ? scale : 1.0f});
+        }
+        return !out.empty();
+    }
+
+    void SynthesizeTrace(size_t frames, std::vector<Frame> &out) {
+        unsigned rng = 12345u;
+        auto     noise = [&rng]() -> float {
+            rng = rng * 1664525u + 1013904223u;
+            return static_cast<float>((rng >> 8) & 0xFFFF) / 65535.0f - 0.5f;
+        };
+        for (size_t i = 0; i < frames; ++i) {
+            const float t    = static_cast<float>(i) / static_cast<float>(frames);
+            float       base = 30.0f;
+            if (t > 0.25f && t < 0.30f) {
+                base = 48.0f;  // short spike (big fight)
+            } else if (t > 0.45f && t < 0.75f) {
+                base = 40.0f;  // sustained heavy scene
+            }
+            out.push_back(Frame {base + noise() * 4.0f, 1.0f});
+        }
+    }
+
+    auto Percentile(std::vector<float> v, int pct) -> float {
+        if (v.empty()) {
+            return 0.0f;
+        }
+        const size_t k = std::min(v.size() - 1, (v.size() * static_cast<size_t>(pct)) / 100);
+        std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+        return v[k];
+    }
+
+    auto ArgFloat(int argc, char **argv, int &i, float &out) -> bool {
+        if (i + 1 >= argc) {
+            return false;
+        }
+        out = std::strtof(argv[++i], nullptr);
+        return true;
+    }
+
+    // Presented interval: the swap waits for the next vsync after the work is done.
+    auto Quantize(float ms, float vsync_ms) -> float {
+        if (vsync_ms <= 0.0f) {
+            return ms;
+        }
+        return std::max(1.0f, std::ceil(ms / vsync_ms)) * vsync_ms;
+    }
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    const char *trace_path = nullptr;
+    float       gpu_frac   = 0.7f;
+    float       frames_arg = 1800.0f;
+    float       vsync_ms   = 0.0f;
+    bool        feed_work  = true;
+    bool        verbose    = false;
+
+    d3::dynamic_res::ControllerParams params {};
+    for (int i = 1; i < argc; ++i) {
+        bool ok = true;
+        if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--target-ms") == 0) {
+            ok = ArgFloat(argc, argv, i, params.target_ms);
+        } else if (std::strcmp(argv[i], "--gpu-frac") == 0) {
+            ok = ArgFloat(argc, argv, i, gpu_frac);
+        } else if (std::strcmp(argv[i], "--min") == 0) {
+            ok = ArgFloat(argc, argv, i, params.min_scale);
+        } else if (std::strcmp(argv[i], "--max") == 0) {
+            ok = ArgFloat(argc, argv, i, params.max_scale);
+        } else if (std::strcmp(argv[i], "--frames") == 0) {
+            ok = ArgFloat(argc, argv, i, frames_arg);
+        } else if (std::strcmp(argv[i], "--vsync-ms") == 0) {
+            ok = ArgFloat(argc, argv, i, vsync_ms);
+        } else if (std::strcmp(argv[i], "--feed") == 0 && i + 1 < argc) {
+            const char *feed = argv[++i];
+            feed_work        = std::strcmp(feed, "work") == 0;
+            ok               = feed_work || std::strcmp(feed, "present") == 0;
+        } else if (std::strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "usage: %s [--trace csv] [--target-ms f] [--gpu-frac f] [--min f] [--max f] [--frames n] [--vsync-ms f] [--feed work|present] [--verbose]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<Frame> trace;
+    if (trace_path != nullptr) {
+        if (!LoadTrace(trace_path, trace)) {
+            return 1;
+        }
+    } else {
+        SynthesizeTrace(static_cast<size_t>(std::max(frames_arg, 1.0f)), trace);
+    }
+
+    d3::dynamic_res::Controller controller;
+    controller.Reset(params.max_scale);
+
+    std::vector<float> window;
+    std::vector<float> all_in;
+    std::vector<float> all_out;
+    std::vector<float> all_presented;
+    window.reserve(kWindowFrames);
+    float  scale_sum = 0.0f;
+    size_t changes   = 0;
+    size_t over      = 0;
+
+    std::printf("# window,in_p90_ms,fed_p90_ms,scale\n");
+    for (size_t i = 0; i < trace.size(); ++i) {
+        const Frame &f     = trace[i];
+        const float  ratio = controller.scale() / f.scale;
+        const float  ms    = f.ms * ((1.0f - gpu_frac) + gpu_frac * ratio * ratio);
+        const float  shown = Quantize(ms, vsync_ms);
+        window.push_back(feed_work ? ms : shown);
+        all_in.push_back(f.ms);
+        all_out.push_back(ms);
+        all_presented.push_back(shown);
+        scale_sum += controller.scale();
+        if (ms > params.target_ms) {
+            ++over;
+        }
+
+        if (window.size() == kWindowFrames) {
+            const float p90  = Percentile(window, 90);
+            const float prev = controller.scale();
+            const float next = controller.Update(p90, params);
+            if (next != prev) {
+                ++changes;
+            }
+            if (verbose || next != prev) {
+                std::vector<float> in_window(all_in.end() - static_cast<std::ptrdiff_t>(kWindowFrames), all_in.end());
+                std::printf("%zu,%.2f,%.2f,%.3f\n", i / kWindowFrames, Percentile(in_window, 90), p90, next);
+            }
+            window.clear();
+        }
+    }
+
+    const size_t n = trace.size();
+    std::printf("\nframes=%zu target=%.1fms gpu_frac=%.2f scale=[%.2f,%.2f] vsync=%.2fms feed=%s\n", n, params.target_ms, gpu_frac, params.min_scale, params.max_scale, vsync_ms, feed_work ? "work" : "present");
+    std::printf("input : p50=%.2f p90=%.2f p99=%.2f\n", Percentile(all_in, 50), Percentile(all_in, 90), Percentile(all_in, 99));
+    std::printf("output: p50=%.2f p90=%.2f p99=%.2f over_target=%.1f%%\n", Percentile(all_out, 50), Percentile(all_out, 90), Percentile(all_out, 99), 100.0 * static_cast<double>(over) / static_cast<double>(n));
+    std::printf("shown : p50=%.2f p90=%.2f p99=%.2f\n", Percentile(all_presented, 50), Percentile(all_presented, 90), Percentile(all_presented, 99));
+    std::printf("scale : avg=%.3f final=%.3f changes=%zu\n", scale_sum / static_cast<float>(n), controller.scale(), changes);
+    return 0;
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""
+Generate the attribute name table consumed by d3/attrib_meta.hpp.
+
+Usage:
+  python3 tools/gen_attribute_names.py \
+      [--src source/program/d3/types/attributes.hpp] \
+      [--dst source/program/d3/types/attribute_names.inc] \
+      [--check]
+
+Notes:
+- Parses the `enum Attributes` block and emits one D3_ATTRIB(id, NAME) line per
+  attribute in id order. ATTRIBUTE_NONE (-1) is skipped.
+- Fails if ids are not contiguous from 0, since the C++ side indexes the table
+  directly by attribute id.
+- --check exits non-zero when the generated output differs from --dst
+  (useful before committing enum edits).
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+ENUM_START = re.compile(r"^\s*enum\s+Attributes\b")
+ENTRY = re.compile(r"^\s*([A-Z0-9_]+)\s*=\s*(-?0x[0-9A-Fa-f]+|-?\d+)\s*,")
+
+
+def parse_enum(text: str) -> list[tuple[int, str]]:
+    entries: list[tuple[int, str]] = []
+    inside = False
+    for line in text.splitlines():
+        if not inside:
+            inside = bool(ENUM_START.match(line))
+            continue
+        if line.strip().startswith("};"):
+            break
+        m = ENTRY.match(line)
+        if m:
+            entries.append((int(m.group(2), 0), m.group(1)))
+    return entries
+
+
+def render(entries: list[tuple[int, str]]) -> str:
+    lines = [
+        "// Generated by tools/gen_attribute_names.py from d3/types/attributes.hpp. Do not edit.",
+        "// D3_ATTRIB(id, NAME)",
+        "",
+    ]
+    for attr_id, name in entries:
+        lines.append(f"D3_ATTRIB(0x{attr_id:X}, {name})")
+    return "\n".join(lines) + "\n"
+
+
+def main() -> int:
+    repo = Path(__file__).resolve().parent.parent
+    ap = argparse.ArgumentParser(description="Generate attribute_names.inc")
+    ap.add_argument("--src", default=str(repo / "source/program/d3/types/attributes.hpp"))
+    ap.add_argument("--dst", default=str(repo / "source/program/d3/types/attribute_names.inc"))
+    ap.add_argument("--check", action="store_true", help="Verify dst is up to date")
+    args = ap.parse_args()
+
+    entries = [(i, n) for i, n in parse_enum(Path(args.src).read_text()) if i >= 0]
+    entries.sort()
+    for expected, (attr_id, name) in enumerate(entries):
+        if attr_id != expected:
+            print(f"non-contiguous attribute id at {name}: 0x{attr_id:X} (expected 0x{expected:X})", file=sys.stderr)
+            return 1
+
+    out = render(entries)
+    dst = Path(args.dst)
+    if args.check:
+        if not dst.exists() or dst.read_text() != out:
+            print(f"{dst} is out of date; rerun {Path(__file__).name}", file=sys.stderr)
+            return 1
+        return 0
+
+    dst.write_text(out)
+    print(f"wrote {len(entries)} attributes -> {dst}")
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
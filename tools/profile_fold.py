@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""Symbolize the sampling profiler's folded stacks for flame graphs.
+
+Usage:
+  profile_fold.py profile.folded [-o out.folded] [--symbols symbols.d3sy]
+                  [--offsets source/program/offsets.hpp] [--top N] [--addresses]
+
+The device writes sd:/config/d3hack-nx/profile.folded (Tools > Dump profile
+with [debug] SamplingProfiler on). Each line is a root-first stack of
+"module+0xoffset" frames followed by a sample count; "# module main|self NAME"
+header lines say which module names the symbol index covers.
+
+Frames are replaced by function names from symbols.d3sy (or the offsets.hpp
+DEFAULT table for game functions). Adjacent frames in the same function are
+merged, which also folds away the stale LR the sampler records for non-leaf
+functions. The output is plain folded-stack text:
+
+  python3 tools/profile_fold.py profile.folded -o game.folded
+  flamegraph.pl game.folded > game.svg
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+import sys
+from collections import Counter
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent))
+import build_symbol_index as symidx  # noqa: E402
+from crash_analyze import Symbols, load_symbols  # noqa: E402
+
+FRAME = re.compile(r"^(?P<module>.+)\+0x(?P<offset>[0-9a-fA-F]+)$")
+MODULE_LINE = re.compile(r"^#\s*module\s+(main|self)\s+(\S+)")
+
+
+class Resolver:
+    def __init__(self, symbols: Symbols | None, keep_addresses: bool) -> None:
+        self.symbols = symbols
+        self.keep_addresses = keep_addresses
+        self.kinds: dict[str, int] = {}
+        self.cache: dict[str, str] = {}
+
+    def resolve(self, frame: str) -> str:
+        cached = self.cache.get(frame)
+        if cached is not None:
+            return cached
+        out = frame
+        m = FRAME.match(frame)
+        kind = self.kinds.get(m.group("module")) if m else None
+        if m and kind is not None and self.symbols is not None:
+            sym = self.symbols.lookup(kind, int(m.group("offset"), 16))
+            if sym:
+                out = sym if self.keep_addresses else sym.rsplit("+0x", 1)[0]
+        # flamegraph.pl splits on ';' and the last space.
+        out = out.replace(";", ":").replace(" ", "_")
+        self.cache[frame] = out
+        return out
+
+
+def fold(lines: list[str], resolver: Resolver) -> tuple[Counter[str], Counter[str], int]:
+    stacks: Counter[str] = Counter()
+    leaves: Counter[str] = Counter()
+    total = 0
+    for line in lines:
+        line = line.strip()
+        if not line:
+            continue
+        if line.startswith("#"):
+            m = MODULE_LINE.match(line)
+            if m:
+                resolver.kinds[m.group(2)] = symidx.KIND_MAIN if m.group(1) == "main" else symidx.KIND_SELF
+            continue
+        stack, _, count_text = line.rpartition(" ")
+        try:
+            count = int(count_text)
+        except ValueError:
+            continue
+        frames: list[str] = []
+        for raw in stack.split(";"):
+            name = resolver.resolve(raw)
+            if not frames or frames[-1] != name:
+                frames.append(name)
+        stacks[";".join(frames)] += count
+        leaves[frames[-1]] += count
+        total += count
+    return stacks, leaves, total
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser()
+    ap.add_argument("profile", type=Path)
+    ap.add_argument("-o", "--out", type=Path, default=None, help="write folded stacks here (default: stdout)")
+    ap.add_argument("--symbols", type=Path, default=None, help="symbols.d3sy from the matching build")
+    ap.add_argument("--offsets", type=Path, default=Path(__file__).resolve().parent.parent / "source" / "program" / "offsets.hpp")
+    ap.add_argument("--top", type=int, default=0, help="print the N hottest leaf functions to stderr")
+    ap.add_argument("--addresses", action="store_true", help="keep +0xdelta on frames (no merging within a function)")
+    args = ap.parse_args()
+
+    try:
+        lines = args.profile.read_text(encoding="utf-8").splitlines()
+        symbols = load_symbols(args)
+    except (OSError, ValueError) as exc:
+        print(f"{args.profile}: {exc}", file=sys.stderr)
+        return 1
+
+    stacks, leaves, total = fold(lines, Resolver(symbols, args.addresses))
+    text = "".join(f"{stack} {count}\n" for stack, count in sorted(stacks.items()))
+    if args.out is not None:
+        args.out.write_text(text, encoding="utf-8")
+        print(f"[profile] {args.out}: {len(stacks)} stacks, {total} samples", file=sys.stderr)
+    else:
+        sys.stdout.write(text)
+
+    if args.top > 0 and total:
+        print(f"{'samples':>8} {'share':>6}  leaf function", file=sys.stderr)
+        for name, count in leaves.most_common(args.top):
+            print(f"{count:>8} {100.0 * count / total:5.1f}%  {name}", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""Convert a hook trace written by source/program/hook_trace.cpp to Chrome JSON.
+
+Usage:
+  trace_to_chrome.py hook_trace.bin [-o trace.json] [--summary]
+
+The device writes sd:/config/d3hack-nx/hook_trace.bin (Tools > Dump hook trace
+with [debug] TraceHooks set). Every traced Orig() call left an enter and an exit
+record in its thread's ring; this turns them into trace-event "B"/"E" pairs
+that chrome://tracing, Perfetto or speedscope can open. The first two call
+arguments are kept as hex words in each slice's args.
+
+Rings wrap, so the oldest calls of a busy thread are gone: exits whose enter
+was overwritten are dropped, and calls still open at dump time are closed at
+the thread's last timestamp.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import struct
+import sys
+from collections import defaultdict
+from pathlib import Path
+
+MAGIC = b"D3TR"
+VERSION = 1
+HEADER = struct.Struct("<4sIQII")
+SITE = struct.Struct("<HH28s60s")
+RING = struct.Struct("<Q32sII")
+RECORD = struct.Struct("<QHBBIQQ")
+
+PHASE_ENTER = 0
+PHASE_EXIT = 1
+
+
+def cstr(raw: bytes) -> str:
+    return raw.split(b"\0", 1)[0].decode("utf-8", "replace")
+
+
+def parse(data: bytes) -> tuple[int, dict[int, tuple[str, str]], list[dict]]:
+    if len(data) < HEADER.size:
+        raise ValueError("file too short")
+    magic, version, frequency, site_count, ring_count = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError(f"bad magic {magic!r}")
+    if version != VERSION:
+        raise ValueError(f"unsupported version {version}")
+    if frequency == 0:
+        raise ValueError("tick frequency is 0")
+
+    offset = HEADER.size
+    sites: dict[int, tuple[str, str]] = {}
+    for _ in range(site_count):
+        site_id, _reserved, group, name = SITE.unpack_from(data, offset)
+        sites[site_id] = (cstr(group), cstr(name))
+        offset += SITE.size
+
+    rings: list[dict] = []
+    for _ in range(ring_count):
+        thread_id, thread_name, count, lost = RING.unpack_from(data, offset)
+        offset += RING.size
+        end = offset + count * RECORD.size
+        if end > len(data):
+            raise ValueError(f"ring for thread {thread_id} is truncated")
+        records = [RECORD.unpack_from(data, offset + i * RECORD.size) for i in range(count)]
+        offset = end
+        rings.append({"tid": thread_id, "name": cstr(thread_name), "lost": lost, "records": records})
+    return frequency, sites, rings
+
+
+def convert(frequency: int, sites: dict[int, tuple[str, str]], rings: list[dict]) -> tuple[list[dict], dict]:
+    base = min((ring["records"][0][0] for ring in rings if ring["records"]), default=0)
+
+    def micros(tick: int) -> float:
+        return (tick - base) * 1_000_000 / frequency
+
+    events: list[dict] = []
+    stats: dict[str, list[float]] = defaultdict(list)
+    for ring in rings:
+        tid = ring["tid"]
+        events.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": tid, "args": {"name": ring["name"] or f"thread {tid}"}})
+        stack: list[tuple[int, int]] = []
+        last = 0
+        for tick, site_id, phase, _r0, _r1, arg0, arg1 in ring["records"]:
+            group, name = sites.get(site_id, ("?", f"site{site_id}"))
+            last = tick
+            if phase == PHASE_ENTER:
+                stack.append((site_id, tick))
+                events.append({
+                    "name": name,
+                    "cat": group,
+                    "ph": "B",
+                    "ts": micros(tick),
+                    "pid": 1,
+                    "tid": tid,
+                    "args": {"arg0": f"0x{arg0:x}", "arg1": f"0x{arg1:x}"},
+                })
+            elif stack and stack[-1][0] == site_id:
+                _, start = stack.pop()
+                stats[name].append((tick - start) * 1_000_000 / frequency)
+                events.append({"name": name, "cat": group, "ph": "E", "ts": micros(tick), "pid": 1, "tid": tid})
+            # else: the matching enter was overwritten by the ring wrap.
+        while stack:
+            site_id, _ = stack.pop()
+            group, name = sites.get(site_id, ("?", f"site{site_id}"))
+            events.append({"name": name, "cat": group, "ph": "E", "ts": micros(last), "pid": 1, "tid": tid, "args": {"open": True}})
+    return events, stats
+
+
+def main() -> int:
+    ap = argparse.ArgumentParser()
+    ap.add_argument("trace", type=Path)
+    ap.add_argument("-o", "--out", type=Path, default=None, help="write JSON here (default: <trace>.json)")
+    ap.add_argument("--summary", action="store_true", help="print per-site call counts and durations to stderr")
+    args = ap.parse_args()
+
+    try:
+        frequency, sites, rings = parse(args.trace.read_bytes())
+    except (OSError, ValueError, struct.error) as exc:
+        print(f"{args.trace}: {exc}", file=sys.stderr)
+        return 1
+
+    events, stats = convert(frequency, sites, rings)
+    out = args.out if args.out is not None else args.trace.with_suffix(".json")
+    out.write_text(json.dumps({"traceEvents": events, "displayTimeUnit": "ms"}), encoding="utf-8")
+    lost = sum(ring["lost"] for ring in rings)
+    print(f"[trace] {out}: {len(sites)} sites, {len(rings)} threads, {len(events)} events, {lost} lost to ring wrap", file=sys.stderr)
+
+    if args.summary:
+        print(f"{'calls':>8} {'total ms':>10} {'avg us':>9} {'max us':>9}  site", file=sys.stderr)
+        for name, durations in sorted(stats.items(), key=lambda item: -sum(item[1])):
+            total = sum(durations)
+            print(f"{len(durations):>8} {total / 1000:>10.3f} {total / len(durations):>9.1f} {max(durations):>9.1f}  {name}", file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())